@@ -42,6 +42,33 @@ namespace globalConstants {
 /** A global, compile-time constant which stores the lowest floating point value which can be representable by the machine. */
 constexpr real_t ZERO = std::numeric_limits< real_t >::epsilon();
 
+/** A global, compile-time constant which stores the size of a cache line in bytes. */
+constexpr small_t CACHE_LINE_SIZE = 64;
+
+/** A global, compile-time constant which stores the width of the widest SIMD register targeted by the compiler in bytes. */
+#if defined( __AVX512F__ )
+constexpr small_t SIMD_ALIGNMENT = 64;
+#elif defined( __AVX__ )
+constexpr small_t SIMD_ALIGNMENT = 32;
+#else
+constexpr small_t SIMD_ALIGNMENT = 16;
+#endif
+
+/** A global, compile-time constant which stores the size in bytes of a block of data which fits comfortably into the L1 data cache. */
+constexpr large_t L1_BLOCK_SIZE = 16ul * 1024ul;
+
+/** A global, compile-time constant which stores the size in bytes of a block of data which fits comfortably into a core's private cache. It
+*   is used to size the chunks in which streaming kernels are scheduled.
+*/
+constexpr large_t CACHE_BLOCK_SIZE = 256ul * 1024ul;
+
+/** A global, compile-time constant which stores the number of time steps between two reports of the memory bandwidth of the kernels over
+*   the state fields. */
+constexpr large_t BANDWIDTH_REPORT_INTERVAL = 100;
+
+/** A global, compile-time constant which stores the size of a (transparent) huge page in bytes. */
+constexpr large_t HUGE_PAGE_SIZE = 2ul * 1024ul * 1024ul;
+
 }   // namespace globalConstants
 
 
@@ -27,5 +27,18 @@ namespace simpleNewton {
 
 template class Asserts_CPPHackClass<int>;
 
+namespace asserts {
+namespace internal {
+
+void assert_failed( const char * const msg, const char * const file, int line, const char * const func ) {
+
+   logger::internal::report_error( msg, file, line, func );
+   ExitProgram();
+}
+
+}   // namespace internal
+}   // namespace asserts
+
+
 }   // namespace simpleNewton
 #endif
@@ -60,6 +60,10 @@ template<> struct TYPE_ERROR<false> {};
 template< class T1, class T2 > struct SAME_TYPE_IN_ASSERT                      { enum : bool { value = false }; };
 template< class SAME_TYPE > struct SAME_TYPE_IN_ASSERT< SAME_TYPE, SAME_TYPE > { enum : bool { value = true  }; };
 
+/* Reports a failed assertion and terminates the process. It is kept out of line, so that the assertion helpers below remain cheap enough
+*  to be inlined. */
+void assert_failed( const char * const msg, const char * const file, int line, const char * const func );
+
 template< class U_INT > struct INT_IN_ASSERT          { enum : bool { value = false }; };
 template<> struct INT_IN_ASSERT< short >              { enum : bool { value = true }; };
 template<> struct INT_IN_ASSERT< int >                { enum : bool { value = true }; };
@@ -72,23 +76,21 @@ template<> struct INT_IN_ASSERT< unsigned long long > { enum : bool { value = tr
 
 
 
-inline void assert( bool expr, const char * const file, int line, const std::string & func ) {
+inline void assert( bool expr, const char * const file, int line, const char * const func ) {
    if( ! expr ) {
       
-      logger::internal::report_error( "An assertion has failed. The process will now be terminated.", file, line, func );
-      ExitProgram();
+      assert_failed( "An assertion has failed. The process will now be terminated.", file, line, func );
    }
 }
 
 
 
 template< class T1, class T2 > 
-inline void assert_equal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_equal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<T2>(VALUE) == static_cast<T1>(REFERENCE) ) ) {
          
-         logger::internal::report_error( "Equality assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Equality assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -96,12 +98,11 @@ inline void assert_equal( const T1 & VALUE, const T2 & REFERENCE, const char * c
 
 
 template< class T1, class T2 > 
-inline void assert_fp_equal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_fp_equal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( std::fabs( static_cast<T2>(VALUE) - static_cast<T1>(REFERENCE) ) <= globalConstants::ZERO ) ) {
          
-         logger::internal::report_error( "Floating point equality assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Floating point equality assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -109,12 +110,11 @@ inline void assert_fp_equal( const T1 & VALUE, const T2 & REFERENCE, const char
 
 
 template< class T1, class T2 >
-inline void assert_inequal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_inequal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<T2>(VALUE) != static_cast<T1>(REFERENCE) ) ) {
          
-         logger::internal::report_error( "Inequality assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Inequality assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -122,12 +122,11 @@ inline void assert_inequal( const T1 & VALUE, const T2 & REFERENCE, const char *
 
 
 template< class T1, class T2 >
-inline void assert_fp_inequal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_fp_inequal( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( std::fabs( static_cast<T2>(VALUE) - static_cast<T1>(REFERENCE) ) > globalConstants::ZERO ) ) {
          
-         logger::internal::report_error( "Floating point inequality assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Floating point inequality assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -135,12 +134,11 @@ inline void assert_fp_inequal( const T1 & VALUE, const T2 & REFERENCE, const cha
 
 
 template< class T1, class T2 >
-inline void assert_less_than( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_less_than( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<T2>(VALUE) < static_cast<T1>(REFERENCE) ) ) {
          
-         logger::internal::report_error( "Less than assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Less than assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -148,12 +146,11 @@ inline void assert_less_than( const T1 & VALUE, const T2 & REFERENCE, const char
 
 
 template< class T1, class T2 >
-inline void assert_leq( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_leq( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<T2>(VALUE) <= static_cast<T1>(REFERENCE) ) ) {
          
-         logger::internal::report_error( "Less than or equal to assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Less than or equal to assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -161,12 +158,11 @@ inline void assert_leq( const T1 & VALUE, const T2 & REFERENCE, const char * con
 
 
 template< class T1, class T2 >
-inline void assert_greater_than( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_greater_than( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<T2>(VALUE) > static_cast<T1>(REFERENCE) ) ) {
         
-         logger::internal::report_error( "Greater than assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Greater than assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -174,12 +170,11 @@ inline void assert_greater_than( const T1 & VALUE, const T2 & REFERENCE, const c
 
 
 template< class T1, class T2 >
-inline void assert_greq( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const std::string & func ) {
+inline void assert_greq( const T1 & VALUE, const T2 & REFERENCE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< SAME_TYPE_IN_ASSERT< T1, T2 >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<T2>(VALUE) >= static_cast<T1>(REFERENCE) ) ) {
          
-         logger::internal::report_error( "Greater than or equal to assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Greater than or equal to assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -187,51 +182,47 @@ inline void assert_greq( const T1 & VALUE, const T2 & REFERENCE, const char * co
 
 
 template< class TYPE >
-inline void assert_zero( const TYPE & VALUE, const char * const file, int line, const std::string & func ) {
+inline void assert_zero( const TYPE & VALUE, const char * const file, int line, const char * const func ) {
    if( !static_cast< bool >( std::fabs(VALUE) <= globalConstants::ZERO ) ) {
       
-      logger::internal::report_error( "Equal to zero assertion failed. The process will now be terminated.", file, line, func );
-      ExitProgram();
+      assert_failed( "Equal to zero assertion failed. The process will now be terminated.", file, line, func );
    }
 }
 
 
 
 template< class TYPE >
-inline void assert_not_zero( const TYPE & VALUE, const char * const file, int line, const std::string & func ) {
+inline void assert_not_zero( const TYPE & VALUE, const char * const file, int line, const char * const func ) {
    if( !static_cast< bool >( std::fabs(VALUE) > globalConstants::ZERO ) ) {
       
-      logger::internal::report_error( "Not equal to zero assertion failed. The process will now be terminated.", file, line, func );
-      ExitProgram();
+      assert_failed( "Not equal to zero assertion failed. The process will now be terminated.", file, line, func );
    }
 }
 
 
 
 template< class TYPE >
-inline void assert_positive( const TYPE & VALUE, const char * const file, int line, const std::string & func ) {
+inline void assert_positive( const TYPE & VALUE, const char * const file, int line, const char * const func ) {
    if( !static_cast< bool >( VALUE > globalConstants::ZERO ) ) {
       
-      logger::internal::report_error( "Positivity assertion failed. The process will now be terminated.", file, line, func );
-      ExitProgram();
+      assert_failed( "Positivity assertion failed. The process will now be terminated.", file, line, func );
    }
 }
 
 
 
 template< class TYPE >
-inline void assert_negative( const TYPE & VALUE, const char * const file, int line, const std::string & func ) {
+inline void assert_negative( const TYPE & VALUE, const char * const file, int line, const char * const func ) {
    if( !static_cast< bool >( VALUE < globalConstants::ZERO ) ) {
      
-      logger::internal::report_error( "Negativity assertion failed. The process will now be terminated.", file, line, func );
-      ExitProgram();
+      assert_failed( "Negativity assertion failed. The process will now be terminated.", file, line, func );
    }
 }
 
 
 
 template< bool constexpr_expr >
-inline void assert_msg( const char* const MSG, const char * const file, int line, const std::string & func ) {
+inline void assert_msg( const char* const MSG, const char * const file, int line, const char * const func ) {
    if( !static_cast< bool >( constexpr_expr ) ) {
      
       logger::internal::report_error( MSG, file, line, func );
@@ -242,12 +233,11 @@ inline void assert_msg( const char* const MSG, const char * const file, int line
 
 
 template< typename U_INT >
-inline void assert_size_same( const U_INT & SIZE, const U_INT & REF, const char * const file, int line, const std::string & func ) {
+inline void assert_size_same( const U_INT & SIZE, const U_INT & REF, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< INT_IN_ASSERT< U_INT >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<unsigned long long>(SIZE) == static_cast<unsigned long long>(REF) ) ) {
         
-         logger::internal::report_error( "Same size assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Same size assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -255,12 +245,11 @@ inline void assert_size_same( const U_INT & SIZE, const U_INT & REF, const char
 
 
 template< typename U_INT >
-inline void assert_size_less_than( const U_INT & SIZE, const U_INT & REF, const char * const file, int line, const std::string & func ) {
+inline void assert_size_less_than( const U_INT & SIZE, const U_INT & REF, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< INT_IN_ASSERT< U_INT >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<unsigned long long>(SIZE) <= static_cast<unsigned long long>(REF) ) ) {
        
-         logger::internal::report_error( "Size less than assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Size less than assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -268,12 +257,11 @@ inline void assert_size_less_than( const U_INT & SIZE, const U_INT & REF, const
 
 
 template< typename U_INT >
-inline void assert_size_strictly_less_than( const U_INT & SIZE, const U_INT & REF, const char * const file, int line, const std::string & func ) {
+inline void assert_size_strictly_less_than( const U_INT & SIZE, const U_INT & REF, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< INT_IN_ASSERT< U_INT >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<unsigned long long>(SIZE) < static_cast<unsigned long long>(REF) ) ) {
        
-         logger::internal::report_error( "Size strictly less than assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Size strictly less than assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -281,12 +269,11 @@ inline void assert_size_strictly_less_than( const U_INT & SIZE, const U_INT & RE
 
 
 template< typename U_INT >
-inline void assert_index_within_size( const U_INT & IND, const U_INT & SIZE, const char * const file, int line, const std::string & func ) {
+inline void assert_index_within_size( const U_INT & IND, const U_INT & SIZE, const char * const file, int line, const char * const func ) {
    if( ! TYPE_ERROR< INT_IN_ASSERT< U_INT >::value >::ASSERT_FAILED ) { // cast guard
       if( !static_cast< bool >( static_cast<unsigned long long>(IND) < static_cast<unsigned long long>(SIZE) ) ) {
       
-         logger::internal::report_error( "Index within size assertion failed. The process will now be terminated.", file, line, func );
-         ExitProgram();
+         assert_failed( "Index within size assertion failed. The process will now be terminated.", file, line, func );
       }
    }
 }
@@ -460,7 +447,7 @@ do { \
 *     \param SIZE An integer-valued container size.
 */
 #define SN_REQUIRE_SIZE_SAME( SIZE, ... ) \
-do { asserts::internal::assert_size_same( static_cast< const unsigned long >(SIZE), static_cast< const unsigned long >(__VA_ARGS__), \
+do { asserts::internal::assert_size_same( static_cast< unsigned long >(SIZE), static_cast< unsigned long >(__VA_ARGS__), \
                                       __FILE__, __LINE__, __func__ ); } while(false)
 
 
@@ -471,7 +458,7 @@ do { asserts::internal::assert_size_same( static_cast< const unsigned long >(SIZ
 *     \param SIZE An integer-valued container size.
 */
 #define SN_REQUIRE_SIZE_LESS_THAN( SIZE, ... ) \
-do { asserts::internal::assert_size_less_than( static_cast< const unsigned long >(SIZE), static_cast< const unsigned long >(__VA_ARGS__), \
+do { asserts::internal::assert_size_less_than( static_cast< unsigned long >(SIZE), static_cast< unsigned long >(__VA_ARGS__), \
                                            __FILE__, __LINE__, __func__ ); } while(false)
 
 
@@ -483,8 +470,8 @@ do { asserts::internal::assert_size_less_than( static_cast< const unsigned long
 *     \param SIZE An integer-valued container size.
 */
 #define SN_REQUIRE_SIZE_STRICTLY_LESS_THAN( SIZE, ... ) \
-do { asserts::internal::assert_size_strictly_less_than( static_cast< const unsigned long >(SIZE), \
-                                                        static_cast< const unsigned long >(__VA_ARGS__), \
+do { asserts::internal::assert_size_strictly_less_than( static_cast< unsigned long >(SIZE), \
+                                                        static_cast< unsigned long >(__VA_ARGS__), \
                                                         __FILE__, __LINE__, __func__ ); } while(false)
 
 
@@ -496,7 +483,7 @@ do { asserts::internal::assert_size_strictly_less_than( static_cast< const unsig
 *     \param IND  An integer-valued container size.
 */
 #define SN_REQUIRE_INDEX_WITHIN_SIZE( IND, ... ) \
-do { asserts::internal::assert_index_within_size( static_cast< const unsigned long >(IND), static_cast< const unsigned long >(__VA_ARGS__),\
+do { asserts::internal::assert_index_within_size( static_cast< unsigned long >(IND), static_cast< unsigned long >(__VA_ARGS__),\
                                               __FILE__, __LINE__, __func__ ); } while(false)
 
 
@@ -691,7 +678,7 @@ do { \
 *     \param SIZE An integer-valued container size.
 */
 #define SN_ASSERT_SIZE_SAME( SIZE, ... ) \
-do { asserts::internal::assert_size_same( static_cast< const unsigned long >(SIZE), static_cast< const unsigned long >(__VA_ARGS__), \
+do { asserts::internal::assert_size_same( static_cast< unsigned long >(SIZE), static_cast< unsigned long >(__VA_ARGS__), \
                                       __FILE__, __LINE__, __func__ ); } while(false)
 
 
@@ -702,7 +689,7 @@ do { asserts::internal::assert_size_same( static_cast< const unsigned long >(SIZ
 *     \param SIZE An integer-valued container size.
 */
 #define SN_ASSERT_SIZE_LESS_THAN( SIZE, ... ) \
-do { asserts::internal::assert_size_less_than( static_cast< const unsigned long >(SIZE), static_cast< const unsigned long >(__VA_ARGS__), \
+do { asserts::internal::assert_size_less_than( static_cast< unsigned long >(SIZE), static_cast< unsigned long >(__VA_ARGS__), \
                                            __FILE__, __LINE__, __func__ ); } while(false)
 
 
@@ -713,8 +700,8 @@ do { asserts::internal::assert_size_less_than( static_cast< const unsigned long
 *     \param SIZE An integer-valued container size.
 */
 #define SN_ASSERT_SIZE_STRICTLY_LESS_THAN( SIZE, ... ) \
-do { asserts::internal::assert_size_strictly_less_than( static_cast< const unsigned long >(SIZE), \
-                                                        static_cast< const unsigned long >(__VA_ARGS__), \
+do { asserts::internal::assert_size_strictly_less_than( static_cast< unsigned long >(SIZE), \
+                                                        static_cast< unsigned long >(__VA_ARGS__), \
                                                         __FILE__, __LINE__, __func__ ); } while(false)
 
 
@@ -727,7 +714,7 @@ do { asserts::internal::assert_size_strictly_less_than( static_cast< const unsig
 *     \param IND  An integer-valued container size.
 */
 #define SN_ASSERT_INDEX_WITHIN_SIZE( IND, ... ) \
-do { asserts::internal::assert_index_within_size( static_cast< const unsigned long >(IND), static_cast< const unsigned long >(__VA_ARGS__),\
+do { asserts::internal::assert_index_within_size( static_cast< unsigned long >(IND), static_cast< unsigned long >(__VA_ARGS__),\
                                               __FILE__, __LINE__, __func__ ); } while(false)
 
 #endif
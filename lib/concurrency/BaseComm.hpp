@@ -5,6 +5,9 @@
    #include <mutex>
 #endif
 
+#include <algorithm>
+#include <cstring>
+
 #include <Types.hpp>
 #include <types/DTInfo.hpp>
 
@@ -17,6 +20,7 @@
 #include <core/ProcSingleton.hpp>
 #include <core/Exceptions.hpp>
 
+#include <containers/DArray.hpp>
 #include <containers/mpi/FastBuffer.hpp>
 #include <containers/mpi/MPIRequest.hpp>
 
@@ -42,6 +46,12 @@
 //
 //=========================================================================================================================================
 
+/** The largest message in bytes which autoSend and autoBroadcast transfer together with its size in a single message. It is set by the 
+*   CMake cache variable SN_MPI_EAGER_LIMIT. */
+#ifndef __SN_MPI_EAGER_LIMIT__
+   #define __SN_MPI_EAGER_LIMIT__ 4096
+#endif
+
 /** The space in which all global entities of the framework are accessible */
 namespace simpleNewton {
 
@@ -54,16 +64,51 @@ enum class MPIRecvMode   { Standard, Immediate };
 /** An enum which is used to select the type of MPI broadcast operation: MPI_Bcast or MPI_Ibcast */
 enum class MPIBcastMode  { Standard, Immediate };
 
-/** An enum which is used to specify on which operation it is to be waited: MPI_Isend, MPI_Irecv or MPI_Ibcast */
-enum class MPIWaitOp     { Send, Receive, Broadcast };
+/** An enum which is used to select the type of MPI reduction: MPI_Reduce/MPI_Allreduce or MPI_Ireduce/MPI_Iallreduce */
+enum class MPIReduceMode { Standard, Immediate };
+
+/** An enum which is used to select the type of MPI gather operation: MPI_Gather(v)/MPI_Allgather(v) or MPI_Igather(v)/MPI_Iallgather(v) */
+enum class MPIGatherMode { Standard, Immediate };
+
+/** An enum which is used to select the type of MPI scatter operation: MPI_Scatter(v) or MPI_Iscatter(v) */
+enum class MPIScatterMode { Standard, Immediate };
+
+/** An enum which is used to select the type of MPI all-to-all exchange: MPI_Alltoall(v) or MPI_Ialltoall(v) */
+enum class MPIAlltoallMode { Standard, Immediate };
+
+/** An enum which is used to select the type of MPI neighbourhood collective: MPI_Neighbor_alltoall(v) or MPI_Ineighbor_alltoall(v) */
+enum class MPINeighbourMode { Standard, Immediate };
+
+/** An enum which is used to select the process topology of a neighbourhood collective: the 6 face neighbours in the Cartesian process 
+*   grid or all 26 neighbouring blocks */
+enum class MPITopology   { Cartesian, Neighbourhood };
+
+/** An enum which is used to select the operation of an MPI reduction: MPI_SUM, MPI_PROD, MPI_MIN, MPI_MAX, MPI_LAND or MPI_LOR */
+enum class MPIReduceOp   { Sum, Prod, Min, Max, LogicalAnd, LogicalOr };
+
+/** An enum which is used to specify on which operation it is to be waited: MPI_Isend, MPI_Irecv, MPI_Ibcast or any other non-blocking 
+*   collective operation */
+enum class MPIWaitOp     { Send, Receive, Broadcast, Collective };
 
 //===CLASS==================================================================================================================================
 
 /** An elementary message passing wrapper. It provides send, auto-send, receive, broadcast, auto-broadcast, reduce, gather and scatter 
-*   functionalities, and their closely associated variations (synchronous/non-blocking) for any of thirteen, basic datatypes: char, 
-*   unsigned char, short, unsigned short, int, unsigned int, long, unsigned long, long long, unsigned long long, float, double and bool.
+*   functionalities (including allreduce, allgather and the variants gatherv, allgatherv and scatterv for parts of differing sizes), the 
+*   neighbourhood collectives neighbourAlltoall(v) over the process topology, and their closely associated variations 
+*   (synchronous/non-blocking) for any of thirteen, basic datatypes: char, unsigned char, short, unsigned short, int, unsigned int, long, 
+*   unsigned long, long long, unsigned long long, float, double and bool. Except for the reductions, they are also available for every 
+*   other type which DTInfo describes by a derived datatype, e.g., Vector3 and Matrix3.
+*
+*   Regions of a DArray (or Field), i.e., elements at a constant stride, and subsets of it given by a list of indices are sent and received
+*   in place by sendRegion, receiveRegion, sendIndexed and receiveIndexed. They describe the layout to MPI by a derived datatype instead of
+*   packing the elements into a buffer first. Either side may use any layout, as long as the numbers of elements agree.
+*
+*   By default, the calls of different threads are serialized by locks. With the CMake option SN_USE_MPI_THREAD_MULTIPLE, the locks are 
+*   dropped and every thread communicates on its own communicator (see ProcSingleton::getThreadComm), so that the threads may drive 
+*   their exchanges concurrently. A message is then received by the thread with the same number on the target process, and collective 
+*   operations must be called by the same thread on all processes.
 *
-*   \tparam TYPE_T   Data type which must necessarily be basic.
+*   \tparam TYPE_T   Data type which must be basic or otherwise described by DTInfo.
 */
 //==========================================================================================================================================
 
@@ -77,22 +122,71 @@ public:
    
    /** Function to send basic data types from one process to another. */
    template< MPISendMode = MPISendMode::Standard >
-   static void send( const FastBuffer<TYPE_T> & , int , MPIRequest<TYPE_T> & = {} );
+   static void send( const FastBuffer<TYPE_T> & , int , MPIRequest<TYPE_T> & = noRequest(), int = -1, small_t = 0 );
    
    /** Function to receive basic data types from one process to another. */
    template< MPIRecvMode = MPIRecvMode::Standard >
-   static void receive( FastBuffer<TYPE_T> & , int , int, MPIRequest<TYPE_T> & = {} );
+   static void receive( FastBuffer<TYPE_T> & , int , int, MPIRequest<TYPE_T> & = noRequest(), small_t = 0 );
    
    /** Function to broadcast both the size as well as the contents of an array of basic data type from one process to the others. */
    static void autoBroadcast( FastBuffer<TYPE_T> & , int );
    
    /** Function to broadcast basic data types from one process to the others. */
    template< MPIBcastMode = MPIBcastMode::Standard >
-   static void broadcast( FastBuffer<TYPE_T> & , int , int , MPIRequest<TYPE_T> & = {} );
+   static void broadcast( FastBuffer<TYPE_T> & , int , int , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to reduce an array of basic data type element-wise over all processes onto one process. */
+   template< MPIReduceMode = MPIReduceMode::Standard >
+   static void reduce( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , MPIReduceOp , int , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to reduce an array of basic data type element-wise over all processes onto every process. */
+   template< MPIReduceMode = MPIReduceMode::Standard >
+   static void allreduce( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , MPIReduceOp , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to gather equally sized arrays of basic data type from all processes onto one process. */
+   template< MPIGatherMode = MPIGatherMode::Standard >
+   static void gather( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , int , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to gather arrays of basic data type of differing sizes from all processes onto one process. */
+   template< MPIGatherMode = MPIGatherMode::Standard >
+   static void gatherv( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , const FastBuffer<int> & , const FastBuffer<int> & , int , 
+                        MPIRequest<TYPE_T> & = noRequest() );
    
-   /* Operation: Reduce basic types to buffer */
-   /*template< TYPE_T >
-   static void reduce( FastBuffer<TYPE_T> & , int );*/
+   /** Function to gather equally sized arrays of basic data type from all processes onto every process. */
+   template< MPIGatherMode = MPIGatherMode::Standard >
+   static void allgather( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to gather arrays of basic data type of differing sizes from all processes onto every process. */
+   template< MPIGatherMode = MPIGatherMode::Standard >
+   static void allgatherv( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , const FastBuffer<int> & , const FastBuffer<int> & , 
+                           MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to scatter equally sized parts of an array of basic data type from one process to all processes. */
+   template< MPIScatterMode = MPIScatterMode::Standard >
+   static void scatter( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , int , int , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to scatter parts of differing sizes of an array of basic data type from one process to all processes. */
+   template< MPIScatterMode = MPIScatterMode::Standard >
+   static void scatterv( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , const FastBuffer<int> & , const FastBuffer<int> & , int , 
+                         MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to exchange equally sized parts of an array of basic data type between all processes. */
+   template< MPIAlltoallMode = MPIAlltoallMode::Standard >
+   static void alltoall( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , int , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to exchange parts of differing sizes of an array of basic data type between all processes. */
+   template< MPIAlltoallMode = MPIAlltoallMode::Standard >
+   static void alltoallv( const FastBuffer<TYPE_T> & , const FastBuffer<int> & , const FastBuffer<int> & , FastBuffer<TYPE_T> & , 
+                          const FastBuffer<int> & , const FastBuffer<int> & , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to exchange equally sized parts of an array of basic data type with the neighbours in a process topology. */
+   template< MPINeighbourMode = MPINeighbourMode::Standard, MPITopology = MPITopology::Neighbourhood >
+   static void neighbourAlltoall( const FastBuffer<TYPE_T> & , FastBuffer<TYPE_T> & , int , MPIRequest<TYPE_T> & = noRequest() );
+   
+   /** Function to exchange parts of differing sizes of an array of basic data type with the neighbours in a process topology. */
+   template< MPINeighbourMode = MPINeighbourMode::Standard, MPITopology = MPITopology::Neighbourhood >
+   static void neighbourAlltoallv( const FastBuffer<TYPE_T> & , const FastBuffer<int> & , const FastBuffer<int> & , FastBuffer<TYPE_T> & , 
+                                   const FastBuffer<int> & , const FastBuffer<int> & , MPIRequest<TYPE_T> & = noRequest() );
    
    /** Function to wait for the completion of non-blocking MPI operations. */
    template < MPIWaitOp >
@@ -100,6 +194,81 @@ public:
    
    /** Function to wait for the completion of a given set of non-blocking MPI operations. */
    static void waitAll( int , MPIRequest< TYPE_T > & );
+   
+   /** Function to set up a persistent send of basic data types from one process to another. */
+   static void sendInit( const FastBuffer<TYPE_T> & , int , MPIRequest<TYPE_T> & , int = -1, small_t = 0 );
+   
+   /** Function to set up a persistent receive of basic data types from one process to another. */
+   static void receiveInit( FastBuffer<TYPE_T> & , int , int , MPIRequest<TYPE_T> & , small_t = 0 );
+   
+   /** Function to start a given set of persistent MPI operations. */
+   static void startAll( int , MPIRequest< TYPE_T > & );
+   
+   /** Function to send a region of an array, i.e., elements at a constant stride, from one process to another. */
+   template< MPISendMode = MPISendMode::Standard, class ALLOC_POLICY >
+   static void sendRegion( const DArray<TYPE_T, ALLOC_POLICY> & , int , large_t , int , int = 1, MPIRequest<TYPE_T> & = noRequest(), 
+                           small_t = 0 );
+   
+   /** Function to receive a message into a region of an array, i.e., elements at a constant stride. */
+   template< MPIRecvMode = MPIRecvMode::Standard, class ALLOC_POLICY >
+   static void receiveRegion( DArray<TYPE_T, ALLOC_POLICY> & , int , large_t , int , int = 1, MPIRequest<TYPE_T> & = noRequest(), 
+                              small_t = 0 );
+   
+   /** Function to send the elements of an array given by a list of indices from one process to another. */
+   template< MPISendMode = MPISendMode::Standard, class ALLOC_POLICY >
+   static void sendIndexed( const DArray<TYPE_T, ALLOC_POLICY> & , int , const FastBuffer<int> & , MPIRequest<TYPE_T> & = noRequest(), 
+                            small_t = 0 );
+   
+   /** Function to receive a message into the elements of an array given by a list of indices. */
+   template< MPIRecvMode = MPIRecvMode::Standard, class ALLOC_POLICY >
+   static void receiveIndexed( DArray<TYPE_T, ALLOC_POLICY> & , int , const FastBuffer<int> & , MPIRequest<TYPE_T> & = noRequest(), 
+                               small_t = 0 );
+   
+private:
+   
+   /** Function to obtain the request container which blocking operations are given by default, and which they leave untouched. */
+   static MPIRequest<TYPE_T> & noRequest();
+   
+   /** Function to check that a non-blocking operation has been given a request container of its own. */
+   static void checkRequest( const MPIRequest<TYPE_T> & , const char * );
+   
+   /** Function to fit the size of a receive buffer to the size of a collective message. */
+   static void fitBuffer( FastBuffer<TYPE_T> & , large_t );
+   
+   /** Function to copy a part of one buffer into another, which stands in for a collective operation on a single process. */
+   static void copyLocal( const FastBuffer<TYPE_T> & , large_t , FastBuffer<TYPE_T> & , large_t , large_t );
+   
+   /** Function to check the counts and displacements of a collective operation and to obtain the extent of the whole message. */
+   static large_t getExtent( const FastBuffer<int> & , const FastBuffer<int> & , large_t );
+   
+   /** Function to check that a list of indices lies within an array. */
+   static void checkIndices( const FastBuffer<int> & , large_t );
+   
+   #ifdef __SN_USE_MPI__
+   /** Function to obtain the MPI counterpart of a reduction operation. */
+   static MPI_Op getMPIOp( MPIReduceOp );
+   
+   /** Function to obtain the communicator of a process topology and the number of neighbours in it. */
+   static MPI_Comm getTopologyComm( MPITopology , int & );
+   
+   /** Function to commit the derived datatype of a region of an array. */
+   static MPI_Datatype commitRegionType( int , int );
+   
+   /** Function to commit the derived datatype of the elements of an array given by a list of indices. */
+   static MPI_Datatype commitIndexedType( const FastBuffer<int> & );
+   
+   /** Function to start the blocking or the non-blocking variant of a collective operation and to check its return code. */
+   template< typename STANDARD_CALL, typename IMMEDIATE_CALL >
+   static void runCollective( bool , STANDARD_CALL , IMMEDIATE_CALL , MPIRequest<TYPE_T> & , const char * , const char * );
+   
+   /** Function to send one element of a layout datatype, which is released thereafter. */
+   template< MPISendMode >
+   static void sendLayout( const TYPE_T * , MPI_Datatype & , int , int , MPIRequest<TYPE_T> & , small_t );
+   
+   /** Function to receive one element of a layout datatype, which is released thereafter. */
+   template< MPIRecvMode >
+   static void receiveLayout( TYPE_T * , MPI_Datatype & , int , int , MPIRequest<TYPE_T> & , small_t );
+   #endif
 };
 
 
@@ -109,11 +278,13 @@ public:
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-/** The container FastBuffer is used to provide pointer access to the underlying array. Notes on exception safety: basic safety 
-*   guaranteed. An InvalidArgument exception is thrown if the arguments are not logical. An MPIError exception is thrown if the return code 
-*   of the MPI send operation is not MPI_SUCCESS.
+/** The container FastBuffer is used to provide pointer access to the underlying array. A message of at most __SN_MPI_EAGER_LIMIT__ 
+*   bytes travels together with its size in a single message, which the receiving process takes into a buffer of fixed capacity. A larger 
+*   message is announced by its size alone and follows separately, which the receiving process picks up by a matched probe 
+*   (MPI_Mprobe/MPI_Mrecv). Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the arguments 
+*   are not logical. An MPIError exception is thrown if the return code of the MPI send operation is not MPI_SUCCESS.
 *
-*   \tparam TYPE_T   Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
 *   \param sbuff     Array which contains the message to be sent.
 *   \param rbuff     Array which will receive the message.
 *   \param source    The rank of the sending process.
@@ -122,7 +293,7 @@ public:
 template< class TYPE_T >
 void BaseComm<TYPE_T>::autoSend( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, int source, int target ) {
    
-   SN_CT_REQUIRE< typetraits::is_basic<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
    
    #ifndef __SN_USE_MPI__
    return;               // Speedy return prevents adding an if conditional to serial overhead
@@ -155,24 +326,42 @@ void BaseComm<TYPE_T>::autoSend( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TY
    }
    #endif
    
+   constexpr int capacity = sizeof( int ) + __SN_MPI_EAGER_LIMIT__;   // The size and the contents of a small message.
+   
    int tag = source + target;
    int info = -1;
    
    /* Thread safety is important */
-   #ifdef __SN_USE_STL_MULTITHREADING__
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    static std::mutex mt;
    std::lock_guard< std::mutex > lguard( mt );
    #endif
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    OMP_CRITICAL_REGION()
    {
    #endif
    
    SN_MPI_PROC_REGION( source ) {
-
-      // Sendd the contents of sbuff right away!
-      info = MPI_Send( sbuff.data_, sbuff.size_, DTInfo< TYPE_T >::mpi_type, target, tag, MPI_COMM_WORLD );
+      
+      const int size = static_cast< int >( sbuff.size_ );
+      const bool eager = sbuff.size_ * sizeof( TYPE_T ) <= __SN_MPI_EAGER_LIMIT__;
+      
+      // The size leads the message, and the contents follow right behind it if they are small enough.
+      char staging[ capacity ];
+      int bytes = sizeof( int );
+      std::memcpy( staging, &size, sizeof( int ) );
+      
+      if( eager ) {
+         std::memcpy( staging + sizeof( int ), sbuff.data_.raw_ptr(), sbuff.size_ * sizeof( TYPE_T ) );
+         bytes += static_cast< int >( sbuff.size_ * sizeof( TYPE_T ) );
+      }
+      
+      info = MPI_Send( staging, bytes, MPI_BYTE, target, tag, ProcSingleton::getThreadComm() );
+      
+      // A large message follows separately.
+      if( info == MPI_SUCCESS && ! eager )
+         info = MPI_Send( sbuff.data_, size, getMPIType< TYPE_T >(), target, tag, ProcSingleton::getThreadComm() );
    
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -186,7 +375,7 @@ void BaseComm<TYPE_T>::autoSend( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TY
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPISend, "[ " << DTInfo< TYPE_T >::mpi_name
                                                      << ", " << std::to_string( sbuff.size_ ) << " ], "
                                                      << std::to_string( source ) << ", " << std::to_string( target )
-                                                     << " --tag" << std::to_string( tag ) );
+                                                     << " --tag" << std::to_string( tag ) << ( eager ? " --eager" : "" ) );
    }
    
    SN_MPI_PROC_REGION( target ) {
@@ -194,33 +383,57 @@ void BaseComm<TYPE_T>::autoSend( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TY
       int recv_size = 0;
       MPI_Status stat;
       
-      // Probe for size
-      info = MPI_Probe( source, tag, MPI_COMM_WORLD, &stat );
+      // Receive the size, and with it the contents of a small message.
+      char staging[ capacity ];
+      info = MPI_Recv( staging, capacity, MPI_BYTE, source, tag, ProcSingleton::getThreadComm(), &stat );
       
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
       
       #ifdef NDEBUG
       if( info != MPI_SUCCESS ) {
-         SN_THROW_MPI_ERROR( "MPI_Send_Error" );
+         SN_THROW_MPI_ERROR( "MPI_Recv_Error" );
       }
       #endif
       
-      // Get the size
-      MPI_Get_count( &stat, DTInfo< TYPE_T >::mpi_type, &recv_size );
+      std::memcpy( &recv_size, staging, sizeof( int ) );
+      
+      const bool eager = static_cast< large_t >( recv_size ) * sizeof( TYPE_T ) <= __SN_MPI_EAGER_LIMIT__;
       
       // Resize receiving container.
       rbuff.resize( recv_size );
       
-      // Now receive the whole thing.
-      info = MPI_Recv( rbuff.data_, recv_size, DTInfo< TYPE_T >::mpi_type, source, MPI_ANY_TAG, MPI_COMM_WORLD, 
-                       &stat );
+      int count = 0;
+      
+      if( eager ) {
+         
+         MPI_Get_count( &stat, MPI_BYTE, &count );
+         count = ( count - static_cast< int >( sizeof( int ) ) ) / static_cast< int >( sizeof( TYPE_T ) );
+         
+         std::memcpy( rbuff.data_.raw_ptr(), staging + sizeof( int ), recv_size * sizeof( TYPE_T ) );
+      }
+      else {
+         
+         // The large message is picked up by a matched probe, so that no other receive can intervene.
+         MPI_Message msg;
+         info = MPI_Mprobe( source, tag, ProcSingleton::getThreadComm(), &msg, &stat );
+         
+         if( info == MPI_SUCCESS ) {
+            MPI_Get_count( &stat, getMPIType< TYPE_T >(), &count );
+            info = MPI_Mrecv( rbuff.data_, recv_size, getMPIType< TYPE_T >(), &msg, &stat );
+         }
+         
+         SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+         
+         #ifdef NDEBUG
+         if( info != MPI_SUCCESS ) {
+            SN_THROW_MPI_ERROR( "MPI_Mrecv_Error" );
+         }
+         #endif
+      }
       
       // Check status - count
       SN_ASSERT_EQUAL( stat.MPI_SOURCE, source );
-      
-      int count = 0;
-      MPI_Get_count( &stat, DTInfo< TYPE_T >::mpi_type, &count );
       SN_ASSERT_EQUAL( count, recv_size );
       
       #ifdef NDEBUG
@@ -231,10 +444,11 @@ void BaseComm<TYPE_T>::autoSend( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TY
       
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPIRecv, "[ " << DTInfo< TYPE_T >::mpi_name
                                                      << ", " << std::to_string( recv_size ) << " ], "
-                                                     << std::to_string( source ) << ", " << std::to_string( target ) );
+                                                     << std::to_string( source ) << ", " << std::to_string( target )
+                                                     << ( eager ? " --eager" : "" ) );
    }
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    }                          // Closing up the critical region
    #endif
    
@@ -247,19 +461,23 @@ void BaseComm<TYPE_T>::autoSend( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TY
 *   guaranteed. An InvalidArgument exception is thrown if the arguments are not logical. An MPIError exception is thrown if the return code 
 *   of the MPI send operation is not MPI_SUCCESS.
 *
-*   \tparam TYPE_T   Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
 *   \tparam SMODE    Specifies if the send operation is to be of blocking, synchronous or non-blocking type.
 *   \param buff      Array which makes up the contents of the message.
 *   \param target    The rank of the receiving process.
 *   \param mpiR      In case of non-blocking send operation, this container will be given important information which must be reclaimed by 
 *                    the corresponding wait function. In case of non-blocking operations, this parameter will take on default value and 
 *                    hence need not be specified.
+*   \param count     The number of elements at the head of the array which make up the message, the whole array if negative. This allows
+*                    a buffer to be reused for messages of varying size without reallocation.
+*   \param index     The position of the operation in the request container, so that several non-blocking operations may be completed
+*                    together by waitAll.
 */
 template< class TYPE_T >
 template< MPISendMode SMODE >
-void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIRequest<TYPE_T> & mpiR ) {
+void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIRequest<TYPE_T> & mpiR, int count, small_t index ) {
    
-   SN_CT_REQUIRE< typetraits::is_basic<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
    
    #ifndef __SN_USE_MPI__
    return;               // Speedy return prevents adding an if conditional to serial overhead
@@ -268,6 +486,8 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
    (void)buff.getSize();
    (void)mpiR.getSize();
    (void)target;
+   (void)count;
+   (void)index;
    
    #endif   // MPI Guard
    
@@ -275,14 +495,18 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
       return;
    }
    
+   const int size = ( count < 0 ) ? static_cast< int >( buff.getSize() ) : count;
+   
    // Assertions
    SN_ASSERT_INEQUAL( SN_MPI_RANK(), target );
-   SN_ASSERT_POSITIVE( buff.getSize() );
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_LEQ( static_cast< large_t >( size ), buff.getSize() );
    SN_ASSERT_GREQ( target, 0 );
    SN_ASSERT_LESS_THAN( target, SN_MPI_SIZE() );
    
    #ifdef NDEBUG
-   if( target == SN_MPI_RANK() || buff.getSize() <= 0 || target < 0 || target >= SN_MPI_SIZE() ) {
+   if( target == SN_MPI_RANK() || size <= 0 || static_cast< large_t >( size ) > buff.getSize() || target < 0 || 
+       target >= SN_MPI_SIZE() ) {
       SN_THROW_INVALID_ARGUMENT( "IA_MPI_Send" );
    }
    #endif
@@ -293,13 +517,16 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
    int tag = SN_MPI_RANK() + target;
    int info = -1;
    
+   if( SMODE == MPISendMode::Immediate )
+      checkRequest( mpiR, "IA_MPI_Isend" );
+   
    /* Thread safety is important */
-   #ifdef __SN_USE_STL_MULTITHREADING__
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    static std::mutex mt;
    std::lock_guard< std::mutex > lguard( mt );
    #endif
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    OMP_CRITICAL_REGION()
    {
    #endif
@@ -307,7 +534,7 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
    // Decision: the if-conditionals are evaluated at compile time.
    if( SMODE == MPISendMode::Standard ) {
       
-      info = MPI_Send( buff.data_, buff.getSize(), DTInfo< TYPE_T >::mpi_type, target, tag, MPI_COMM_WORLD );
+      info = MPI_Send( buff.data_, size, getMPIType< TYPE_T >(), target, tag, ProcSingleton::getThreadComm() );
       
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -319,13 +546,13 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
       #endif
       
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPISend, "[ " << DTInfo< TYPE_T >::mpi_name 
-                                                     << ", " << std::to_string(buff.getSize()) << "], " 
+                                                     << ", " << std::to_string(size) << "], " 
                                                      << std::to_string(SN_MPI_RANK()) << ", " << std::to_string(target)
                                                      << " --tag" << std::to_string( tag ) );
    }
    else if( SMODE == MPISendMode::Synchronous ) {
       
-      info = MPI_Ssend( buff.data_, buff.getSize(), DTInfo< TYPE_T >::mpi_type, target, tag++, MPI_COMM_WORLD );
+      info = MPI_Ssend( buff.data_, size, getMPIType< TYPE_T >(), target, tag++, ProcSingleton::getThreadComm() );
       
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -337,14 +564,18 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
       #endif
       
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPISsend, "[ " << DTInfo< TYPE_T >::mpi_name
-                                                      << ", " << std::to_string(buff.getSize()) << "], "
+                                                      << ", " << std::to_string(size) << "], "
                                                       << std::to_string(SN_MPI_RANK()) << ", " << std::to_string(target)
                                                       << " --tag" << std::to_string( tag ) );
    }
    else if( SMODE == MPISendMode::Immediate ) {
       
-      info = MPI_Isend( buff.data_, buff.getSize(), DTInfo< TYPE_T >::mpi_type, target, tag++, MPI_COMM_WORLD, 
-                        mpiR );
+      SN_ASSERT_INDEX_WITHIN_SIZE( index, mpiR.getSize() );
+      
+      mpiR.setTransferCount( 0, index );   // The status of a send carries no count.
+      
+      info = MPI_Isend( buff.data_, size, getMPIType< TYPE_T >(), target, tag++, ProcSingleton::getThreadComm(), 
+                        mpiR.raw_ptr() + index );
       
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -356,12 +587,12 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
       #endif
       
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPIIsend, "[ " << DTInfo< TYPE_T >::mpi_name
-                                                      << ", " << std::to_string(buff.getSize()) << "], " 
+                                                      << ", " << std::to_string(size) << "], " 
                                                       << std::to_string(SN_MPI_RANK()) << ", " << std::to_string(target)
                                                       << " --tag" << std::to_string( tag - 1 ) );
    }
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    }                          // Closing up the critical region
    #endif
    
@@ -378,21 +609,24 @@ void BaseComm<TYPE_T>::send( const FastBuffer<TYPE_T> & buff, int target, MPIReq
 *   guaranteed. An InvalidArgument exception is thrown if the arguments are not logical. An MPIError exception is thrown if the return code 
 *   of the operation is not MPI_SUCCESS or if the transfer count doesn't match the size provided (in case of blocking send).
 *
-*   \tparam TYPE_T   Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
 *   \tparam RMODE    Specifies if the receive operation is to be of blocking, synchronous or non-blocking type.
 *   \param buff      Array which shall receive the contents of the message.
-*   \param size      Size of the incoming message.
+*   \param size      Size of the incoming message. The array is only enlarged if it is smaller, so that it can be reused for messages of 
+*                    varying size without reallocation.
 *   \param source    The rank of the sending process.
 *   \param mpiR      In case of non-blocking receive operation, this container will be given important information which must be reclaimed
 *                    by the corresponding wait function. In case of non-blocking operations, this parameter will take on default value and
 *                    hence need not be specified.
+*   \param index     The position of the operation in the request container, so that several non-blocking operations may be completed
+*                    together by waitAll.
 */
 
 template< typename TYPE_T >
 template< MPIRecvMode RMODE >
-void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source, MPIRequest<TYPE_T> & mpiR ) {
+void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source, MPIRequest<TYPE_T> & mpiR, small_t index ) {
    
-   SN_CT_REQUIRE< typetraits::is_basic<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
    
    #ifndef __SN_USE_MPI__
    return;               // Speedy return prevents adding an if conditional to serial overhead
@@ -402,6 +636,7 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
    (void)mpiR.getSize();
    (void)source;
    (void)size;
+   (void)index;
    
    #endif   // MPI Guard
    
@@ -420,8 +655,9 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
    }
    #endif
 
-   /* Firstly resize the buffer */
-   buff.resize( size );
+   /* Firstly make room in the buffer */
+   if( buff.getSize() < static_cast< large_t >( size ) )
+      buff.resize( size );
    
    
    #ifdef __SN_USE_MPI__
@@ -430,13 +666,16 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
    
    MPI_Status stat;
    
+   if( RMODE == MPIRecvMode::Immediate )
+      checkRequest( mpiR, "IA_MPI_Irecv" );
+   
    /* Thread safety is important */
-   #ifdef __SN_USE_STL_MULTITHREADING__
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    static std::mutex mt;
    std::lock_guard< std::mutex > lguard( mt );
    #endif
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    OMP_CRITICAL_REGION()
    {
    #endif
@@ -444,7 +683,7 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
    // Decision: the if conditionals are evaluated at compile time
    if( RMODE == MPIRecvMode::Standard ) {
       
-      info = MPI_Recv( buff.data_, size, DTInfo< TYPE_T >::mpi_type, source, MPI_ANY_TAG, MPI_COMM_WORLD, &stat );
+      info = MPI_Recv( buff.data_, size, getMPIType< TYPE_T >(), source, MPI_ANY_TAG, ProcSingleton::getThreadComm(), &stat );
       
       // Run-time error checking - success
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -462,7 +701,7 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
       SN_ASSERT_EQUAL( stat.MPI_SOURCE, source );
       
       int count = 0; 
-      MPI_Get_count( &stat, DTInfo< TYPE_T >::mpi_type, &count );
+      MPI_Get_count( &stat, getMPIType< TYPE_T >(), &count );
       
       SN_ASSERT_EQUAL( count, size );
       
@@ -474,9 +713,11 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
    }
    else if( RMODE == MPIRecvMode::Immediate ) {
       
-      mpiR.setTransferCount( size );
+      SN_ASSERT_INDEX_WITHIN_SIZE( index, mpiR.getSize() );
       
-      info = MPI_Irecv( buff.data_, size, DTInfo< TYPE_T >::mpi_type, source, MPI_ANY_TAG, MPI_COMM_WORLD, mpiR );
+      mpiR.setTransferCount( size, index );
+      
+      info = MPI_Irecv( buff.data_, size, getMPIType< TYPE_T >(), source, MPI_ANY_TAG, ProcSingleton::getThreadComm(), mpiR.raw_ptr() + index );
       
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -492,7 +733,7 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
                                                       << std::to_string(source) << ", " << std::to_string(SN_MPI_RANK()) );
    }
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    }                          // Closing up the critical region
    #endif
    
@@ -505,10 +746,12 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
 //   Definition of automatic broadcast function
 ////////////////////////////////////////////////
 
-/** The container FastBuffer is used to provide pointer access to the underlying array. Notes on exception safety: basic safety 
-*   guaranteed. An MPIError exception is thrown if the return code of the operation is not MPI_SUCCESS.
+/** The container FastBuffer is used to provide pointer access to the underlying array. A message of at most __SN_MPI_EAGER_LIMIT__ 
+*   bytes is broadcast together with its size in a single broadcast of fixed capacity, since the receiving processes cannot know its size 
+*   beforehand. A larger message is broadcast separately after its size. Notes on exception safety: basic safety guaranteed. An MPIError 
+*   exception is thrown if the return code of the operation is not MPI_SUCCESS.
 *
-*   \tparam TYPE_T   Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
 *   \param buff      Array which holds the contents of the message.
 *   \param source    The rank of the broadcasting process.
 */
@@ -516,7 +759,7 @@ void BaseComm<TYPE_T>::receive( FastBuffer<TYPE_T> & buff, int size, int source,
 template< typename TYPE_T >
 void BaseComm<TYPE_T>::autoBroadcast( FastBuffer<TYPE_T> & buff, int source ) {
    
-   SN_CT_REQUIRE< typetraits::is_basic<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
    
    #ifndef __SN_USE_MPI__
    return;               // Speedy return prevents adding an if conditional to serial overhead
@@ -543,22 +786,33 @@ void BaseComm<TYPE_T>::autoBroadcast( FastBuffer<TYPE_T> & buff, int source ) {
    
    #ifdef __SN_USE_MPI__
    
+   constexpr int capacity = sizeof( int ) + __SN_MPI_EAGER_LIMIT__;   // The size and the contents of a small message.
+   
    int info = -1;
    
    /* Thread safety is important */
-   #ifdef __SN_USE_STL_MULTITHREADING__
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    static std::mutex mt;
    std::lock_guard< std::mutex > lguard( mt );
    #endif
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    OMP_CRITICAL_REGION()
    {
    #endif
    
-   /* First, the broadcasting process broadcasts the size of the message */
+   /* First, the broadcasting process broadcasts the size of the message, followed by its contents if they are small enough */
+   char staging[ capacity ];
    int size_msg = static_cast< int >( buff.getSize() );
-   info = MPI_Bcast( &size_msg, 1, MPI_INT, source, MPI_COMM_WORLD );
+   
+   SN_MPI_PROC_REGION( source ) {
+      
+      std::memcpy( staging, &size_msg, sizeof( int ) );
+      if( buff.getSize() * sizeof( TYPE_T ) <= __SN_MPI_EAGER_LIMIT__ )
+         std::memcpy( staging + sizeof( int ), buff.data_.raw_ptr(), buff.getSize() * sizeof( TYPE_T ) );
+   }
+   
+   info = MPI_Bcast( staging, capacity, MPI_BYTE, source, ProcSingleton::getThreadComm() );
    
    // Run-time error checking
    SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -569,32 +823,38 @@ void BaseComm<TYPE_T>::autoBroadcast( FastBuffer<TYPE_T> & buff, int source ) {
    }
    #endif
    
-   SN_LOG_REPORT_L1_EVENT( LogEventType::MPIBcast, "[ MPI_INT, 1 ], " << std::to_string(source) );
-
-   info = -1;
+   std::memcpy( &size_msg, staging, sizeof( int ) );
+   
+   const bool eager = static_cast< large_t >( size_msg ) * sizeof( TYPE_T ) <= __SN_MPI_EAGER_LIMIT__;
    
    /* Receiving processes shall resize their containers suitably */
    SN_MPI_EXCEPT_PROC_REGION( source ) {
+      
       buff.resize( static_cast< small_t >( size_msg ) );
+      if( eager )
+         std::memcpy( buff.data_.raw_ptr(), staging + sizeof( int ), buff.getSize() * sizeof( TYPE_T ) );
    }
    
-   /* Next, the actual message */
-   info = MPI_Bcast( buff.data_, size_msg, DTInfo< TYPE_T >::mpi_type, source, MPI_COMM_WORLD );
-   
-   // Run-time error checking
-   SN_ASSERT_EQUAL( info, MPI_SUCCESS );
-   
-   #ifdef NDEBUG
-   if( info != MPI_SUCCESS ) {   
-      SN_THROW_MPI_ERROR( "MPI_AutoBcast2_Error" );
+   /* Next, a large message on its own */
+   if( ! eager ) {
+      
+      info = MPI_Bcast( buff.data_, size_msg, getMPIType< TYPE_T >(), source, ProcSingleton::getThreadComm() );
+      
+      // Run-time error checking
+      SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+      
+      #ifdef NDEBUG
+      if( info != MPI_SUCCESS ) {   
+         SN_THROW_MPI_ERROR( "MPI_AutoBcast2_Error" );
+      }
+      #endif
    }
-   #endif
    
    SN_LOG_REPORT_L1_EVENT( LogEventType::MPIBcast, "[ " << DTInfo< TYPE_T >::mpi_name
                                                    << ", " << std::to_string(size_msg) << " ], "
-                                                   << std::to_string(source) );
+                                                   << std::to_string(source) << ( eager ? " --eager" : "" ) );
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    }                          // Closing up the critical region
    #endif
    
@@ -611,7 +871,7 @@ void BaseComm<TYPE_T>::autoBroadcast( FastBuffer<TYPE_T> & buff, int source ) {
 *   guaranteed. An InvalidArgument is thrown is the arguments are not suitable. An MPIError exception is thrown if the return code of the 
 *   operation is not MPI_SUCCESS.
 *
-*   \tparam TYPE_T   Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
 *   \tparam BCMODE   Specifies if the broadcast operation is to be of blocking or non-blocking type.
 *   \param buff      Array which makes up the contents of the message.
 *   \param size      Size of the message.
@@ -625,7 +885,7 @@ template< typename TYPE_T >
 template< MPIBcastMode BCMODE >
 void BaseComm<TYPE_T>::broadcast( FastBuffer<TYPE_T> & buff, int size, int source, MPIRequest<TYPE_T> & mpiR ) {
    
-   SN_CT_REQUIRE< typetraits::is_basic<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
    
    #ifndef __SN_USE_MPI__
    return;               // Speedy return prevents adding an if conditional to serial overhead
@@ -662,13 +922,16 @@ void BaseComm<TYPE_T>::broadcast( FastBuffer<TYPE_T> & buff, int size, int sourc
    
    int info = -1;
    
+   if( BCMODE == MPIBcastMode::Immediate )
+      checkRequest( mpiR, "IA_MPI_Ibcast" );
+   
    /* Thread safety is important */
-   #ifdef __SN_USE_STL_MULTITHREADING__
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    static std::mutex mt;
    std::lock_guard< std::mutex > lguard( mt );
    #endif
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    OMP_CRITICAL_REGION()
    {
    #endif
@@ -676,7 +939,7 @@ void BaseComm<TYPE_T>::broadcast( FastBuffer<TYPE_T> & buff, int size, int sourc
    /* Decision */
    if( BCMODE == MPIBcastMode::Standard ) {
       
-      info = MPI_Bcast( buff.data_, size, DTInfo< TYPE_T >::mpi_type, source, MPI_COMM_WORLD );
+      info = MPI_Bcast( buff.data_, size, getMPIType< TYPE_T >(), source, ProcSingleton::getThreadComm() );
       
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -693,7 +956,7 @@ void BaseComm<TYPE_T>::broadcast( FastBuffer<TYPE_T> & buff, int size, int sourc
    }
    else if( BCMODE == MPIBcastMode::Immediate ) {
       
-      info = MPI_Ibcast( buff.data_, size, DTInfo< TYPE_T >::mpi_type, source, MPI_COMM_WORLD, mpiR );
+      info = MPI_Ibcast( buff.data_, size, getMPIType< TYPE_T >(), source, ProcSingleton::getThreadComm(), mpiR );
       
       // Run-time error checking
       SN_ASSERT_EQUAL( info, MPI_SUCCESS );
@@ -709,7 +972,7 @@ void BaseComm<TYPE_T>::broadcast( FastBuffer<TYPE_T> & buff, int size, int sourc
                                                        << std::to_string(source) );
    }
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    }                          // Closing up the critical region
    #endif
    
@@ -724,11 +987,11 @@ void BaseComm<TYPE_T>::broadcast( FastBuffer<TYPE_T> & buff, int size, int sourc
 
 /** The container FastBuffer is used to provide pointer access to the underlying array. Notes on exception safety: basic safety 
 *   guaranteed. An InvalidArgument exception is thrown if the request is invalid. An MPIError exception is thrown if the wait operation is 
-*   either unsuccessful or the transfer count doesn't match the one registered in the request container.
+*   either unsuccessful or, for a receive operation, the transfer count doesn't match the one registered in the request container.
 *
 *   This function derives from a template which specifies the exact operation, which in turn helps debugging greatly.
 *
-*   \tparam TYPE_T    Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam TYPE_T    Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
 *   \tparam WAIT_ON   Indicates for the completion of which MPI operation it is being waited.
 *   \param req        Provides information required for the completion of the non-blocking operation for which it is being waited.
 */
@@ -766,44 +1029,53 @@ void BaseComm<TYPE_T>::wait( MPIRequest<TYPE_T> & req ) {
    #endif
    
    /* Thread safety is important */
-   #ifdef __SN_USE_STL_MULTITHREADING__
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    static std::mutex mt;
    std::lock_guard< std::mutex > lguard( mt );
    #endif
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    OMP_CRITICAL_REGION()
    {
    #endif
    
    info = MPI_Wait( req, &stat );
    
-   // Check status: Has every little bit of data arrived as expected?
-   int actual_transfer_count = 0;
-   MPI_Get_count( &stat, DTInfo< TYPE_T >::mpi_type, &actual_transfer_count );
-
-   // Run-time error checking - success and count
+   // Run-time error checking - success
    SN_ASSERT_EQUAL( info, MPI_SUCCESS );
-   SN_ASSERT( req.isClear() );
-   SN_ASSERT_EQUAL( static_cast< small_t >( actual_transfer_count ), req.getTransferCount() );
+   SN_ASSERT( req.isPersistent() || req.isClear() );
    
    #ifdef NDEBUG
-   if( info != MPI_SUCCESS || ! req.isClear() ) {   
+   if( info != MPI_SUCCESS || ( ! req.isPersistent() && ! req.isClear() ) ) {   
       SN_THROW_MPI_ERROR( "MPI_Wait_Error" );
    }
-   if( actual_transfer_count != static_cast< int >( req.getTransferCount() ) ) {   
-      SN_THROW_MPI_ERROR( "MPI_Wait_Count_Error" );
-   }
    #endif
    
+   // Check status: Has every little bit of data arrived as expected? The status of a send or a broadcast is undefined.
+   if( WAIT_ON == MPIWaitOp::Receive ) {
+      
+      int actual_transfer_count = 0;
+      MPI_Get_count( &stat, getMPIType< TYPE_T >(), &actual_transfer_count );
+      
+      SN_ASSERT_EQUAL( static_cast< small_t >( actual_transfer_count ), req.getTransferCount() );
+      
+      #ifdef NDEBUG
+      if( actual_transfer_count != static_cast< int >( req.getTransferCount() ) ) {   
+         SN_THROW_MPI_ERROR( "MPI_Wait_Count_Error" );
+      }
+      #endif
+   }
+   
    if( WAIT_ON == MPIWaitOp::Send )
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPIWait, "( ISEND )" );
    else if( WAIT_ON == MPIWaitOp::Receive )
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPIWait, "( IRECV )" );
    else if( WAIT_ON == MPIWaitOp::Broadcast )
       SN_LOG_REPORT_L1_EVENT( LogEventType::MPIWait, "( IBCAST )" );
+   else if( WAIT_ON == MPIWaitOp::Collective )
+      SN_LOG_REPORT_L1_EVENT( LogEventType::MPIWait, "( COLLECTIVE )" );
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    }                          // Closing up the critical region
    #endif
    
@@ -818,9 +1090,11 @@ void BaseComm<TYPE_T>::wait( MPIRequest<TYPE_T> & req ) {
 
 /** The container FastBuffer is used to provide pointer access to the underlying array. Notes on exception safety: basic safety 
 *   guaranteed. An InvalidArgument exception is thrown if the argument count does not equal the size of the MPIRequest container. An 
-*   MPIError exception is thrown if the return code is not MPI_SUCCESS.
+*   MPIError exception is thrown if the return code is not MPI_SUCCESS or if the transfer count of a receive doesn't match the one 
+*   registered in the request container. Entries of the container which have not been used by a non-blocking operation are ignored, so 
+*   that a container may hold one entry per potential partner (see the index parameters of send and receive).
 *
-*   \tparam TYPE_T    Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam TYPE_T    Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
 *   \param count      The number of non-blocking operations.
 *   \param req        Provides information required for the completion of the non-blocking operations for which it is being waited.
 */
@@ -857,12 +1131,12 @@ void BaseComm<TYPE_T>::waitAll( int count, MPIRequest< TYPE_T > & req ) {
    FastBuffer< MPI_Status > stat( count );
    
    /* Thread safety is important */
-   #ifdef __SN_USE_STL_MULTITHREADING__
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    static std::mutex mt;
    std::lock_guard< std::mutex > lguard( mt );
    #endif
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    OMP_CRITICAL_REGION()
    {
    #endif
@@ -871,20 +1145,24 @@ void BaseComm<TYPE_T>::waitAll( int count, MPIRequest< TYPE_T > & req ) {
    
    // Run-time error checking - success
    SN_ASSERT_EQUAL( info, MPI_SUCCESS );
-   SN_ASSERT( req.isClear() );
+   SN_ASSERT( req.isPersistent() || req.isClear() );
    
    #ifdef NDEBUG
-   if( info != MPI_SUCCESS || ! req.isClear() ) {   
+   if( info != MPI_SUCCESS || ( ! req.isPersistent() && ! req.isClear() ) ) {   
       SN_THROW_MPI_ERROR( "MPI_Waitall_Error" );
    }
    #endif
    
    // Check status
    for( int i=0; i<count; ++i ) {
-  
+      
+      // Sends and unused entries carry no transfer count, since their status is undefined or empty.
+      if( req.getTransferCount(i) == 0 )
+         continue;
+      
       // Check status: Has every little bit of data arrived as expected?
       int actual_transfer_count = 0;
-      MPI_Get_count( &stat.data_[i], DTInfo< TYPE_T >::mpi_type, &actual_transfer_count );
+      MPI_Get_count( &stat.data_[i], getMPIType< TYPE_T >(), &actual_transfer_count );
       
       // Run-time error checking - count
       SN_ASSERT_EQUAL( static_cast< small_t >( actual_transfer_count ), req.getTransferCount(i) );
@@ -894,11 +1172,115 @@ void BaseComm<TYPE_T>::waitAll( int count, MPIRequest< TYPE_T > & req ) {
          SN_THROW_MPI_ERROR( "MPI_Waitall_Count_Error" );
       }
       #endif
+      
+      if( ! req.isPersistent() )
+         req.setTransferCount( 0, i );   // The entry may stay unused in the next round.
    }
    
    SN_LOG_REPORT_L1_EVENT( LogEventType::MPIWaitAll, "" );
    
-   #ifdef __SN_USE_OPENMP__
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   #endif   // MPI Guard
+}
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Definitions of persistent communication functions
+///////////////////////////////////////////////////////
+
+/** The container FastBuffer is used to provide pointer access to the underlying array, which is bound to the persistent request, i.e., 
+*   it must neither be destroyed nor resized while the request exists, whereas its contents may change between the starts. The request 
+*   is started by startAll and completed by wait or waitAll like a non-blocking send. Notes on exception safety: basic safety guaranteed. 
+*   An InvalidArgument exception is thrown if the arguments are not logical. An MPIError exception is thrown if the return code of the 
+*   MPI operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \param buff      Array which contains the message to be sent at every start.
+*   \param target    The rank of the receiving process.
+*   \param mpiR      The container which owns the persistent request from now on.
+*   \param count     The number of elements at the head of the array which make up the message, the whole array if negative.
+*   \param index     The position of the request in the container.
+*/
+template< class TYPE_T >
+void BaseComm<TYPE_T>::sendInit( const FastBuffer<TYPE_T> & buff, int target, MPIRequest<TYPE_T> & mpiR, int count, small_t index ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)buff.getSize();
+   (void)mpiR.getSize();
+   (void)target;
+   (void)count;
+   (void)index;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {      // Running with MPI but only 1 proc
+      return;
+   }
+   
+   const int size = ( count < 0 ) ? static_cast< int >( buff.getSize() ) : count;
+   
+   // Assertions
+   SN_ASSERT_INEQUAL( SN_MPI_RANK(), target );
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_LEQ( static_cast< large_t >( size ), buff.getSize() );
+   SN_ASSERT_GREQ( target, 0 );
+   SN_ASSERT_LESS_THAN( target, SN_MPI_SIZE() );
+   SN_ASSERT_INDEX_WITHIN_SIZE( index, mpiR.getSize() );
+   
+   #ifdef NDEBUG
+   if( target == SN_MPI_RANK() || size <= 0 || static_cast< large_t >( size ) > buff.getSize() || target < 0 || 
+       target >= SN_MPI_SIZE() || index >= mpiR.getSize() ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Send_Init" );
+   }
+   #endif
+   
+   
+   #ifdef __SN_USE_MPI__   // MPI Guard
+   
+   int tag = SN_MPI_RANK() + target;
+   int info = -1;
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   mpiR.setPersistent();
+   mpiR.setTransferCount( 0, index );   // The status of a send carries no count.
+   
+   info = MPI_Send_init( buff.data_, size, getMPIType< TYPE_T >(), target, tag, ProcSingleton::getThreadComm(), mpiR.raw_ptr() + index );
+   
+   // Run-time error checking
+   SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+   
+   #ifdef NDEBUG
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Send_init_Error" );
+   }
+   #endif
+   
+   SN_LOG_REPORT_L1_EVENT( LogEventType::MPISendInit, "[ " << DTInfo< TYPE_T >::mpi_name
+                                                      << ", " << std::to_string(size) << "], "
+                                                      << std::to_string(SN_MPI_RANK()) << ", " << std::to_string(target)
+                                                      << " --tag" << std::to_string( tag ) );
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
    }                          // Closing up the critical region
    #endif
    
@@ -906,6 +1288,1902 @@ void BaseComm<TYPE_T>::waitAll( int count, MPIRequest< TYPE_T > & req ) {
 }
 
 
+
+/** The container FastBuffer is used to provide pointer access to the underlying array, which is first enlarged if it is smaller than 
+*   the message and is then bound to the persistent request, i.e., it must neither be destroyed nor resized while the request exists. The 
+*   request is started by startAll and completed by wait or waitAll like a non-blocking receive. Notes on exception safety: basic safety 
+*   guaranteed. An InvalidArgument exception is thrown if the arguments are not logical. An MPIError exception is thrown if the return 
+*   code of the MPI operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \param buff      Array which will receive the message at every start.
+*   \param size      Size of the incoming message.
+*   \param source    The rank of the sending process.
+*   \param mpiR      The container which owns the persistent request from now on.
+*   \param index     The position of the request in the container.
+*/
+template< class TYPE_T >
+void BaseComm<TYPE_T>::receiveInit( FastBuffer<TYPE_T> & buff, int size, int source, MPIRequest<TYPE_T> & mpiR, small_t index ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)buff.getSize();
+   (void)mpiR.getSize();
+   (void)source;
+   (void)size;
+   (void)index;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running with MPI but only 1 proc
+      return;
+   }
+   
+   SN_ASSERT_INEQUAL( SN_MPI_RANK(), source );
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_GREQ( source, 0 );
+   SN_ASSERT_LESS_THAN( source, SN_MPI_SIZE() );
+   SN_ASSERT_INDEX_WITHIN_SIZE( index, mpiR.getSize() );
+   
+   #ifdef NDEBUG
+   if( source == SN_MPI_RANK() || size <= 0 || source < 0 || source >= SN_MPI_SIZE() || index >= mpiR.getSize() ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Recv_Init" );
+   }
+   #endif
+   
+   /* Firstly make room in the buffer */
+   if( buff.getSize() < static_cast< large_t >( size ) )
+      buff.resize( size );
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   int info = -1;
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   mpiR.setPersistent();
+   mpiR.setTransferCount( size, index );
+   
+   info = MPI_Recv_init( buff.data_, size, getMPIType< TYPE_T >(), source, MPI_ANY_TAG, ProcSingleton::getThreadComm(), mpiR.raw_ptr() + index );
+   
+   // Run-time error checking
+   SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+   
+   #ifdef NDEBUG
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Recv_init_Error" );
+   }
+   #endif
+   
+   SN_LOG_REPORT_L1_EVENT( LogEventType::MPIRecvInit, "[ " << DTInfo< TYPE_T >::mpi_name
+                                                      << ", " << std::to_string(size) << " ], "
+                                                      << std::to_string(source) << ", " << std::to_string(SN_MPI_RANK()) );
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the container does not own persistent 
+*   requests or if the count exceeds its size. An MPIError exception is thrown if the return code is not MPI_SUCCESS. Since MPI cannot 
+*   start a null request, the persistent requests which are to be started must occupy the first count entries of the container.
+*
+*   \tparam TYPE_T    Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \param count      The number of persistent operations to be started.
+*   \param req        The container which owns the persistent requests.
+*/
+template < typename TYPE_T >
+void BaseComm<TYPE_T>::startAll( int count, MPIRequest< TYPE_T > & req ) {
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)req.getSize();
+   (void)count;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 || count == 0 ) {   // Running with MPI but only 1 proc or nothing to start
+      return;
+   }
+   
+   // Logic check
+   SN_ASSERT( req.isPersistent() );
+   SN_ASSERT( count > 0 && count <= static_cast< int >( req.getSize() ) );
+   
+   #ifdef NDEBUG
+   if( ! req.isPersistent() || count < 0 || count > static_cast< int >( req.getSize() ) ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Startall" );
+   }
+   #endif
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   int info = -1;
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   info = MPI_Startall( count, req );
+   
+   // Run-time error checking
+   SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+   
+   #ifdef NDEBUG
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Startall_Error" );
+   }
+   #endif
+   
+   SN_LOG_REPORT_L1_EVENT( LogEventType::MPIStartAll, std::to_string( count ) );
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   #endif   // MPI Guard
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Definitions of collective communication functions
+////////////////////////////////////////////////////////
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. Every process contributes an array of the same 
+*   size, and the root receives the element-wise reduction of all of them. The send and the receive buffer may be the same container, in
+*   which case the reduction is performed in place on the root. On a single process, the send buffer is copied to the receive buffer. 
+*   Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the arguments are not suitable. An 
+*   MPIError exception is thrown if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam RMODE    Specifies if the reduction is to be of blocking or non-blocking type.
+*   \param sbuff     The contribution of this process.
+*   \param rbuff     The result, which is resized suitably on the root. The container is not touched on the other processes.
+*   \param op        The reduction operation.
+*   \param root      The rank of the process which receives the result.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIReduceMode RMODE >
+void BaseComm<TYPE_T>::reduce( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, MPIReduceOp op, int root, 
+                               MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< typetraits::is_basic<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   (void)op;
+   #endif   // MPI Guard
+   
+   const int size = static_cast< int >( sbuff.getSize() );
+   
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_GREQ( root, 0 );
+   SN_ASSERT_LESS_THAN( root, SN_MPI_SIZE() );
+   
+   #ifdef NDEBUG
+   if( size <= 0 || root < 0 || root >= SN_MPI_SIZE() ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Reduce" );
+   }
+   #endif
+   
+   /* The root shall resize its container suitably */
+   if( SN_MPI_RANK() == root ) {
+      fitBuffer( rbuff, static_cast< large_t >( size ) );
+   }
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the result is the contribution
+      copyLocal( sbuff, 0, rbuff, 0, static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   const void * send_ptr = ( &sbuff == &rbuff && SN_MPI_RANK() == root ) ? MPI_IN_PLACE : 
+                                                                           static_cast< const void * >( sbuff.data_.raw_ptr() );
+   
+   /* Decision */
+   runCollective( RMODE == MPIReduceMode::Immediate,
+                  [&]() { return MPI_Reduce( send_ptr, rbuff.data_, size, getMPIType< TYPE_T >(), getMPIOp( op ), root,
+                                           ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Ireduce( send_ptr, rbuff.data_, size, getMPIType< TYPE_T >(), getMPIOp( op ),
+                                                                root, ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Reduce_Error", "MPI_Ireduce_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( RMODE == MPIReduceMode::Standard ) ? LogEventType::MPIReduce : LogEventType::MPIIreduce, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ], " << std::to_string(root) );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. Every process contributes an array of the same 
+*   size, and every process receives the element-wise reduction of all of them. The send and the receive buffer may be the same 
+*   container, in which case the reduction is performed in place. On a single process, the send buffer is copied to the receive buffer.
+*   Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the arguments are not suitable. An 
+*   MPIError exception is thrown if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic as defined by the BasicTypeTraits library.
+*   \tparam RMODE    Specifies if the reduction is to be of blocking or non-blocking type.
+*   \param sbuff     The contribution of this process.
+*   \param rbuff     The result, which is resized suitably.
+*   \param op        The reduction operation.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIReduceMode RMODE >
+void BaseComm<TYPE_T>::allreduce( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, MPIReduceOp op, 
+                                  MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< typetraits::is_basic<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   (void)op;
+   #endif   // MPI Guard
+   
+   const int size = static_cast< int >( sbuff.getSize() );
+   
+   SN_ASSERT_POSITIVE( size );
+   
+   #ifdef NDEBUG
+   if( size <= 0 ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Allreduce" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, static_cast< large_t >( size ) );
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the result is the contribution
+      copyLocal( sbuff, 0, rbuff, 0, static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   const void * send_ptr = ( &sbuff == &rbuff ) ? MPI_IN_PLACE : static_cast< const void * >( sbuff.data_.raw_ptr() );
+   
+   /* Decision */
+   runCollective( RMODE == MPIReduceMode::Immediate,
+                  [&]() { return MPI_Allreduce( send_ptr, rbuff.data_, size, getMPIType< TYPE_T >(), getMPIOp( op ),
+                                              ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Iallreduce( send_ptr, rbuff.data_, size, getMPIType< TYPE_T >(), getMPIOp( op ),
+                                                                   ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Allreduce_Error", "MPI_Iallreduce_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( RMODE == MPIReduceMode::Standard ) ? LogEventType::MPIAllreduce : LogEventType::MPIIallreduce, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ]" );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. Every process contributes an array of the same 
+*   size, and the root receives all of them one after another in the order of the ranks. On a single process, the send buffer is copied 
+*   to the receive buffer. Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the arguments are 
+*   not suitable. An MPIError exception is thrown if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam GMODE    Specifies if the gather operation is to be of blocking or non-blocking type.
+*   \param sbuff     The contribution of this process.
+*   \param rbuff     The gathered arrays, which is resized suitably on the root. The container is not touched on the other processes. It 
+*                    must not be the send buffer.
+*   \param root      The rank of the process which receives the gathered arrays.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIGatherMode GMODE >
+void BaseComm<TYPE_T>::gather( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, int root, MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   const int size = static_cast< int >( sbuff.getSize() );
+   
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_GREQ( root, 0 );
+   SN_ASSERT_LESS_THAN( root, SN_MPI_SIZE() );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( size <= 0 || root < 0 || root >= SN_MPI_SIZE() || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Gather" );
+   }
+   #endif
+   
+   /* The root shall resize its container suitably */
+   if( SN_MPI_RANK() == root ) {
+      fitBuffer( rbuff, static_cast< large_t >( size ) * static_cast< large_t >( SN_MPI_SIZE() ) );
+   }
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the result is the contribution
+      copyLocal( sbuff, 0, rbuff, 0, static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( GMODE == MPIGatherMode::Immediate,
+                  [&]() { return MPI_Gather( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size, getMPIType< TYPE_T >(), root,
+                                           ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Igather( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size,
+                                                                getMPIType< TYPE_T >(), root, ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Gather_Error", "MPI_Igather_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( GMODE == MPIGatherMode::Standard ) ? LogEventType::MPIGather : LogEventType::MPIIgather, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ], " << std::to_string(root) );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. Every process contributes an array of any size, 
+*   and the root places the array of process i at the displacement displs[i] of the receive buffer. The counts and displacements are only
+*   significant on the root, where counts[i] must equal the size of the array of process i. They must stay untouched until a 
+*   non-blocking operation has been completed. On a single process, the send buffer is copied to the receive buffer. Notes on exception 
+*   safety: basic safety guaranteed. An InvalidArgument exception is thrown if the arguments are not suitable. An MPIError exception is 
+*   thrown if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam GMODE    Specifies if the gather operation is to be of blocking or non-blocking type.
+*   \param sbuff     The contribution of this process.
+*   \param rbuff     The gathered arrays, which is resized suitably on the root. The container is not touched on the other processes. It 
+*                    must not be the send buffer.
+*   \param counts    The sizes of the arrays of all processes, in the order of the ranks.
+*   \param displs    The displacements of the arrays of all processes in the receive buffer, in the order of the ranks.
+*   \param root      The rank of the process which receives the gathered arrays.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIGatherMode GMODE >
+void BaseComm<TYPE_T>::gatherv( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, const FastBuffer<int> & counts, 
+                                const FastBuffer<int> & displs, int root, MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   const int size = static_cast< int >( sbuff.getSize() );
+   
+   SN_ASSERT_GREQ( size, 0 );
+   SN_ASSERT_GREQ( root, 0 );
+   SN_ASSERT_LESS_THAN( root, SN_MPI_SIZE() );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( size < 0 || root < 0 || root >= SN_MPI_SIZE() || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Gatherv" );
+   }
+   #endif
+   
+   /* The root shall resize its container suitably */
+   if( SN_MPI_RANK() == root ) {
+      fitBuffer( rbuff, getExtent( counts, displs, static_cast< large_t >( SN_MPI_SIZE() ) ) );
+   }
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the result is the contribution
+      copyLocal( sbuff, 0, rbuff, static_cast< large_t >( displs[0] ), static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( GMODE == MPIGatherMode::Immediate,
+                  [&]() { return MPI_Gatherv( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, counts.data_, displs.data_,
+                                            getMPIType< TYPE_T >(), root, ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Igatherv( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, counts.data_,
+                                                                 displs.data_, getMPIType< TYPE_T >(), root,
+                                                                 ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Gatherv_Error", "MPI_Igatherv_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( GMODE == MPIGatherMode::Standard ) ? LogEventType::MPIGather : LogEventType::MPIIgather, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ], " << std::to_string(root) << " --v" );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. Every process contributes an array of the same 
+*   size, and every process receives all of them one after another in the order of the ranks. On a single process, the send buffer is 
+*   copied to the receive buffer. Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the 
+*   arguments are not suitable. An MPIError exception is thrown if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam GMODE    Specifies if the gather operation is to be of blocking or non-blocking type.
+*   \param sbuff     The contribution of this process.
+*   \param rbuff     The gathered arrays, which is resized suitably. It must not be the send buffer.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIGatherMode GMODE >
+void BaseComm<TYPE_T>::allgather( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   const int size = static_cast< int >( sbuff.getSize() );
+   
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( size <= 0 || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Allgather" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, static_cast< large_t >( size ) * static_cast< large_t >( SN_MPI_SIZE() ) );
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the result is the contribution
+      copyLocal( sbuff, 0, rbuff, 0, static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( GMODE == MPIGatherMode::Immediate,
+                  [&]() { return MPI_Allgather( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size, getMPIType< TYPE_T >(),
+                                              ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Iallgather( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size,
+                                                                   getMPIType< TYPE_T >(), ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Allgather_Error", "MPI_Iallgather_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( GMODE == MPIGatherMode::Standard ) ? LogEventType::MPIAllgather : LogEventType::MPIIallgather, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ]" );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. Every process contributes an array of any size, 
+*   and every process places the array of process i at the displacement displs[i] of the receive buffer. The counts and displacements must
+*   be the same on all processes, where counts[i] must equal the size of the array of process i. They must stay untouched until a 
+*   non-blocking operation has been completed. On a single process, the send buffer is copied to the receive buffer. Notes on exception 
+*   safety: basic safety guaranteed. An InvalidArgument exception is thrown if the arguments are not suitable. An MPIError exception is 
+*   thrown if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam GMODE    Specifies if the gather operation is to be of blocking or non-blocking type.
+*   \param sbuff     The contribution of this process.
+*   \param rbuff     The gathered arrays, which is resized suitably. It must not be the send buffer.
+*   \param counts    The sizes of the arrays of all processes, in the order of the ranks.
+*   \param displs    The displacements of the arrays of all processes in the receive buffer, in the order of the ranks.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIGatherMode GMODE >
+void BaseComm<TYPE_T>::allgatherv( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, const FastBuffer<int> & counts, 
+                                   const FastBuffer<int> & displs, MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   const int size = static_cast< int >( sbuff.getSize() );
+   
+   SN_ASSERT_GREQ( size, 0 );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( size < 0 || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Allgatherv" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, getExtent( counts, displs, static_cast< large_t >( SN_MPI_SIZE() ) ) );
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the result is the contribution
+      copyLocal( sbuff, 0, rbuff, static_cast< large_t >( displs[0] ), static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( GMODE == MPIGatherMode::Immediate,
+                  [&]() { return MPI_Allgatherv( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, counts.data_, displs.data_,
+                                               getMPIType< TYPE_T >(), ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Iallgatherv( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_,
+                                                                    counts.data_, displs.data_, getMPIType< TYPE_T >(),
+                                                                    ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Allgatherv_Error", "MPI_Iallgatherv_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( GMODE == MPIGatherMode::Standard ) ? LogEventType::MPIAllgather : LogEventType::MPIIallgather, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ] --v" );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. The root sends consecutive parts of the given size
+*   of its send buffer to the processes in the order of the ranks. The send buffer is only significant on the root. On a single process, 
+*   the first part of the send buffer is copied to the receive buffer. Notes on exception safety: basic safety guaranteed. An 
+*   InvalidArgument exception is thrown if the arguments are not suitable. An MPIError exception is thrown if the return code of the 
+*   operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam SCMODE   Specifies if the scatter operation is to be of blocking or non-blocking type.
+*   \param sbuff     The parts of all processes, which must hold at least size times the number of processes elements on the root.
+*   \param rbuff     The part of this process, which is resized suitably. It must not be the send buffer.
+*   \param size      The size of the part of every process.
+*   \param root      The rank of the process which scatters its send buffer.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIScatterMode SCMODE >
+void BaseComm<TYPE_T>::scatter( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, int size, int root, 
+                                MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_GREQ( root, 0 );
+   SN_ASSERT_LESS_THAN( root, SN_MPI_SIZE() );
+   SN_ASSERT( &sbuff != &rbuff );
+   SN_ASSERT( SN_MPI_RANK() != root || sbuff.getSize() >= static_cast< large_t >( size ) * static_cast< large_t >( SN_MPI_SIZE() ) );
+   
+   #ifdef NDEBUG
+   if( size <= 0 || root < 0 || root >= SN_MPI_SIZE() || &sbuff == &rbuff || 
+       ( SN_MPI_RANK() == root && sbuff.getSize() < static_cast< large_t >( size ) * static_cast< large_t >( SN_MPI_SIZE() ) ) ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Scatter" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, static_cast< large_t >( size ) );
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the part is the first one
+      copyLocal( sbuff, 0, rbuff, 0, static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( SCMODE == MPIScatterMode::Immediate,
+                  [&]() { return MPI_Scatter( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size, getMPIType< TYPE_T >(), root,
+                                            ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Iscatter( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size,
+                                                                 getMPIType< TYPE_T >(), root, ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Scatter_Error", "MPI_Iscatter_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( SCMODE == MPIScatterMode::Standard ) ? LogEventType::MPIScatter : LogEventType::MPIIscatter, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ], " << std::to_string(root) );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. The root sends the part of its send buffer at the 
+*   displacement displs[i] with the size counts[i] to the process i. The send buffer and the displacements are only significant on the 
+*   root, whereas the counts must be the same on all processes. They must stay untouched until a non-blocking operation has been 
+*   completed. On a single process, the first part of the send buffer is copied to the receive buffer. Notes on exception safety: basic 
+*   safety guaranteed. An InvalidArgument exception is thrown if the arguments are not suitable. An MPIError exception is thrown if the 
+*   return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam SCMODE   Specifies if the scatter operation is to be of blocking or non-blocking type.
+*   \param sbuff     The parts of all processes.
+*   \param rbuff     The part of this process, which is resized suitably. It must not be the send buffer.
+*   \param counts    The sizes of the parts of all processes, in the order of the ranks.
+*   \param displs    The displacements of the parts of all processes in the send buffer, in the order of the ranks.
+*   \param root      The rank of the process which scatters its send buffer.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIScatterMode SCMODE >
+void BaseComm<TYPE_T>::scatterv( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, const FastBuffer<int> & counts, 
+                                 const FastBuffer<int> & displs, int root, MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   SN_ASSERT_GREQ( root, 0 );
+   SN_ASSERT_LESS_THAN( root, SN_MPI_SIZE() );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( root < 0 || root >= SN_MPI_SIZE() || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Scatterv" );
+   }
+   #endif
+   
+   const large_t extent = getExtent( counts, displs, static_cast< large_t >( SN_MPI_SIZE() ) );
+   const int size = counts[ static_cast< large_t >( SN_MPI_RANK() ) ];
+   
+   SN_ASSERT_GREQ( size, 0 );
+   SN_ASSERT( SN_MPI_RANK() != root || sbuff.getSize() >= extent );
+   
+   #ifdef NDEBUG
+   if( size < 0 || ( SN_MPI_RANK() == root && sbuff.getSize() < extent ) ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Scatterv" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, static_cast< large_t >( size ) );
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the part is the first one
+      copyLocal( sbuff, static_cast< large_t >( displs[0] ), rbuff, 0, static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( SCMODE == MPIScatterMode::Immediate,
+                  [&]() { return MPI_Scatterv( sbuff.data_, counts.data_, displs.data_, getMPIType< TYPE_T >(), rbuff.data_, size,
+                                             getMPIType< TYPE_T >(), root, ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Iscatterv( sbuff.data_, counts.data_, displs.data_, getMPIType< TYPE_T >(),
+                                                                  rbuff.data_, size, getMPIType< TYPE_T >(), root,
+                                                                  ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Scatterv_Error", "MPI_Iscatterv_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( SCMODE == MPIScatterMode::Standard ) ? LogEventType::MPIScatter : LogEventType::MPIIscatter, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ], " << std::to_string(root) << " --v" );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. The send buffer holds one part of the given size 
+*   per process, one after another in the order of the ranks, and the part from every process is placed at the same position in the 
+*   receive buffer. On a single process, the first part of the send buffer is copied to the receive buffer. Notes on exception safety: 
+*   basic safety guaranteed. An InvalidArgument exception is thrown if the arguments are not suitable. An MPIError exception is thrown if 
+*   the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T   Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam AMODE    Specifies if the exchange is to be of blocking or non-blocking type.
+*   \param sbuff     The parts for all processes, which must hold at least size times the number of processes elements.
+*   \param rbuff     The parts from all processes, which is resized suitably. It must not be the send buffer.
+*   \param size      The size of the part for every process.
+*   \param mpiR      In case of non-blocking operation, this container will be given important information which must be reclaimed by the
+*                    corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIAlltoallMode AMODE >
+void BaseComm<TYPE_T>::alltoall( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, int size, MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   const large_t extent = static_cast< large_t >( size ) * static_cast< large_t >( SN_MPI_SIZE() );
+   
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_LEQ( extent, sbuff.getSize() );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( size <= 0 || extent > sbuff.getSize() || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Alltoall" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, extent );
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the part is the first one
+      copyLocal( sbuff, 0, rbuff, 0, static_cast< large_t >( size ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( AMODE == MPIAlltoallMode::Immediate,
+                  [&]() { return MPI_Alltoall( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size, getMPIType< TYPE_T >(),
+                                             ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Ialltoall( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size,
+                                                                  getMPIType< TYPE_T >(), ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Alltoall_Error", "MPI_Ialltoall_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( AMODE == MPIAlltoallMode::Standard ) ? LogEventType::MPIAlltoall : LogEventType::MPIIalltoall, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(size) << " ]" );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. The send buffer is packed with the parts for all 
+*   processes, where the part for the process i has the size send_counts[i] and begins at send_displs[i]. The part from the process i is 
+*   placed in the receive buffer at recv_displs[i], and its size must equal recv_counts[i]. All four arrays hold one entry per process in 
+*   the order of the ranks, and must stay untouched until a non-blocking operation has been completed. On a single process, the part for 
+*   this process is copied to the receive buffer. Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is 
+*   thrown if the arguments are not suitable. An MPIError exception is thrown if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T        Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam AMODE         Specifies if the exchange is to be of blocking or non-blocking type.
+*   \param sbuff          The packed parts for all processes.
+*   \param send_counts    The sizes of the parts for all processes.
+*   \param send_displs    The displacements of the parts for all processes in the send buffer.
+*   \param rbuff          The parts from all processes, which is resized suitably. It must not be the send buffer.
+*   \param recv_counts    The sizes of the parts from all processes.
+*   \param recv_displs    The displacements of the parts from all processes in the receive buffer.
+*   \param mpiR           In case of non-blocking operation, this container will be given important information which must be reclaimed 
+*                         by the corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPIAlltoallMode AMODE >
+void BaseComm<TYPE_T>::alltoallv( const FastBuffer<TYPE_T> & sbuff, const FastBuffer<int> & send_counts, 
+                                  const FastBuffer<int> & send_displs, FastBuffer<TYPE_T> & rbuff, 
+                                  const FastBuffer<int> & recv_counts, const FastBuffer<int> & recv_displs, 
+                                  MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   // Killing the -Wunused-parameter warnings in case of no MPI
+   (void)mpiR.getSize();
+   #endif   // MPI Guard
+   
+   const large_t send_extent = getExtent( send_counts, send_displs, static_cast< large_t >( SN_MPI_SIZE() ) );
+   const large_t recv_extent = getExtent( recv_counts, recv_displs, static_cast< large_t >( SN_MPI_SIZE() ) );
+   
+   SN_ASSERT_LEQ( send_extent, sbuff.getSize() );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( send_extent > sbuff.getSize() || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Alltoallv" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, recv_extent );
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running without MPI or with only 1 proc: the part is the one for this process
+      copyLocal( sbuff, static_cast< large_t >( send_displs[0] ), rbuff, static_cast< large_t >( recv_displs[0] ), 
+                 static_cast< large_t >( send_counts[0] ) );
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   /* Decision */
+   runCollective( AMODE == MPIAlltoallMode::Immediate,
+                  [&]() { return MPI_Alltoallv( sbuff.data_, send_counts.data_, send_displs.data_, getMPIType< TYPE_T >(), 
+                                              rbuff.data_, recv_counts.data_, recv_displs.data_, getMPIType< TYPE_T >(),
+                                              ProcSingleton::getThreadComm() ); },
+                  [&]( MPI_Request * req ) { return MPI_Ialltoallv( sbuff.data_, send_counts.data_, send_displs.data_, 
+                                                                   getMPIType< TYPE_T >(), rbuff.data_, recv_counts.data_, 
+                                                                   recv_displs.data_, getMPIType< TYPE_T >(),
+                                                                   ProcSingleton::getThreadComm(), req ); },
+                  mpiR, "MPI_Alltoallv_Error", "MPI_Ialltoallv_Error" );
+   
+   SN_LOG_REPORT_L1_EVENT( ( AMODE == MPIAlltoallMode::Standard ) ? LogEventType::MPIAlltoall : LogEventType::MPIIalltoall, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(send_extent) << " ] --v" );
+   
+   #endif   // MPI Guard
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Definitions of neighbourhood collective functions
+////////////////////////////////////////////////////////
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. The send buffer holds one part of the given size 
+*   per neighbour in the process topology, one after another in the order of the neighbours, and the part from every neighbour is placed 
+*   at the same position in the receive buffer. The neighbourhood topology (see ProcSingleton::getNeighbourComm) reaches all 26 blocks 
+*   which share a face, an edge or a corner, whereas the Cartesian topology (see ProcSingleton::getCartComm) reaches the 6 blocks which 
+*   share a face in the order -x, +x, -y, +y, -z, +z, with missing neighbours at the edges of the grid exchanging nothing. With the CMake 
+*   option SN_USE_MPI_THREAD_MULTIPLE, only one thread at a time may use a topology. On a single process, nothing is exchanged. Notes on 
+*   exception safety: basic safety guaranteed. A PreconditionError exception is thrown if the domains have not been set up, an 
+*   InvalidArgument exception if the arguments are not suitable and an MPIError exception if the return code of the operation is not 
+*   MPI_SUCCESS.
+*
+*   \tparam TYPE_T     Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam NMODE      Specifies if the exchange is to be of blocking or non-blocking type.
+*   \tparam TOPOLOGY   The process topology whose neighbours are exchanged with.
+*   \param sbuff       The parts for the neighbours, which must hold at least size times the number of neighbours elements.
+*   \param rbuff       The parts from the neighbours, which is resized suitably. It must not be the send buffer.
+*   \param size        The size of the part for every neighbour.
+*   \param mpiR        In case of non-blocking operation, this container will be given important information which must be reclaimed by
+*                      the corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPINeighbourMode NMODE, MPITopology TOPOLOGY >
+void BaseComm<TYPE_T>::neighbourAlltoall( const FastBuffer<TYPE_T> & sbuff, FastBuffer<TYPE_T> & rbuff, int size, 
+                                          MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)sbuff.getSize();
+   (void)rbuff.getSize();
+   (void)mpiR.getSize();
+   (void)size;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running with MPI but only 1 proc: there are no neighbours
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   int neighbour_count = 0;
+   const MPI_Comm comm = getTopologyComm( TOPOLOGY, neighbour_count );
+   const large_t extent = static_cast< large_t >( size ) * static_cast< large_t >( neighbour_count );
+   
+   SN_ASSERT_POSITIVE( size );
+   SN_ASSERT_LEQ( extent, sbuff.getSize() );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( size <= 0 || extent > sbuff.getSize() || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Neighbor_Alltoall" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, extent );
+   
+   int info = -1;
+   
+   if( NMODE == MPINeighbourMode::Immediate )
+      checkRequest( mpiR, "IA_MPI_Ineighbor_alltoall" );
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   /* Decision */
+   if( NMODE == MPINeighbourMode::Standard ) {
+      
+      info = MPI_Neighbor_alltoall( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size, getMPIType< TYPE_T >(), comm );
+      
+      // Run-time error checking
+      SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+      
+      #ifdef NDEBUG
+      if( info != MPI_SUCCESS ) {
+         SN_THROW_MPI_ERROR( "MPI_Neighbor_alltoall_Error" );
+      }
+      #endif
+      
+      SN_LOG_REPORT_L1_EVENT( LogEventType::MPINeighbourAlltoall, "[ " << DTInfo< TYPE_T >::mpi_name
+                                                                  << ", " << std::to_string(size) << " ], "
+                                                                  << std::to_string(neighbour_count) );
+   }
+   else if( NMODE == MPINeighbourMode::Immediate ) {
+      
+      mpiR.setTransferCount( 0 );   // The status of a collective operation carries no count.
+      
+      info = MPI_Ineighbor_alltoall( sbuff.data_, size, getMPIType< TYPE_T >(), rbuff.data_, size, getMPIType< TYPE_T >(), comm, 
+                                     mpiR );
+      
+      // Run-time error checking
+      SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+      
+      #ifdef NDEBUG
+      if( info != MPI_SUCCESS ) {
+         SN_THROW_MPI_ERROR( "MPI_Ineighbor_alltoall_Error" );
+      }
+      #endif
+      
+      SN_LOG_REPORT_L1_EVENT( LogEventType::MPIIneighbourAlltoall, "[ " << DTInfo< TYPE_T >::mpi_name
+                                                                   << ", " << std::to_string(size) << " ], "
+                                                                   << std::to_string(neighbour_count) );
+   }
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The container FastBuffer is used to provide pointer access to the underlying array. The send buffer is packed with the parts for all 
+*   neighbours in the process topology, where the part for the neighbour i has the size send_counts[i] and begins at send_displs[i]. The 
+*   part from the neighbour i is placed in the receive buffer at recv_displs[i], and its size must equal recv_counts[i]. All four arrays 
+*   hold one entry per neighbour in the order of the neighbours, and must stay untouched until a non-blocking operation has been 
+*   completed. The topologies are described in neighbourAlltoall. With the CMake option SN_USE_MPI_THREAD_MULTIPLE, only one thread at a 
+*   time may use a topology. On a single process, nothing is exchanged. Notes on exception safety: basic safety guaranteed. A 
+*   PreconditionError exception is thrown if the domains have not been set up, an InvalidArgument exception if the arguments are not 
+*   suitable and an MPIError exception if the return code of the operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T        Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam NMODE         Specifies if the exchange is to be of blocking or non-blocking type.
+*   \tparam TOPOLOGY      The process topology whose neighbours are exchanged with.
+*   \param sbuff          The packed parts for the neighbours.
+*   \param send_counts    The sizes of the parts for the neighbours.
+*   \param send_displs    The displacements of the parts for the neighbours in the send buffer.
+*   \param rbuff          The parts from the neighbours, which is resized suitably. It must not be the send buffer.
+*   \param recv_counts    The sizes of the parts from the neighbours.
+*   \param recv_displs    The displacements of the parts from the neighbours in the receive buffer.
+*   \param mpiR           In case of non-blocking operation, this container will be given important information which must be reclaimed 
+*                         by the corresponding wait function. In case of blocking operations, this parameter need not be specified.
+*/
+
+template< typename TYPE_T >
+template< MPINeighbourMode NMODE, MPITopology TOPOLOGY >
+void BaseComm<TYPE_T>::neighbourAlltoallv( const FastBuffer<TYPE_T> & sbuff, const FastBuffer<int> & send_counts, 
+                                           const FastBuffer<int> & send_displs, FastBuffer<TYPE_T> & rbuff, 
+                                           const FastBuffer<int> & recv_counts, const FastBuffer<int> & recv_displs, 
+                                           MPIRequest<TYPE_T> & mpiR ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)sbuff.getSize();
+   (void)send_counts.getSize();
+   (void)send_displs.getSize();
+   (void)rbuff.getSize();
+   (void)recv_counts.getSize();
+   (void)recv_displs.getSize();
+   (void)mpiR.getSize();
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running with MPI but only 1 proc: there are no neighbours
+      return;
+   }
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   int neighbour_count = 0;
+   const MPI_Comm comm = getTopologyComm( TOPOLOGY, neighbour_count );
+   const large_t send_extent = getExtent( send_counts, send_displs, static_cast< large_t >( neighbour_count ) );
+   const large_t recv_extent = getExtent( recv_counts, recv_displs, static_cast< large_t >( neighbour_count ) );
+   
+   SN_ASSERT_LEQ( send_extent, sbuff.getSize() );
+   SN_ASSERT( &sbuff != &rbuff );
+   
+   #ifdef NDEBUG
+   if( send_extent > sbuff.getSize() || &sbuff == &rbuff ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Neighbor_Alltoallv" );
+   }
+   #endif
+   
+   fitBuffer( rbuff, recv_extent );
+   
+   int info = -1;
+   
+   if( NMODE == MPINeighbourMode::Immediate )
+      checkRequest( mpiR, "IA_MPI_Ineighbor_alltoallv" );
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   /* Decision */
+   if( NMODE == MPINeighbourMode::Standard ) {
+      
+      info = MPI_Neighbor_alltoallv( sbuff.data_, send_counts.data_, send_displs.data_, getMPIType< TYPE_T >(), 
+                                     rbuff.data_, recv_counts.data_, recv_displs.data_, getMPIType< TYPE_T >(), comm );
+      
+      // Run-time error checking
+      SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+      
+      #ifdef NDEBUG
+      if( info != MPI_SUCCESS ) {
+         SN_THROW_MPI_ERROR( "MPI_Neighbor_alltoallv_Error" );
+      }
+      #endif
+      
+      SN_LOG_REPORT_L1_EVENT( LogEventType::MPINeighbourAlltoall, "[ " << DTInfo< TYPE_T >::mpi_name
+                                                                  << ", " << std::to_string(send_extent) << " ], "
+                                                                  << std::to_string(neighbour_count) << " --v" );
+   }
+   else if( NMODE == MPINeighbourMode::Immediate ) {
+      
+      mpiR.setTransferCount( 0 );   // The status of a collective operation carries no count.
+      
+      info = MPI_Ineighbor_alltoallv( sbuff.data_, send_counts.data_, send_displs.data_, getMPIType< TYPE_T >(), 
+                                      rbuff.data_, recv_counts.data_, recv_displs.data_, getMPIType< TYPE_T >(), comm, mpiR );
+      
+      // Run-time error checking
+      SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+      
+      #ifdef NDEBUG
+      if( info != MPI_SUCCESS ) {
+         SN_THROW_MPI_ERROR( "MPI_Ineighbor_alltoallv_Error" );
+      }
+      #endif
+      
+      SN_LOG_REPORT_L1_EVENT( LogEventType::MPIIneighbourAlltoall, "[ " << DTInfo< TYPE_T >::mpi_name
+                                                                   << ", " << std::to_string(send_extent) << " ], "
+                                                                   << std::to_string(neighbour_count) << " --v" );
+   }
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   #endif   // MPI Guard
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Definitions of region and index-list communication functions
+//////////////////////////////////////////////////////////////////
+
+/** The elements first, first + stride, ..., first + ( count - 1 ) * stride of the array are sent in place, e.g., a plane of a Field which 
+*   is laid out as a 3-dimensional grid. Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the 
+*   arguments are not logical. An MPIError exception is thrown if the return code of the MPI operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T         Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam SMODE          Specifies if the send operation is to be of blocking, synchronous or non-blocking type.
+*   \tparam ALLOC_POLICY   The allocation policy of the array.
+*   \param arr             The array (or Field) which contains the region.
+*   \param target          The rank of the receiving process.
+*   \param first           The index of the first element of the region.
+*   \param count           The number of elements in the region.
+*   \param stride          The distance between consecutive elements of the region.
+*   \param mpiR            In case of non-blocking send operation, this container will be given important information which must be 
+*                          reclaimed by the corresponding wait function.
+*   \param index           The position of the operation in the request container.
+*/
+template< typename TYPE_T >
+template< MPISendMode SMODE, class ALLOC_POLICY >
+void BaseComm<TYPE_T>::sendRegion( const DArray<TYPE_T, ALLOC_POLICY> & arr, int target, large_t first, int count, int stride, 
+                                   MPIRequest<TYPE_T> & mpiR, small_t index ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)arr.getSize();
+   (void)mpiR.getSize();
+   (void)target;
+   (void)first;
+   (void)count;
+   (void)stride;
+   (void)index;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {      // Running with MPI but only 1 proc
+      return;
+   }
+   
+   // Assertions
+   SN_ASSERT_INEQUAL( SN_MPI_RANK(), target );
+   SN_ASSERT_POSITIVE( count );
+   SN_ASSERT_POSITIVE( stride );
+   SN_ASSERT_LESS_THAN( first + static_cast< large_t >( count - 1 ) * static_cast< large_t >( stride ), arr.getSize() );
+   SN_ASSERT_GREQ( target, 0 );
+   SN_ASSERT_LESS_THAN( target, SN_MPI_SIZE() );
+   
+   #ifdef NDEBUG
+   if( target == SN_MPI_RANK() || count <= 0 || stride <= 0 || 
+       first + static_cast< large_t >( count - 1 ) * static_cast< large_t >( stride ) >= arr.getSize() || target < 0 || 
+       target >= SN_MPI_SIZE() ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Send_Region" );
+   }
+   #endif
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   MPI_Datatype layout = commitRegionType( count, stride );
+   sendLayout< SMODE >( arr.raw_ptr() + first, layout, count, target, mpiR, index );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The message is received in place into the elements first, first + stride, ..., first + ( count - 1 ) * stride of the array, which 
+*   must already hold them. The sender may have used a different layout, as long as it sent count elements. Notes on exception safety: 
+*   basic safety guaranteed. An InvalidArgument exception is thrown if the arguments are not logical. An MPIError exception is thrown if 
+*   the return code of the MPI operation is not MPI_SUCCESS or if the transfer count doesn't match (in case of blocking receive).
+*
+*   \tparam TYPE_T         Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam RMODE          Specifies if the receive operation is to be of blocking or non-blocking type.
+*   \tparam ALLOC_POLICY   The allocation policy of the array.
+*   \param arr             The array (or Field) which contains the region.
+*   \param source          The rank of the sending process.
+*   \param first           The index of the first element of the region.
+*   \param count           The number of elements in the region.
+*   \param stride          The distance between consecutive elements of the region.
+*   \param mpiR            In case of non-blocking receive operation, this container will be given important information which must be 
+*                          reclaimed by the corresponding wait function.
+*   \param index           The position of the operation in the request container.
+*/
+template< typename TYPE_T >
+template< MPIRecvMode RMODE, class ALLOC_POLICY >
+void BaseComm<TYPE_T>::receiveRegion( DArray<TYPE_T, ALLOC_POLICY> & arr, int source, large_t first, int count, int stride, 
+                                      MPIRequest<TYPE_T> & mpiR, small_t index ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)arr.getSize();
+   (void)mpiR.getSize();
+   (void)source;
+   (void)first;
+   (void)count;
+   (void)stride;
+   (void)index;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running with MPI but only 1 proc
+      return;
+   }
+   
+   SN_ASSERT_INEQUAL( SN_MPI_RANK(), source );
+   SN_ASSERT_POSITIVE( count );
+   SN_ASSERT_POSITIVE( stride );
+   SN_ASSERT_LESS_THAN( first + static_cast< large_t >( count - 1 ) * static_cast< large_t >( stride ), arr.getSize() );
+   SN_ASSERT_GREQ( source, 0 );
+   SN_ASSERT_LESS_THAN( source, SN_MPI_SIZE() );
+   
+   #ifdef NDEBUG
+   if( source == SN_MPI_RANK() || count <= 0 || stride <= 0 || 
+       first + static_cast< large_t >( count - 1 ) * static_cast< large_t >( stride ) >= arr.getSize() || source < 0 || 
+       source >= SN_MPI_SIZE() ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Recv_Region" );
+   }
+   #endif
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   MPI_Datatype layout = commitRegionType( count, stride );
+   receiveLayout< RMODE >( arr.raw_ptr() + first, layout, count, source, mpiR, index );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The elements of the array at the given indices are sent in place and in the order of the list, e.g., the objects which are to be 
+*   migrated to a neighbouring process. Notes on exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the 
+*   arguments are not logical. An MPIError exception is thrown if the return code of the MPI operation is not MPI_SUCCESS.
+*
+*   \tparam TYPE_T         Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam SMODE          Specifies if the send operation is to be of blocking, synchronous or non-blocking type.
+*   \tparam ALLOC_POLICY   The allocation policy of the array.
+*   \param arr             The array (or Field) which contains the elements.
+*   \param target          The rank of the receiving process.
+*   \param indices         The indices of the elements which make up the message.
+*   \param mpiR            In case of non-blocking send operation, this container will be given important information which must be 
+*                          reclaimed by the corresponding wait function.
+*   \param index           The position of the operation in the request container.
+*/
+template< typename TYPE_T >
+template< MPISendMode SMODE, class ALLOC_POLICY >
+void BaseComm<TYPE_T>::sendIndexed( const DArray<TYPE_T, ALLOC_POLICY> & arr, int target, const FastBuffer<int> & indices, 
+                                    MPIRequest<TYPE_T> & mpiR, small_t index ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)arr.getSize();
+   (void)indices.getSize();
+   (void)mpiR.getSize();
+   (void)target;
+   (void)index;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {      // Running with MPI but only 1 proc
+      return;
+   }
+   
+   // Assertions
+   SN_ASSERT_INEQUAL( SN_MPI_RANK(), target );
+   SN_ASSERT_POSITIVE( indices.getSize() );
+   SN_ASSERT_GREQ( target, 0 );
+   SN_ASSERT_LESS_THAN( target, SN_MPI_SIZE() );
+   
+   #ifdef NDEBUG
+   if( target == SN_MPI_RANK() || indices.getSize() == 0 || target < 0 || target >= SN_MPI_SIZE() ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Send_Indexed" );
+   }
+   #endif
+   
+   checkIndices( indices, arr.getSize() );
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   MPI_Datatype layout = commitIndexedType( indices );
+   sendLayout< SMODE >( arr.raw_ptr(), layout, static_cast< int >( indices.getSize() ), target, mpiR, index );
+   
+   #endif   // MPI Guard
+}
+
+
+
+/** The message is received in place into the elements of the array at the given indices, in the order of the list. The sender may 
+*   have used a different layout, as long as it sent as many elements. Notes on exception safety: basic safety guaranteed. An 
+*   InvalidArgument exception is thrown if the arguments are not logical. An MPIError exception is thrown if the return code of the MPI 
+*   operation is not MPI_SUCCESS or if the transfer count doesn't match (in case of blocking receive).
+*
+*   \tparam TYPE_T         Datatype of the array, which must be basic or otherwise described by DTInfo (see is_described).
+*   \tparam RMODE          Specifies if the receive operation is to be of blocking or non-blocking type.
+*   \tparam ALLOC_POLICY   The allocation policy of the array.
+*   \param arr             The array (or Field) which contains the elements.
+*   \param source          The rank of the sending process.
+*   \param indices         The indices of the elements which receive the message.
+*   \param mpiR            In case of non-blocking receive operation, this container will be given important information which must be 
+*                          reclaimed by the corresponding wait function.
+*   \param index           The position of the operation in the request container.
+*/
+template< typename TYPE_T >
+template< MPIRecvMode RMODE, class ALLOC_POLICY >
+void BaseComm<TYPE_T>::receiveIndexed( DArray<TYPE_T, ALLOC_POLICY> & arr, int source, const FastBuffer<int> & indices, 
+                                       MPIRequest<TYPE_T> & mpiR, small_t index ) {
+   
+   SN_CT_REQUIRE< is_described<TYPE_T>::value >();   // Free template input prerequires a Türsteher.
+   
+   #ifndef __SN_USE_MPI__
+   return;               // Speedy return prevents adding an if conditional to serial overhead
+   
+   // Killing the -Wunused-parameter warnings in case of no MPI and release mode
+   (void)arr.getSize();
+   (void)indices.getSize();
+   (void)mpiR.getSize();
+   (void)source;
+   (void)index;
+   
+   #endif   // MPI Guard
+   
+   if( ! SN_MPI_INITIALIZED() || SN_MPI_SIZE() == 1 ) {   // Running with MPI but only 1 proc
+      return;
+   }
+   
+   SN_ASSERT_INEQUAL( SN_MPI_RANK(), source );
+   SN_ASSERT_POSITIVE( indices.getSize() );
+   SN_ASSERT_GREQ( source, 0 );
+   SN_ASSERT_LESS_THAN( source, SN_MPI_SIZE() );
+   
+   #ifdef NDEBUG
+   if( source == SN_MPI_RANK() || indices.getSize() == 0 || source < 0 || source >= SN_MPI_SIZE() ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Recv_Indexed" );
+   }
+   #endif
+   
+   checkIndices( indices, arr.getSize() );
+   
+   
+   #ifdef __SN_USE_MPI__
+   
+   MPI_Datatype layout = commitIndexedType( indices );
+   receiveLayout< RMODE >( arr.raw_ptr(), layout, static_cast< int >( indices.getSize() ), source, mpiR, index );
+   
+   #endif   // MPI Guard
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Definitions of helper functions
+/////////////////////////////////////
+
+/** A temporary cannot be bound to the request parameter of the communication functions, hence blocking operations are given this 
+*   container instead. It is shared by all callers, hence non-blocking operations reject it (see checkRequest). Notes on exception 
+*   safety: strong safety guaranteed. An AllocError exception is thrown if the resource allocation were not possible.
+*
+*   \return   The request container for blocking operations.
+*/
+template< typename TYPE_T >
+MPIRequest<TYPE_T> & BaseComm<TYPE_T>::noRequest() {
+   
+   static MPIRequest<TYPE_T> unused;
+   return unused;
+}
+
+
+/** The buffer is only reallocated if its size differs from the required one, so that repeated collective operations with the same sizes 
+*   do not allocate. An empty message leaves the buffer untouched. Notes on exception safety: strong safety guaranteed. An AllocError 
+*   exception is thrown if the resource allocation were not possible.
+*
+*   \param buff   The buffer to be fitted.
+*   \param size   The required size.
+*/
+template< typename TYPE_T >
+void BaseComm<TYPE_T>::fitBuffer( FastBuffer<TYPE_T> & buff, large_t size ) {
+   
+   if( size != 0 && buff.getSize() != size )
+      buff.resize( size );
+}
+
+
+/** Notes on exception safety: nothrow guarantee. Nothing is copied if source and destination are the same part of the same buffer.
+*
+*   \param src           The buffer from which is copied.
+*   \param src_offset    The index of the first element to be copied.
+*   \param dest          The buffer to which is copied.
+*   \param dest_offset   The index in the destination buffer at which the first element is placed.
+*   \param count         The number of elements to be copied.
+*/
+template< typename TYPE_T >
+void BaseComm<TYPE_T>::copyLocal( const FastBuffer<TYPE_T> & src, large_t src_offset, FastBuffer<TYPE_T> & dest, large_t dest_offset, 
+                                  large_t count ) {
+   
+   if( &src == &dest && src_offset == dest_offset )
+      return;
+   
+   SN_ASSERT_LEQ( src_offset + count, src.getSize() );
+   SN_ASSERT_LEQ( dest_offset + count, dest.getSize() );
+   
+   std::copy( src.data_.raw_ptr() + src_offset, src.data_.raw_ptr() + src_offset + count, dest.data_.raw_ptr() + dest_offset );
+}
+
+
+/** Notes on exception safety: strong safety guaranteed. An InvalidArgument exception is thrown if there are not as many counts and 
+*   displacements as parts, or if any of them is negative.
+*
+*   \param counts   The sizes of all parts, e.g., in the order of the ranks.
+*   \param displs   The displacements of all parts, e.g., in the order of the ranks.
+*   \param parts    The number of parts, e.g., the number of processes.
+*   \return         The size of the buffer which holds all parts.
+*/
+template< typename TYPE_T >
+large_t BaseComm<TYPE_T>::getExtent( const FastBuffer<int> & counts, const FastBuffer<int> & displs, large_t parts ) {
+   
+   SN_ASSERT_EQUAL( counts.getSize(), parts );
+   SN_ASSERT_EQUAL( displs.getSize(), parts );
+   
+   #ifdef NDEBUG
+   if( counts.getSize() != parts || displs.getSize() != parts ) {
+      SN_THROW_INVALID_ARGUMENT( "IA_MPI_Counts_Displacements" );
+   }
+   #endif
+   
+   large_t extent = 0;
+   for( large_t i = 0; i < parts; ++i ) {
+      
+      SN_ASSERT( counts[i] >= 0 && displs[i] >= 0 );
+      
+      #ifdef NDEBUG
+      if( counts[i] < 0 || displs[i] < 0 ) {
+         SN_THROW_INVALID_ARGUMENT( "IA_MPI_Counts_Displacements" );
+      }
+      #endif
+      
+      extent = std::max( extent, static_cast< large_t >( displs[i] ) + static_cast< large_t >( counts[i] ) );
+   }
+   
+   return extent;
+}
+
+
+/** A non-blocking operation which were given the default container of noRequest would leave its handle there, where it is never 
+*   waited for and where it is overwritten by the next one, possibly of another thread. Notes on exception safety: strong safety 
+*   guaranteed. An InvalidArgument exception is thrown if the container is the one of noRequest.
+*
+*   \param mpiR    The request container of the non-blocking operation.
+*   \param error   The message of the exception.
+*/
+template< typename TYPE_T >
+void BaseComm<TYPE_T>::checkRequest( const MPIRequest<TYPE_T> & mpiR, const char * error ) {
+   
+   SN_ASSERT( &mpiR != &noRequest() );
+   
+   #ifdef NDEBUG
+   if( &mpiR == &noRequest() ) {
+      SN_THROW_INVALID_ARGUMENT( error );
+   }
+   #else
+   (void)error;
+   #endif
+}
+
+
+/** Notes on exception safety: strong safety guaranteed. An InvalidArgument exception is thrown if any of the indices lies outside the 
+*   array.
+*
+*   \param indices   The list of indices.
+*   \param size      The size of the array.
+*/
+template< typename TYPE_T >
+void BaseComm<TYPE_T>::checkIndices( const FastBuffer<int> & indices, large_t size ) {
+   
+   for( large_t i = 0; i < indices.getSize(); ++i ) {
+      
+      SN_ASSERT( indices[i] >= 0 && static_cast< large_t >( indices[i] ) < size );
+      
+      #ifdef NDEBUG
+      if( indices[i] < 0 || static_cast< large_t >( indices[i] ) >= size ) {
+         SN_THROW_INVALID_ARGUMENT( "IA_MPI_Indices" );
+      }
+      #endif
+   }
+}
+
+
+#ifdef __SN_USE_MPI__
+/** Notes on exception safety: nothrow guarantee.
+*
+*   \param op   The reduction operation.
+*   \return     The corresponding MPI operation.
+*/
+template< typename TYPE_T >
+MPI_Op BaseComm<TYPE_T>::getMPIOp( MPIReduceOp op ) {
+   
+   switch( op ) {
+      case MPIReduceOp::Sum:          return MPI_SUM;
+      case MPIReduceOp::Prod:         return MPI_PROD;
+      case MPIReduceOp::Min:          return MPI_MIN;
+      case MPIReduceOp::Max:          return MPI_MAX;
+      case MPIReduceOp::LogicalAnd:   return MPI_LAND;
+      case MPIReduceOp::LogicalOr:    return MPI_LOR;
+   }
+   
+   return MPI_OP_NULL;
+}
+#endif   // MPI Guard
+
+
+#ifdef __SN_USE_MPI__
+/** Notes on exception safety: strong safety guaranteed. A PreconditionError exception is thrown if the communicator of the topology has
+*   not been created (see Simulator::setupDomains), and an MPIError exception if its neighbours could not be counted.
+*
+*   \param topology          The process topology.
+*   \param neighbour_count   The number of neighbours of this process in the topology.
+*   \return                  The communicator of the topology.
+*/
+template< typename TYPE_T >
+MPI_Comm BaseComm<TYPE_T>::getTopologyComm( MPITopology topology, int & neighbour_count ) {
+   
+   const MPI_Comm comm = ( topology == MPITopology::Cartesian ) ? ProcSingleton::getCartComm() : ProcSingleton::getNeighbourComm();
+   
+   SN_ASSERT( comm != MPI_COMM_NULL );
+   
+   #ifdef NDEBUG
+   if( comm == MPI_COMM_NULL ) {
+      SN_THROW_PRECONDITION_ERROR( "PREC_MPI_Topology_Error" );
+   }
+   #endif
+   
+   int info = -1;
+   
+   if( topology == MPITopology::Cartesian ) {
+      
+      int dims = 0;
+      info = MPI_Cartdim_get( comm, &dims );
+      neighbour_count = 2 * dims;
+   }
+   else {
+      
+      int outdegree = 0, weighted = 0;
+      info = MPI_Dist_graph_neighbors_count( comm, &neighbour_count, &outdegree, &weighted );
+   }
+   
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Topology_Error" );
+   }
+   
+   return comm;
+}
+#endif   // MPI Guard
+
+
+#ifdef __SN_USE_MPI__
+/** A stride of 1 results in a contiguous datatype. Notes on exception safety: strong safety guaranteed. An MPIError exception is thrown
+*   if the datatype could not be committed.
+*
+*   \param count    The number of elements in the region.
+*   \param stride   The distance between consecutive elements of the region.
+*   \return         The committed datatype, which must be freed by the caller.
+*/
+template< typename TYPE_T >
+MPI_Datatype BaseComm<TYPE_T>::commitRegionType( int count, int stride ) {
+   
+   MPI_Datatype layout = MPI_DATATYPE_NULL;
+   int info = -1;
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   if( stride == 1 )
+      info = MPI_Type_contiguous( count, getMPIType< TYPE_T >(), &layout );
+   else
+      info = MPI_Type_vector( count, 1, stride, getMPIType< TYPE_T >(), &layout );
+   
+   if( info == MPI_SUCCESS )
+      info = MPI_Type_commit( &layout );
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Type_Region_Error" );
+   }
+   
+   return layout;
+}
+#endif   // MPI Guard
+
+
+#ifdef __SN_USE_MPI__
+/** Notes on exception safety: strong safety guaranteed. An MPIError exception is thrown if the datatype could not be committed.
+*
+*   \param indices   The indices of the elements.
+*   \return          The committed datatype, which must be freed by the caller.
+*/
+template< typename TYPE_T >
+MPI_Datatype BaseComm<TYPE_T>::commitIndexedType( const FastBuffer<int> & indices ) {
+   
+   MPI_Datatype layout = MPI_DATATYPE_NULL;
+   int info = -1;
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   info = MPI_Type_create_indexed_block( static_cast< int >( indices.getSize() ), 1, indices.data_.raw_ptr(), getMPIType< TYPE_T >(), 
+                                         &layout );
+   
+   if( info == MPI_SUCCESS )
+      info = MPI_Type_commit( &layout );
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Type_Indexed_Error" );
+   }
+   
+   return layout;
+}
+#endif   // MPI Guard
+
+
+#ifdef __SN_USE_MPI__
+/** Every collective operation comes as a pair of a blocking and a non-blocking MPI function, which take the same arguments apart from 
+*   the request of the latter. The call is serialized as in every other communication function. Notes on exception safety: basic safety 
+*   guaranteed. An InvalidArgument exception is thrown if the non-blocking variant is not given a request container of its own, and an 
+*   MPIError exception if the return code of the MPI operation is not MPI_SUCCESS.
+*
+*   \param immediate        Whether the non-blocking variant is to be started.
+*   \param standardCall     The blocking MPI call, which returns the MPI return code.
+*   \param immediateCall    The non-blocking MPI call, which is given the request to be filled in and returns the MPI return code.
+*   \param mpiR             The request container of a non-blocking operation.
+*   \param standardError    The message of the exception in case the blocking call fails.
+*   \param immediateError   The message of the exception in case the non-blocking call fails.
+*/
+template< typename TYPE_T >
+template< typename STANDARD_CALL, typename IMMEDIATE_CALL >
+void BaseComm<TYPE_T>::runCollective( bool immediate, STANDARD_CALL standardCall, IMMEDIATE_CALL immediateCall, 
+                                      MPIRequest<TYPE_T> & mpiR, const char * standardError, const char * immediateError ) {
+   
+   if( immediate )
+      checkRequest( mpiR, immediateError );
+   
+   int info = -1;
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   if( immediate ) {
+      mpiR.setTransferCount( 0 );   // The status of a collective operation carries no count.
+      info = immediateCall( mpiR );
+   }
+   else {
+      info = standardCall();
+   }
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   // Run-time error checking
+   SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+   
+   #ifdef NDEBUG
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( immediate ? immediateError : standardError );
+   }
+   #else
+   (void)standardError;
+   (void)immediateError;
+   #endif
+}
+#endif   // MPI Guard
+
+
+#ifdef __SN_USE_MPI__
+/** The layout datatype may be released as soon as the operation has been started, since MPI defers its deallocation until pending 
+*   operations have completed. Notes on exception safety: basic safety guaranteed. An MPIError exception is thrown if the return code 
+*   of the MPI operation is not MPI_SUCCESS.
+*
+*   \tparam SMODE   Specifies if the send operation is to be of blocking, synchronous or non-blocking type.
+*   \param data     The address to which the layout is relative.
+*   \param layout   The committed layout datatype, which is freed.
+*   \param count    The number of elements described by the layout (for logging purposes).
+*   \param target   The rank of the receiving process.
+*   \param mpiR     The request container of a non-blocking send.
+*   \param index    The position of the operation in the request container.
+*/
+template< typename TYPE_T >
+template< MPISendMode SMODE >
+void BaseComm<TYPE_T>::sendLayout( const TYPE_T * data, MPI_Datatype & layout, int count, int target, MPIRequest<TYPE_T> & mpiR, 
+                                   small_t index ) {
+   
+   int tag = SN_MPI_RANK() + target;
+   int info = -1;
+   
+   if( SMODE == MPISendMode::Immediate )
+      checkRequest( mpiR, "IA_MPI_Isend" );
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   // Decision: the if-conditionals are evaluated at compile time.
+   if( SMODE == MPISendMode::Standard ) {
+      info = MPI_Send( data, 1, layout, target, tag, ProcSingleton::getThreadComm() );
+   }
+   else if( SMODE == MPISendMode::Synchronous ) {
+      info = MPI_Ssend( data, 1, layout, target, tag, ProcSingleton::getThreadComm() );
+   }
+   else if( SMODE == MPISendMode::Immediate ) {
+      
+      SN_ASSERT_INDEX_WITHIN_SIZE( index, mpiR.getSize() );
+      
+      mpiR.setTransferCount( 0, index );   // The status of a send carries no count.
+      info = MPI_Isend( data, 1, layout, target, tag, ProcSingleton::getThreadComm(), mpiR.raw_ptr() + index );
+   }
+   
+   MPI_Type_free( &layout );
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   // Run-time error checking
+   SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+   
+   #ifdef NDEBUG
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Send_Layout_Error" );
+   }
+   #endif
+   
+   SN_LOG_REPORT_L1_EVENT( ( SMODE == MPISendMode::Standard ) ? LogEventType::MPISend : 
+                           ( SMODE == MPISendMode::Synchronous ) ? LogEventType::MPISsend : LogEventType::MPIIsend, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(count) << " in place ], " 
+                           << std::to_string(SN_MPI_RANK()) << ", " << std::to_string(target) << " --tag" << std::to_string( tag ) );
+}
+#endif   // MPI Guard
+
+
+#ifdef __SN_USE_MPI__
+/** The layout datatype may be released as soon as the operation has been started, since MPI defers its deallocation until pending 
+*   operations have completed. The transfer count is counted in elements of TYPE_T, so that it is independent of the layouts on either 
+*   side. Notes on exception safety: basic safety guaranteed. An MPIError exception is thrown if the return code of the MPI operation is 
+*   not MPI_SUCCESS or if the transfer count doesn't match (in case of blocking receive).
+*
+*   \tparam RMODE   Specifies if the receive operation is to be of blocking or non-blocking type.
+*   \param data     The address to which the layout is relative.
+*   \param layout   The committed layout datatype, which is freed.
+*   \param count    The number of elements described by the layout.
+*   \param source   The rank of the sending process.
+*   \param mpiR     The request container of a non-blocking receive.
+*   \param index    The position of the operation in the request container.
+*/
+template< typename TYPE_T >
+template< MPIRecvMode RMODE >
+void BaseComm<TYPE_T>::receiveLayout( TYPE_T * data, MPI_Datatype & layout, int count, int source, MPIRequest<TYPE_T> & mpiR, 
+                                      small_t index ) {
+   
+   int info = -1;
+   int received = count;
+   
+   MPI_Status stat;
+   
+   if( RMODE == MPIRecvMode::Immediate )
+      checkRequest( mpiR, "IA_MPI_Irecv" );
+   
+   /* Thread safety is important */
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   static std::mutex mt;
+   std::lock_guard< std::mutex > lguard( mt );
+   #endif
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   OMP_CRITICAL_REGION()
+   {
+   #endif
+   
+   // Decision: the if conditionals are evaluated at compile time
+   if( RMODE == MPIRecvMode::Standard ) {
+      
+      info = MPI_Recv( data, 1, layout, source, MPI_ANY_TAG, ProcSingleton::getThreadComm(), &stat );
+      
+      if( info == MPI_SUCCESS )
+         MPI_Get_count( &stat, getMPIType< TYPE_T >(), &received );
+   }
+   else if( RMODE == MPIRecvMode::Immediate ) {
+      
+      SN_ASSERT_INDEX_WITHIN_SIZE( index, mpiR.getSize() );
+      
+      mpiR.setTransferCount( count, index );
+      info = MPI_Irecv( data, 1, layout, source, MPI_ANY_TAG, ProcSingleton::getThreadComm(), mpiR.raw_ptr() + index );
+   }
+   
+   MPI_Type_free( &layout );
+   
+   #if defined( __SN_USE_OPENMP__ ) && ! defined( __SN_USE_MPI_THREAD_MULTIPLE__ )
+   }                          // Closing up the critical region
+   #endif
+   
+   // Run-time error checking
+   SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+   SN_ASSERT_EQUAL( received, count );
+   
+   #ifdef NDEBUG
+   if( info != MPI_SUCCESS ) {
+      SN_THROW_MPI_ERROR( "MPI_Recv_Layout_Error" );
+   }
+   if( received != count ) {
+      SN_THROW_MPI_ERROR( "MPI_Recv_Count_Error" );
+   }
+   #endif
+   
+   SN_LOG_REPORT_L1_EVENT( ( RMODE == MPIRecvMode::Standard ) ? LogEventType::MPIRecv : LogEventType::MPIIrecv, 
+                           "[ " << DTInfo< TYPE_T >::mpi_name << ", " << std::to_string(count) << " in place ], " 
+                           << std::to_string(source) << ", " << std::to_string(SN_MPI_RANK()) );
+}
+#endif   // MPI Guard
+
+
 }   // namespace simpleNewton
 
 #endif   // Header guard
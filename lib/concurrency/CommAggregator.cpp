@@ -0,0 +1,35 @@
+#include "CommAggregator.hpp"
+
+#include <containers/Vector3.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the explicit instantiations of the class template CommAggregator with the floating point types and Vector3.
+///   \file
+///   \addtogroup mpi MPI
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace simpleNewton {
+
+template class CommAggregator< real_t >;
+template class CommAggregator< single_t >;
+template class CommAggregator< Vector3< real_t > >;
+
+}   // namespace simpleNewton
+#endif
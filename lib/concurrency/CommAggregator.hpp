@@ -0,0 +1,355 @@
+#ifndef SN_COMMAGGREGATOR_HPP
+#define SN_COMMAGGREGATOR_HPP
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#if defined( __SN_USE_STL_MULTITHREADING__ ) || defined( __SN_USE_OPENMP__ )
+   #include <mutex>
+#endif
+
+#include <Types.hpp>
+#include <BasicBases.hpp>
+#include <types/DTInfo.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/ProcSingleton.hpp>
+#include <core/ProcTimer.hpp>
+#include <core/Exceptions.hpp>
+
+#include <containers/mpi/FastBuffer.hpp>
+#include <containers/mpi/MPIRequest.hpp>
+
+#include <logger/Logger.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class template CommAggregator, which gathers many small records addressed to other processes into one message per
+///   process.
+///   \file
+///   \addtogroup mpi MPI
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class collects small records, e.g., migrating objects or remote force contributions, which are addressed to other processes,
+*   and transfers them with a single message per destination, so that the overhead of a message is paid once per process instead of once
+*   per record.
+*
+*   Records may be enqueued by any thread at any time. They are appended to a FastBuffer per destination, which is guarded by a lock of
+*   its own and grows geometrically, so that nothing is allocated once the traffic has settled. At a synchronization point, flush sends
+*   every non-empty buffer by one non-blocking send. The number of messages which every process is to receive is determined by a single
+*   MPI_Reduce_scatter_block, and the messages themselves are picked up in the order of their arrival by matched probes
+*   (MPI_Mprobe/MPI_Mrecv). The received records are then available per source until the next flush. Records which a process addresses to
+*   itself are handed over without communication.
+*
+*   The aggregator communicates on a duplicate of MPI_COMM_WORLD, so that its messages never meet those of BaseComm. Hence it must be
+*   constructed by all processes, after ProcSingleton has been initialized.
+*
+*   \tparam RECORD_T   The type of the records, which must be basic or otherwise described by DTInfo (see is_described).
+*/
+//==========================================================================================================================================
+
+template< typename RECORD_T >
+class CommAggregator : private NonCopyable {
+
+public:
+
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Direct initialization constructor. It must be called by all processes. Notes on exception safety: strong safety guaranteed. The
+   *   function throws an AllocError exception if the required resource allocation were not possible and an MPIError exception if the
+   *   communicator could not be duplicated.
+   *
+   *   \param capacity   The initial number of records which every destination can hold.
+   */
+   explicit CommAggregator( small_t capacity = 64 ) : procs_( small_cast( SN_MPI_SIZE() ) ), send_requests_( procs_ ) {
+
+      SN_CT_REQUIRE< is_described<RECORD_T>::value >();   // Free template input prerequires a Türsteher.
+
+      try {
+         send_buffers_.reserve( procs_ );
+         recv_buffers_.reserve( procs_ );
+
+         for( small_t r = 0; r < procs_; ++r ) {
+
+            send_buffers_.emplace_back( std::max( capacity, small_cast( 1 ) ) );
+            recv_buffers_.emplace_back( small_t( 1 ) );
+         }
+
+         send_sizes_.assign( procs_, 0 );
+         recv_sizes_.assign( procs_, 0 );
+         flags_.assign( procs_, 0 );
+
+         #if defined( __SN_USE_STL_MULTITHREADING__ ) || defined( __SN_USE_OPENMP__ )
+         locks_ = std::vector< std::mutex >( procs_ );
+         #endif
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+
+      #ifdef __SN_USE_MPI__
+      if( SN_MPI_INITIALIZED() && MPI_Comm_dup( MPI_COMM_WORLD, &comm_ ) != MPI_SUCCESS ) {
+         SN_THROW_MPI_ERROR( "MPI_Aggregator_Comm_Error" );
+      }
+      #endif
+   }
+
+   /** Destructor, which frees the communicator. */
+   ~CommAggregator() {
+
+      #ifdef __SN_USE_MPI__
+      int finalized = 0;
+      MPI_Finalized( &finalized );
+
+      if( comm_ != MPI_COMM_NULL && ! finalized )
+         MPI_Comm_free( &comm_ );
+      #endif
+   }
+
+   /** @} */
+
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the number of records which are waiting to be sent to a process.
+   *
+   *   \param rank   The rank of the destination.
+   *   \return       The number of records.
+   */
+   inline large_t getQueuedCount( int rank ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( rank, procs_ );
+      return send_sizes_[ small_cast( rank ) ];
+   }
+
+   /** A function to obtain the number of records which were received from a process at the last flush.
+   *
+   *   \param rank   The rank of the source.
+   *   \return       The number of records.
+   */
+   inline large_t getReceivedCount( int rank ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( rank, procs_ );
+      return recv_sizes_[ small_cast( rank ) ];
+   }
+
+   /** A function to obtain the records which were received from a process at the last flush. They remain valid until the next flush.
+   *
+   *   \param rank   The rank of the source.
+   *   \return       A pointer to the first of getReceivedCount( rank ) records.
+   */
+   inline const RECORD_T * getReceived( int rank ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( rank, procs_ );
+      return recv_buffers_[ small_cast( rank ) ].raw_ptr();
+   }
+
+   /** @} */
+
+   /** \name Primary functionality
+   *   @{
+   */
+   /** A function to enqueue a record for a process. It may be called by any thread. Notes on exception safety: strong safety guaranteed.
+   *   An InvalidArgument exception is thrown if the rank is not valid and an AllocError exception if the required resource allocation
+   *   were not possible.
+   *
+   *   \param rank     The rank of the destination.
+   *   \param record   The record.
+   */
+   void enqueue( int rank, const RECORD_T & record ) {
+
+      enqueue( rank, &record, 1 );
+   }
+
+   /** A function to enqueue several records for a process at once. It may be called by any thread. Notes on exception safety: strong
+   *   safety guaranteed. An InvalidArgument exception is thrown if the rank is not valid and an AllocError exception if the required
+   *   resource allocation were not possible.
+   *
+   *   \param rank      The rank of the destination.
+   *   \param records   A pointer to the first record.
+   *   \param count     The number of records.
+   */
+   void enqueue( int rank, const RECORD_T * records, large_t count ) {
+
+      SN_ASSERT_GREQ( rank, 0 );
+      SN_ASSERT_LESS_THAN( rank, int( procs_ ) );
+
+      #ifdef NDEBUG
+      if( rank < 0 || rank >= int( procs_ ) ) {
+         SN_THROW_INVALID_ARGUMENT( "IA_CommAggregator_Rank" );
+      }
+      #endif
+
+      const small_t r = small_cast( rank );
+
+      /* Thread safety is important */
+      #if defined( __SN_USE_STL_MULTITHREADING__ ) || defined( __SN_USE_OPENMP__ )
+      std::lock_guard< std::mutex > lguard( locks_[r] );
+      #endif
+
+      reserve( send_buffers_[r], send_sizes_[r], send_sizes_[r] + count );
+      std::copy( records, records + count, send_buffers_[r].raw_ptr() + send_sizes_[r] );
+      send_sizes_[r] += count;
+   }
+
+   /** A function which transfers all enqueued records to their destinations and receives the records addressed to this process. It must
+   *   be called by one thread of every process at a synchronization point, i.e., while no records are being enqueued. Notes on exception
+   *   safety: basic safety guaranteed. An AllocError exception is thrown if the required resource allocation were not possible and an
+   *   MPIError exception if the communication failed.
+   *
+   *   \return   The number of records which were received, including those addressed to this process itself.
+   */
+   large_t flush() {
+
+      ProcTimer timer;
+
+      const small_t self = small_cast( SN_MPI_RANK() );
+      std::fill( recv_sizes_.begin(), recv_sizes_.end(), large_cast( 0 ) );
+
+      // Records addressed to this process are handed over right away.
+      if( send_sizes_[self] > 0 ) {
+
+         reserve( recv_buffers_[self], 0, send_sizes_[self] );
+         std::copy( send_buffers_[self].raw_ptr(), send_buffers_[self].raw_ptr() + send_sizes_[self], recv_buffers_[self].raw_ptr() );
+         recv_sizes_[self] = send_sizes_[self];
+      }
+
+      #ifdef __SN_USE_MPI__
+      if( SN_MPI_INITIALIZED() && procs_ > 1 )
+         exchange( self );
+      #endif
+
+      large_t sent = 0, received = 0;
+      for( small_t r = 0; r < procs_; ++r ) {
+
+         sent += send_sizes_[r];
+         received += recv_sizes_[r];
+      }
+
+      std::fill( send_sizes_.begin(), send_sizes_.end(), large_cast( 0 ) );
+
+      SN_LOG_REPORT_L2_EVENT( "Aggregation", "CommAggregator::flush sent " << sent << " and received " << received << " records in "
+                                             << timer.getAge() << " s" );
+      return received;
+   }
+
+   /** @} */
+
+private:
+
+   #ifdef __SN_USE_MPI__
+   /* The non-blocking sends of the buffers, the count of the incoming messages and their reception by matched probes. The tag alternates
+   *  between successive flushes, since a process may already send the messages of the next flush while others still receive. */
+   void exchange( small_t self ) {
+
+      const int tag = int( flushes_++ % 2 );
+      int sends = 0, incoming = 0;
+      int info = MPI_SUCCESS;
+
+      for( small_t r = 0; r < procs_; ++r ) {
+
+         flags_[r] = int( r != self && send_sizes_[r] > 0 );
+
+         if( flags_[r] && info == MPI_SUCCESS )
+            info = MPI_Isend( send_buffers_[r].raw_ptr(), int( send_sizes_[r] ), getMPIType< RECORD_T >(), int( r ), tag, comm_,
+                              send_requests_.raw_ptr() + sends++ );
+      }
+
+      if( info == MPI_SUCCESS )
+         info = MPI_Reduce_scatter_block( flags_.data(), &incoming, 1, MPI_INT, MPI_SUM, comm_ );
+
+      for( int k = 0; k < incoming && info == MPI_SUCCESS; ++k ) {
+
+         MPI_Message msg;
+         MPI_Status stat;
+         int count = 0;
+
+         info = MPI_Mprobe( MPI_ANY_SOURCE, tag, comm_, &msg, &stat );
+         if( info != MPI_SUCCESS )
+            break;
+
+         MPI_Get_count( &stat, getMPIType< RECORD_T >(), &count );
+
+         const small_t source = small_cast( stat.MPI_SOURCE );
+         reserve( recv_buffers_[source], 0, large_cast( count ) );
+         recv_sizes_[source] = large_cast( count );
+
+         info = MPI_Mrecv( recv_buffers_[source].raw_ptr(), count, getMPIType< RECORD_T >(), &msg, MPI_STATUS_IGNORE );
+      }
+
+      if( sends > 0 && MPI_Waitall( sends, send_requests_.raw_ptr(), MPI_STATUSES_IGNORE ) != MPI_SUCCESS )
+         info = MPI_ERR_OTHER;
+
+      // Run-time error checking
+      SN_ASSERT_EQUAL( info, MPI_SUCCESS );
+
+      #ifdef NDEBUG
+      if( info != MPI_SUCCESS ) {
+         SN_THROW_MPI_ERROR( "MPI_Aggregator_Error" );
+      }
+      #endif
+
+      SN_LOG_REPORT_L1_EVENT( LogEventType::MPIIsend, "[ " << DTInfo< RECORD_T >::mpi_name << " ], " << std::to_string( sends )
+                                                      << " aggregated messages --tag" << std::to_string( tag ) );
+   }
+   #endif   // MPI Guard
+
+   /* Geometric growth of a buffer to at least the required number of records, which keeps the first ones. */
+   static void reserve( FastBuffer< RECORD_T > & buffer, large_t keep, large_t records ) {
+
+      if( buffer.getSize() >= records )
+         return;
+
+      // The constructor of FastBuffer takes a small_t, so that the size is set by resize, which takes the full large_t.
+      FastBuffer< RECORD_T > grown( small_t( 1 ) );
+      grown.resize( std::max( records, 2 * buffer.getSize() ) );
+      std::copy( buffer.raw_ptr(), buffer.raw_ptr() + keep, grown.raw_ptr() );
+      buffer = std::move( grown );
+   }
+
+   /* Members */
+   small_t procs_;                                          ///< The number of processes.
+   std::vector< FastBuffer< RECORD_T > > send_buffers_;     ///< The records which are to be sent to every process.
+   std::vector< FastBuffer< RECORD_T > > recv_buffers_;     ///< The records which were received from every process.
+   std::vector< large_t > send_sizes_;                      ///< The number of records which are to be sent to every process.
+   std::vector< large_t > recv_sizes_;                      ///< The number of records which were received from every process.
+   std::vector< int > flags_;                               ///< Whether a message is sent to every process at the current flush.
+   large_t flushes_ = 0;                                    ///< The number of flushes which have communicated.
+   MPIRequest< RECORD_T > send_requests_;                   ///< The requests of the sends of the current flush.
+
+   #if defined( __SN_USE_STL_MULTITHREADING__ ) || defined( __SN_USE_OPENMP__ )
+   std::vector< std::mutex > locks_;                        ///< The lock of the buffer of every process.
+   #endif
+
+   #ifdef __SN_USE_MPI__
+   MPI_Comm comm_ = MPI_COMM_NULL;                          ///< The communicator of the aggregator.
+   #endif
+};
+
+}   // namespace simpleNewton
+
+#endif
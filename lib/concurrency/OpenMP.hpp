@@ -278,9 +278,9 @@
    #define OMP_NOWAIT                  nowait
    #define OMP_ORDERED                 ordered
    
-   #define SN_OPENMP_SIMD_LOOP( ... )        __SN_PRAGMA__( omp simd )
-   #define SN_OPENMP_FOR_SIMD_LOOP( ... )    __SN_PRAGMA__( omp for simd )
-   #define SN_OPENMP_DECLARE_SIMD( ... )     __SN_PRAGMA__( omp declare simd )
+   #define SN_OPENMP_SIMD_LOOP( ... )        __SN_PRAGMA__( omp simd __VA_ARGS__ )
+   #define SN_OPENMP_FOR_SIMD_LOOP( ... )    __SN_PRAGMA__( omp for simd __VA_ARGS__ )
+   #define SN_OPENMP_DECLARE_SIMD( ... )     __SN_PRAGMA__( omp declare simd __VA_ARGS__ )
    
    #define OMP_SAFELEN( L )            safelen( L )
    #define OMP_SIMDLEN( L )            simdlen( L )
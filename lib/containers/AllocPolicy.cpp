@@ -0,0 +1,185 @@
+#include "AllocPolicy.hpp"
+
+#include <new>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the implementation of the allocation policies.
+///   \file
+///   \addtogroup containers Containers
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+constexpr small_t DefaultAlloc::alignment;
+constexpr small_t HugePageAlloc::alignment;
+#endif   // DOXYSKIP
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   DefaultAlloc
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void * DefaultAlloc::allocate( large_t bytes ) {
+
+   try {
+      return ::operator new( bytes );
+   }
+   catch( const std::bad_alloc & ) {
+      SN_THROW_ALLOC_ERROR();
+   }
+}
+
+void DefaultAlloc::deallocate( void * ptr, large_t ) {
+   ::operator delete( ptr );
+}
+
+void * DefaultAlloc::reallocate( void * ptr, large_t old_bytes, large_t new_bytes, large_t live ) {
+
+   void * new_ptr = allocate( new_bytes );
+   std::memcpy( new_ptr, ptr, live );
+   deallocate( ptr, old_bytes );
+
+   return new_ptr;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   HugePageAlloc
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace {
+
+/* The size of a huge page backed mapping for a request of the given size */
+inline large_t hugeMappingSize( large_t bytes ) {
+   return ( bytes + globalConstants::HUGE_PAGE_SIZE - 1 ) / globalConstants::HUGE_PAGE_SIZE * globalConstants::HUGE_PAGE_SIZE;
+}
+
+}
+#endif   // DOXYSKIP
+
+flag_t HugePageAlloc::isHuge( large_t bytes ) {
+
+   #ifdef __linux__
+   return bytes >= globalConstants::HUGE_PAGE_SIZE;
+   #else
+   (void)bytes;
+   return false;
+   #endif
+}
+
+void * HugePageAlloc::allocate( large_t bytes ) {
+
+   if( ! isHuge( bytes ) )
+      return CacheLineAlloc::allocate( bytes );
+
+   #ifdef __linux__
+   const large_t HP = globalConstants::HUGE_PAGE_SIZE;
+   const large_t mapped = hugeMappingSize( bytes );
+
+   // Over-map by one huge page so that a huge page aligned window can be cut out, the rest is returned to the system.
+   void * raw = mmap( nullptr, mapped + HP, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+   if( raw == MAP_FAILED )
+      SN_THROW_ALLOC_ERROR();
+
+   const std::uintptr_t base = reinterpret_cast< std::uintptr_t >( raw );
+   const std::uintptr_t head = ( base + HP - 1 ) & ~std::uintptr_t( HP - 1 );
+
+   if( head > base )
+      munmap( raw, head - base );
+   if( base + mapped + HP > head + mapped )
+      munmap( reinterpret_cast< void * >( head + mapped ), base + mapped + HP - ( head + mapped ) );
+
+   #ifdef MADV_HUGEPAGE
+   madvise( reinterpret_cast< void * >( head ), mapped, MADV_HUGEPAGE );   // Only advice: failure leaves regular pages.
+   #endif
+
+   return reinterpret_cast< void * >( head );
+   #else
+   return nullptr;   // Unreachable.
+   #endif
+}
+
+void HugePageAlloc::deallocate( void * ptr, large_t bytes ) {
+
+   if( ! isHuge( bytes ) ) {
+      CacheLineAlloc::deallocate( ptr, bytes );
+      return;
+   }
+
+   #ifdef __linux__
+   munmap( ptr, hugeMappingSize( bytes ) );
+   #endif
+}
+
+void * HugePageAlloc::reallocate( void * ptr, large_t old_bytes, large_t new_bytes, large_t live ) {
+
+   #if defined( __linux__ ) && defined( MREMAP_MAYMOVE )
+   if( isHuge( old_bytes ) && isHuge( new_bytes ) ) {
+   
+      const large_t old_mapped = hugeMappingSize( old_bytes );
+      const large_t new_mapped = hugeMappingSize( new_bytes );
+      
+      if( old_mapped == new_mapped )
+         return ptr;
+      
+      // The page tables are moved, not the data. The kernel only guarantees a page aligned mapping, though.
+      void * new_ptr = mremap( ptr, old_mapped, new_mapped, MREMAP_MAYMOVE );
+      if( new_ptr != MAP_FAILED ) {
+      
+         // A mapping which is not huge page aligned cannot be backed by huge pages, so that the data is copied into a fresh one. If that
+         // cannot be mapped, the remapped pages are kept, since they still satisfy the guaranteed alignment.
+         if( reinterpret_cast< std::uintptr_t >( new_ptr ) % globalConstants::HUGE_PAGE_SIZE != 0 ) {
+         
+            try {
+               void * aligned_ptr = allocate( new_bytes );
+               std::memcpy( aligned_ptr, new_ptr, live );
+               munmap( new_ptr, new_mapped );
+               return aligned_ptr;
+            }
+            catch( const AllocError & ) {}
+         }
+         
+         #ifdef MADV_HUGEPAGE
+         madvise( new_ptr, new_mapped, MADV_HUGEPAGE );
+         #endif
+         
+         return new_ptr;
+      }
+   }
+   #endif
+   
+   void * new_ptr = allocate( new_bytes );
+   std::memcpy( new_ptr, ptr, live );
+   deallocate( ptr, old_bytes );
+
+   return new_ptr;
+}
+
+}   // namespace simpleNewton
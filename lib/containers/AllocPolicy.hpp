@@ -0,0 +1,201 @@
+#ifndef SN_ALLOCPOLICY_HPP
+#define SN_ALLOCPOLICY_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <Types.hpp>
+#include <Global.hpp>
+
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the allocation policies which decide how RAIIWrapper, and therefore all dynamic containers, obtain their raw memory.
+///   \file
+///   \addtogroup containers Containers
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This policy obtains raw memory from the global operator new. It only guarantees the fundamental alignment and is the default policy
+*   of all dynamic containers.
+*/
+//==========================================================================================================================================
+
+struct DefaultAlloc {
+
+   /** The alignment in bytes which is guaranteed for every allocation. */
+   static constexpr small_t alignment = alignof( std::max_align_t );
+
+   /** A function which allocates raw memory. An AllocError exception is thrown if the allocation were not possible.
+   *
+   *   \param bytes   The number of bytes required.
+   *   \return        A pointer to the allocated memory.
+   */
+   static void * allocate( large_t bytes );
+
+   /** A function which releases raw memory obtained from this policy.
+   *
+   *   \param ptr     The pointer returned by allocate.
+   *   \param bytes   The number of bytes which were requested.
+   */
+   static void deallocate( void * ptr, large_t bytes );
+
+   /** A function which moves the leading bytes of an allocation into a larger (or smaller) one, releasing the old allocation. It is only 
+   *   to be used with trivially copyable contents. Notes on exception safety: strong safety guaranteed. An AllocError exception is thrown 
+   *   if the allocation were not possible, in which case the old allocation remains intact.
+   *
+   *   \param ptr         The pointer returned by allocate.
+   *   \param old_bytes   The number of bytes which were requested for ptr.
+   *   \param new_bytes   The number of bytes now required.
+   *   \param live        The number of leading bytes which have to be preserved.
+   *   \return            A pointer to the new allocation.
+   */
+   static void * reallocate( void * ptr, large_t old_bytes, large_t new_bytes, large_t live );
+};
+
+
+
+//===CLASS==================================================================================================================================
+
+/** This policy obtains raw memory which is aligned to a given boundary. Aligning to the cache line prevents a single element from being
+*   split across two lines, and aligning to the SIMD width allows vectorized loops to declare their operands as aligned (OMP_ALIGNED).
+*
+*   \tparam ALIGNMENT   The alignment in bytes, a power of two which is at least the size of a pointer.
+*/
+//==========================================================================================================================================
+
+template< small_t ALIGNMENT >
+struct AlignedAlloc {
+
+   /** The alignment in bytes which is guaranteed for every allocation. */
+   static constexpr small_t alignment = ALIGNMENT;
+
+   /** A function which allocates aligned raw memory. An AllocError exception is thrown if the allocation were not possible.
+   *
+   *   \param bytes   The number of bytes required.
+   *   \return        A pointer to the allocated memory.
+   */
+   static void * allocate( large_t bytes ) {
+
+      SN_CT_REQUIRE< ( ALIGNMENT & ( ALIGNMENT - 1 ) ) == 0 && ALIGNMENT >= sizeof( void * ) >();
+
+      void * ptr = nullptr;
+      if( posix_memalign( &ptr, ALIGNMENT, bytes ) != 0 )
+         SN_THROW_ALLOC_ERROR();
+
+      return ptr;
+   }
+
+   /** A function which releases raw memory obtained from this policy.
+   *
+   *   \param ptr   The pointer returned by allocate.
+   */
+   static void deallocate( void * ptr, large_t ) {
+      std::free( ptr );
+   }
+
+   /** A function which moves the leading bytes of an allocation into a new one, releasing the old allocation. It is only to be used with 
+   *   trivially copyable contents. Notes on exception safety: strong safety guaranteed.
+   *
+   *   \param ptr         The pointer returned by allocate.
+   *   \param new_bytes   The number of bytes now required.
+   *   \param live        The number of leading bytes which have to be preserved.
+   *   \return            A pointer to the new allocation.
+   */
+   static void * reallocate( void * ptr, large_t, large_t new_bytes, large_t live ) {
+
+      void * new_ptr = allocate( new_bytes );
+      std::memcpy( new_ptr, ptr, live );
+      std::free( ptr );
+
+      return new_ptr;
+   }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< small_t ALIGNMENT >
+constexpr small_t AlignedAlloc< ALIGNMENT >::alignment;
+#endif   // DOXYSKIP
+
+/** This policy aligns every allocation to the size of a cache line. */
+using CacheLineAlloc = AlignedAlloc< globalConstants::CACHE_LINE_SIZE >;
+
+/** This policy aligns every allocation to the width of the widest SIMD register. */
+using SIMDAlignedAlloc = AlignedAlloc< globalConstants::SIMD_ALIGNMENT >;
+
+
+
+//===CLASS==================================================================================================================================
+
+/** This policy is intended for very large arrays. Allocations of at least one huge page are mapped anonymously, aligned to and rounded up
+*   to the huge page size and advised to be backed by transparent huge pages, which reduces the number of TLB misses when streaming through
+*   the array. Smaller allocations are served cache line aligned. On platforms without mmap, every allocation is served cache line aligned.
+*/
+//==========================================================================================================================================
+
+struct HugePageAlloc {
+
+   /** The alignment in bytes which is guaranteed for every allocation. */
+   static constexpr small_t alignment = globalConstants::CACHE_LINE_SIZE;
+
+   /** A function which allocates raw memory. An AllocError exception is thrown if the allocation were not possible.
+   *
+   *   \param bytes   The number of bytes required.
+   *   \return        A pointer to the allocated memory.
+   */
+   static void * allocate( large_t bytes );
+
+   /** A function which releases raw memory obtained from this policy.
+   *
+   *   \param ptr     The pointer returned by allocate.
+   *   \param bytes   The number of bytes which were requested.
+   */
+   static void deallocate( void * ptr, large_t bytes );
+
+   /** A function which moves the leading bytes of an allocation into a larger (or smaller) one, releasing the old allocation. It is only 
+   *   to be used with trivially copyable contents. If both the old and the new allocation are huge page backed, the pages are remapped by 
+   *   the kernel (mremap) and no data is copied, unless the kernel has placed the new mapping off a huge page boundary, where the data is 
+   *   copied into a fresh, huge page aligned mapping. Notes on exception safety: strong safety guaranteed.
+   *
+   *   \param ptr         The pointer returned by allocate.
+   *   \param old_bytes   The number of bytes which were requested for ptr.
+   *   \param new_bytes   The number of bytes now required.
+   *   \param live        The number of leading bytes which have to be preserved.
+   *   \return            A pointer to the new allocation.
+   */
+   static void * reallocate( void * ptr, large_t old_bytes, large_t new_bytes, large_t live );
+
+   /** A function which decides whether an allocation of the given size is mapped on huge pages.
+   *
+   *   \param bytes   The number of bytes required.
+   *   \return        true if the allocation is huge page backed, false if not.
+   */
+   static flag_t isHuge( large_t bytes );
+};
+
+}   // namespace simpleNewton
+
+#endif
@@ -38,11 +38,12 @@ namespace simpleNewton {
 
 /** This class serves as the base class for all dynamic resource allocated arrays. DArray is recommended as a large sized data container.
 *
-*   \tparam TYPE_T   The underlying data type of the array.
+*   \tparam TYPE_T         The underlying data type of the array.
+*   \tparam ALLOC_POLICY   The policy which provides the raw memory (see AllocPolicy.hpp).
 */
 //==========================================================================================================================================
 
-template< typename TYPE_T >
+template< typename TYPE_T, class ALLOC_POLICY = DefaultAlloc >
 class DArray {
 
 public:
@@ -58,7 +59,7 @@ public:
    *   \param size   The desired size of the DArray.
    *   \param val    The default value with which to initialize the DArray.
    */
-   DArray( large_t size, const TYPE_T & val = {} ) : data_( createRAIIWrapper<TYPE_T>( size ) ) {
+   DArray( large_t size, const TYPE_T & val = {} ) : data_( createRAIIWrapper< TYPE_T, ALLOC_POLICY >( size ) ) {
 
       SN_ASSERT_POSITIVE( size );
       
@@ -71,12 +72,12 @@ public:
    *
    *   \param ref   The prvalue reference from which to copy data while constructing the new DArray.
    */
-   DArray( const DArray<TYPE_T> & ref ) : data_( createRAIIWrapper<TYPE_T>( ref.size_ ) ), size_(ref.size_) {
+   DArray( const DArray & ref ) : data_( createRAIIWrapper< TYPE_T, ALLOC_POLICY >( ref.size_ ) ), size_(ref.size_) {
       std::copy( ref.data_.raw_ptr(), ref.data_.raw_ptr() + ref.size_, data_.raw_ptr() );
    }
    
    /** Default move constructor. */
-   DArray( DArray<TYPE_T> && ) = default;
+   DArray( DArray && ) = default;
    
    /** Default destructor. */
    ~DArray() = default;
@@ -99,7 +100,31 @@ public:
       
       return data_[index];
    }
-   
+
+   /** Operator (non-const): primary access function.
+   *
+   *   \param index   An index to access elements of the DArray.
+   *   \return        A reference to the element.
+   */
+   inline TYPE_T & operator[]( large_t index ) {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( index, size_ );
+
+      return data_[index];
+   }
+
+   /** A function (non-const) which exposes the underlying array for unit-stride loops.
+   *
+   *   \return   A pointer to the head of the array.
+   */
+   inline TYPE_T * raw_ptr()             { return data_.raw_ptr(); }
+
+   /** A function (const) which exposes the underlying array for unit-stride loops.
+   *
+   *   \return   A const qualified pointer to the head of the array.
+   */
+   inline const TYPE_T * raw_ptr() const { return data_.raw_ptr(); }
+
    /** A function to get the size of the DArray.
    *
    *   \return   The size of the array.
@@ -133,7 +158,7 @@ public:
       SN_ASSERT_POSITIVE( new_size );
       
       size_ = new_size;
-      data_ = createRAIIWrapper< TYPE_T >( size_ );
+      data_ = createRAIIWrapper< TYPE_T, ALLOC_POLICY >( size_ );
       
       std::fill( data_.raw_ptr(), data_.raw_ptr() + size_, TYPE_T() );
    }
@@ -171,7 +196,7 @@ public:
    *   \param ref   A value with which the DArray will be populated.
    *   \return      A new DArray upon assignment.
    */
-   DArray<TYPE_T> operator=( const TYPE_T & ref ) {
+   DArray operator=( const TYPE_T & ref ) {
       
       std::fill( data_.raw_ptr(), data_.raw_ptr() + size_, ref );
       
@@ -184,12 +209,12 @@ public:
    *   \param ref   A reference DArray with which the DArray will be populated.
    *   \return      A new DArray upon assignment.
    */
-   DArray<TYPE_T> operator=( const DArray<TYPE_T> & ref ) {
+   DArray operator=( const DArray & ref ) {
 
       if( size_ != ref.size_ ) {
    
          size_ = ref.size_;
-         data_ = createRAIIWrapper<TYPE_T>( ref.size_ );
+         data_ = createRAIIWrapper< TYPE_T, ALLOC_POLICY >( ref.size_ );
       }
       
       std::copy( ref.data_.raw_ptr(), ref.data_.raw_ptr() + ref.size_, data_.raw_ptr() );
@@ -202,7 +227,7 @@ public:
    *   \param ref   An rvalue DArray from which the data shall be assigned to the DArray object.
    *   \return      A new DArray upon assignment.
    */
-   void operator=( DArray<TYPE_T> && ref ) {
+   void operator=( DArray && ref ) {
 
       if( this != &ref ) {
    
@@ -217,8 +242,8 @@ public:
 protected:
 
    /* Members */
-   RAIIWrapper< TYPE_T > data_;   ///< Basic data member. Packed in an RAIIWrapper.
-   large_t size_ = 0;             ///< The size data member.
+   RAIIWrapper< TYPE_T, ALLOC_POLICY > data_;   ///< Basic data member. Packed in an RAIIWrapper.
+   large_t size_ = 0;                           ///< The size data member.
 };
 
 }   // namespace simpleNewton
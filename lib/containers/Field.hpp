@@ -9,6 +9,8 @@
 
 #include <asserts/Asserts.hpp>
 
+#include <concurrency/OpenMP.hpp>
+
 #include "DArray.hpp"
 
 //==========================================================================================================================================
@@ -39,11 +41,15 @@ namespace simpleNewton {
 //===CLASS==================================================================================================================================
 
 /** This class adds push-back and associated functionality to the dynamic array and can be used as a fast, large container in World.
+*
+*   \tparam TYPE_T         The underlying data type of the field.
+*   \tparam INIT_SIZE      The initial capacity of the field.
+*   \tparam ALLOC_POLICY   The policy which provides the raw memory (see AllocPolicy.hpp).
 */
 //==========================================================================================================================================
 
-template< typename TYPE_T, small_t INIT_SIZE = 10000 >
-class Field : private NonCopyable, public DArray<TYPE_T> {
+template< typename TYPE_T, small_t INIT_SIZE = 10000, class ALLOC_POLICY = DefaultAlloc >
+class Field : private NonCopyable, public DArray< TYPE_T, ALLOC_POLICY > {
 
 public:
    
@@ -51,7 +57,7 @@ public:
    *   @{
    */
    /** Near-default trivial constructor */
-   Field() : DArray<TYPE_T>( INIT_SIZE ) { size_ = 0; }
+   Field() : DArray< TYPE_T, ALLOC_POLICY >( INIT_SIZE ) { size_ = 0; }
 
    /** Default move constructor */
    Field( Field && ) = default;
@@ -62,9 +68,32 @@ public:
    
    /** @} */
    
+   /** \name Access
+   *   @{
+   */
+   /** A function to get the number of elements for which resources are currently allocated.
+   *
+   *   \return   The capacity of the field.
+   */
+   inline large_t getCapacity() const   { return data_.getSize(); }
+   
+   /** @} */
+   
    /** \name Utility
    *   @{
    */
+   /** A function which ensures that the field can hold at least the given number of elements without further reallocation. Notes on 
+   *   exception safety: strong safety guaranteed for trivially copyable types. The function throws an AllocError exception if the required 
+   *   resource allocation were not possible.
+   *
+   *   \param n   The number of elements which the field is to accommodate.
+   */
+   void reserve( large_t n ) {
+      
+      if( n > getCapacity() )
+         data_.relocate( n, size_ );
+   }
+   
    /** A function which adds an element at the end of the array. Notes on exception safety: strong safety guaranteed. The function throws 
    *   an AllocError exception if the required resource allocation were not possible.
    *
@@ -72,27 +101,104 @@ public:
    */
    void pushBack( TYPE_T && _elem = TYPE_T() ) {
       
-      if( size_ == capacity_ ) {
-         
-         capacity_ = capacity_ + size_ * factor_;
-
-         try {
-         
-            auto new_data = createRAIIWrapper<TYPE_T>( capacity_ );
-            std::copy( data_.raw_ptr(), data_.raw_ptr() + size_, new_data.raw_ptr() );
+      if( size_ == getCapacity() ) {
          
-            data_ = std::move( new_data );
-         }
-         catch( const AllocError & ) {
-            SN_THROW_ALLOC_ERROR();
-         }
+         TYPE_T elem( std::move( _elem ) );   // _elem may live in the array.
+         grow( size_ + 1 );
+         data_[ size_ ] = std::move( elem );
       }
+      else
+         data_[ size_ ] = std::move( _elem );
       
-      // Inserting and size update
-      data_[ size_ ] = std::move( _elem );
       size_++;
    }
    
+   /** A function which adds a copy of an element at the end of the array. Notes on exception safety: strong safety guaranteed. The 
+   *   function throws an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param _elem   The element to be copied to the end of the array.
+   */
+   void pushBack( const TYPE_T & _elem ) {
+      pushBack( TYPE_T( _elem ) );
+   }
+   
+   /** A function which adds n copies of an element at the end of the array, reallocating at most once. Notes on exception safety: strong 
+   *   safety guaranteed for trivially copyable types. The function throws an AllocError exception if the required resource allocation were 
+   *   not possible.
+   *
+   *   \param n     The number of elements to be added.
+   *   \param val   The value of the new elements.
+   */
+   void pushBackN( large_t n, const TYPE_T & val = TYPE_T() ) {
+      
+      if( n == 0 )
+         return;
+      
+      const TYPE_T elem( val );   // val may live in the array.
+      if( size_ + n > getCapacity() )
+         grow( size_ + n );
+      
+      std::fill( data_.raw_ptr() + size_, data_.raw_ptr() + size_ + n, elem );
+      size_ += n;
+   }
+   
+   /** A function which adds n copies of an element at the end of the array like pushBackN, but writes them in parallel, statically 
+   *   scheduled in chunks of the given size counted from the head of the array. A kernel which is scheduled in the same way finds every 
+   *   new element on a page which its thread has touched first, i.e., in the memory of its own NUMA node. Only the chunks from the last
+   *   round of chunks before the new elements onwards are visited, so that the cost does not depend on the size of the array. Batches 
+   *   smaller than a chunk are written serially. Notes on exception safety: strong safety guaranteed for trivially copyable types. The function throws an 
+   *   AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param n       The number of elements to be added.
+   *   \param val     The value of the new elements.
+   *   \param chunk   The chunk size of the static schedule.
+   */
+   void pushBackN( large_t n, const TYPE_T & val, large_t chunk ) {
+      
+      SN_ASSERT_POSITIVE( chunk );
+      
+      if( n < chunk ) {
+         pushBackN( n, val );
+         return;
+      }
+      
+      const TYPE_T elem( val );   // val may live in the array.
+      if( size_ + n > getCapacity() )
+         grow( size_ + n );
+      
+      TYPE_T * data = data_.raw_ptr();
+      const large_t first = size_;
+      const large_t last = size_ + n;
+      
+      // The chunk c falls to the thread c mod T. Starting at a multiple of T chunks keeps every chunk on the same thread as in the kernels.
+      #ifdef __SN_USE_OPENMP__
+      const large_t round = chunk * static_cast< large_t >( omp_get_max_threads() );
+      const large_t start = first / round * round;
+      #else
+      const large_t start = first;
+      #endif
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) )
+      for( large_t k = start; k < last; ++k )
+         if( k >= first )
+            data[k] = elem;
+      SN_OPENMP_SYNC()
+      
+      size_ = last;
+   }
+   
+   /** A function which constructs an element at the end of the array from the given arguments. Notes on exception safety: strong safety 
+   *   guaranteed. The function throws an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \tparam ARGS   The types of the constructor arguments.
+   *   \param args    The constructor arguments.
+   */
+   template< class... ARGS >
+   void emplaceBack( ARGS &&... args ) {
+      pushBack( TYPE_T( std::forward< ARGS >( args )... ) );
+   }
+   
    /** A function which removes the element at the end of the array. Notes on exception safety: strong safety guaranteed. The function 
    *   throws a PreconditionError exception if the array is empty.
    *
@@ -110,19 +216,52 @@ public:
       // Update size
       size_--;
       
-      return data_[size_];
+      return std::move( data_[size_] );
+   }
+   
+   /** A function which rearranges the elements according to a permutation, such that the element at index k is the one which was 
+   *   previously at index perm[k]. The elements are gathered in parallel into a fresh buffer of the same capacity, which then replaces the 
+   *   old one. Notes on exception safety: strong safety guaranteed. The function throws an AllocError exception if the required resource 
+   *   allocation were not possible.
+   *
+   *   \param perm   The permutation, i.e., getSize() distinct indices within the size of the field.
+   */
+   void permute( const large_t * perm ) {
+      
+      if( size_ < 2 )
+         return;
+      
+      SN_ASSERT( perm != nullptr );
+      
+      RAIIWrapper< TYPE_T, ALLOC_POLICY > scratch = createRAIIWrapper< TYPE_T, ALLOC_POLICY >( getCapacity() );
+      
+      TYPE_T * dst = scratch.raw_ptr();
+      TYPE_T * src = data_.raw_ptr();
+      const large_t size = size_;
+      
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t k = 0; k < size; ++k )
+         dst[k] = std::move( src[ perm[k] ] );
+      SN_OPENMP_SYNC()
+      
+      data_ = std::move( scratch );
    }
    
    /** @} */
 
 private:
    
+   /* Geometric growth to at least the required capacity: the amortized cost of an insertion remains constant. */
+   void grow( large_t required ) {
+      data_.relocate( std::max( required, getCapacity() * factor_ ), size_ );
+   }
+   
    /** Ancestral visibility */
-   using DArray<TYPE_T>::data_;
-   using DArray<TYPE_T>::size_;
+   using DArray< TYPE_T, ALLOC_POLICY >::data_;
+   using DArray< TYPE_T, ALLOC_POLICY >::size_;
    
-   small_t capacity_ = INIT_SIZE;
-   small_t factor_ = 2;
+   large_t factor_ = 2;
 };
 
 }   // namespace simpleNewton
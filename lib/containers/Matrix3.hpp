@@ -425,6 +425,39 @@ Logger & operator<<( Logger & lg, const Matrix3<FP_TYPE_T> & mat ) {
    return lg;
 }
 
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Type information
+//////////////////////
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+/* Partial specialization: Matrix3. The components are described to MPI by a contiguous derived datatype, which is committed upon 
+*  first use. */
+template< typename FP_TYPE_T > struct DTInfo< Matrix3<FP_TYPE_T> > {
+   
+   static_assert( sizeof( Matrix3<FP_TYPE_T> ) == 9 * sizeof( FP_TYPE_T ), "Matrix3 is expected to consist of its components only." );
+   
+   #ifdef __SN_USE_MPI__
+   /** A function which returns the derived MPI_Datatype of Matrix3, which is committed upon the first call. */
+   static MPI_Datatype getMPIType() {
+      static const MPI_Datatype type = commitContiguousType( 9, DTInfo< FP_TYPE_T >::mpi_type );
+      return type;
+   }
+   static constexpr char mpi_name[] = "MPI_MATRIX3";   ///< The MPI_Datatype's name in string (for logging purposes).
+   #endif
+   
+   static constexpr char name[] = "Matrix3";           ///< The typename in string.
+};
+
+#ifdef __SN_USE_MPI__
+template< typename FP_TYPE_T > constexpr char DTInfo< Matrix3<FP_TYPE_T> >::mpi_name[];
+#endif
+template< typename FP_TYPE_T > constexpr char DTInfo< Matrix3<FP_TYPE_T> >::name[];
+
+#endif   // DOXYSKIP
+
 }   // namespace simpleNewton
 
 #endif
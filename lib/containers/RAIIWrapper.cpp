@@ -39,5 +39,10 @@ template class RAIIWrapper< unsigned long >;
 template class RAIIWrapper< long long >;
 template class RAIIWrapper< unsigned long long >;
 
+template class RAIIWrapper< real_t, SIMDAlignedAlloc >;
+template class RAIIWrapper< single_t, SIMDAlignedAlloc >;
+template class RAIIWrapper< real_t, HugePageAlloc >;
+template class RAIIWrapper< single_t, HugePageAlloc >;
+
 }   // namespace simpleNewton
 #endif
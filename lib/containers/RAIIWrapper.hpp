@@ -2,6 +2,9 @@
 #define SN_RAIIWRAPPER_HPP
 
 #include <algorithm>
+#include <limits>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 #include <Types.hpp>
@@ -11,6 +14,8 @@
 
 #include <core/Exceptions.hpp>
 
+#include "AllocPolicy.hpp"
+
 //==========================================================================================================================================
 //
 //  This file is part of simpleNewton. simpleNewton is free software: you can 
@@ -36,16 +41,26 @@
 /** The space in which all global entities of the framework are accessible */
 namespace simpleNewton {
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< class TYPE, class ALLOC_POLICY > class RAIIWrapper;
+
+template< class TYPE, class ALLOC_POLICY = DefaultAlloc >
+RAIIWrapper< TYPE, ALLOC_POLICY > createRAIIWrapper( large_t );
+#endif   // DOXYSKIP
+
+
+
 //=== CLASS ================================================================================================================================
 
 /** This class is a dynamic, movable-only unit intended to be used as a basic resource manager. An instance of the class can only be 
 *   created using the function, createRAIIWrapper.
 *
-*   \tparam TYPE_T   The underlying data type of the RAIIWrapper.
+*   \tparam TYPE_T         The underlying data type of the RAIIWrapper.
+*   \tparam ALLOC_POLICY   The policy which provides the raw memory (see AllocPolicy.hpp).
 */
 //==========================================================================================================================================
 
-template< class TYPE >
+template< class TYPE, class ALLOC_POLICY = DefaultAlloc >
 class RAIIWrapper : private NonCopyable {
 
 public:
@@ -58,13 +73,12 @@ public:
    
 private:
 
-   /** Direct initialization constructor which accepts freshly allocated resource.
+   /** Direct initialization constructor which accepts freshly allocated and constructed resource.
    *
-   *   \param ptr   A pointer to a newly allocated resource.
+   *   \param ptr    A pointer to a newly allocated resource.
+   *   \param size   The number of elements in the resource.
    */
-   explicit RAIIWrapper( TYPE * ptr ) {
-      data_ = ptr;
-   }
+   RAIIWrapper( TYPE * ptr, large_t size ) : data_( ptr ), size_( size ) {}
 
 public:
 
@@ -72,10 +86,10 @@ public:
    *
    *   \param donour   The rvalue resource managing unit.
    */
-   RAIIWrapper( RAIIWrapper<TYPE> && donour ) {
+   RAIIWrapper( RAIIWrapper && donour ) : data_( donour.data_ ), size_( donour.size_ ) {
       
-      data_ = donour;
       donour.data_ = nullptr;
+      donour.size_ = 0;
    }
 
    /** Explicitly defined destructor. */
@@ -112,12 +126,42 @@ public:
    */
    inline const TYPE * raw_ptr() const   { return data_; }
    
+   /** A function to get the number of elements in the resource.
+   *
+   *   \return   The number of elements.
+   */
+   inline large_t getSize() const        { return size_; }
+   
    /** @} */
    
-   /** A function to cautiously deallocate the resource. */
+   /** A function to cautiously destroy the elements and return the resource to the allocation policy. */
    void free() {
-      if( data_ != nullptr )
-         delete[] data_;
+      
+      if( data_ != nullptr ) {
+      
+         for( large_t i = 0; i < size_; ++i )
+            data_[i].~TYPE();
+         ALLOC_POLICY::deallocate( data_, size_ * sizeof( TYPE ) );
+         
+         data_ = nullptr;
+         size_ = 0;
+      }
+   }
+   
+   /** A function which changes the number of elements in the resource, carrying over the leading elements. Trivially copyable elements 
+   *   are relocated bytewise by the allocation policy (which may remap the pages instead of copying them), all others are moved into a 
+   *   freshly created resource. Notes on exception safety: strong safety guaranteed for trivially copyable types, basic safety otherwise. 
+   *   An AllocError or AllocSizeError exception is thrown if resource allocation is not possible.
+   *
+   *   \param new_size   The new number of elements, which is at least live.
+   *   \param live       The number of leading elements which have to be preserved.
+   */
+   void relocate( large_t new_size, large_t live ) {
+      
+      SN_ASSERT_POSITIVE( new_size );
+      SN_ASSERT( live <= size_ && live <= new_size );
+      
+      relocate( new_size, live, std::integral_constant< bool, std::is_trivially_copyable< TYPE >::value >() );
    }
    
    /** \name Assignment control
@@ -127,36 +171,69 @@ public:
    *
    *   \param donour   The resource managing unit, the management of whose resource is to be taken over.
    */
-   void operator=( RAIIWrapper<TYPE> && donour ) {
+   void operator=( RAIIWrapper && donour ) {
       
-      free();
-      data_ = donour;
-      donour.data_ = nullptr;
+      if( this != &donour ) {
+      
+         free();
+         data_ = donour.data_;
+         size_ = donour.size_;
+         donour.data_ = nullptr;
+         donour.size_ = 0;
+      }
    }
    
    /** @} */
    
    /** A function which creates an instance of RAIIWrapper. */
-   template< class CTYPE >
-   friend RAIIWrapper<CTYPE> createRAIIWrapper( small_t );
+   template< class CTYPE, class CALLOC_POLICY >
+   friend RAIIWrapper< CTYPE, CALLOC_POLICY > createRAIIWrapper( large_t );
    
 private:
    
+   /* Bytewise relocation */
+   void relocate( large_t new_size, large_t live, std::true_type ) {
+      
+      if( new_size > std::numeric_limits< large_t >::max() / sizeof( TYPE ) ) {
+         SN_THROW_ALLOC_SIZE_ERROR();
+      }
+      
+      data_ = static_cast< TYPE * >( ALLOC_POLICY::reallocate( data_, size_ * sizeof( TYPE ), new_size * sizeof( TYPE ), 
+                                                               live * sizeof( TYPE ) ) );
+      
+      for( large_t i = size_; i < new_size; ++i )
+         new( data_ + i ) TYPE;
+      size_ = new_size;
+   }
+   
+   /* Element-wise relocation */
+   void relocate( large_t new_size, large_t live, std::false_type ) {
+      
+      RAIIWrapper new_packet = createRAIIWrapper< TYPE, ALLOC_POLICY >( new_size );
+      std::move( data_, data_ + live, new_packet.data_ );
+      
+      *this = std::move( new_packet );
+   }
+   
    /* Resource */
-   TYPE * data_;   ///< The resource pointer.
+   TYPE * data_ = nullptr;   ///< The resource pointer.
+   large_t size_ = 0;        ///< The number of elements in the resource.
 };
 
 
 
-/** This function performs resource allocation and directs the resource to a newly created RAIIWrapper. Notes on exception safety: strong 
-*   exception safety guaranteed. An InvalidArgument exception is thrown if the size argument is not suitable. An AllocError or an 
-*   AllocSizeError exception, whichever may be the case, is thrown if resource allocation is not possible.
+/** This function performs resource allocation using the allocation policy, default-initializes the elements in place and directs the
+*   resource to a newly created RAIIWrapper. Notes on exception safety: strong exception safety guaranteed. An InvalidArgument exception is
+*   thrown if the size argument is not suitable. An AllocError or an AllocSizeError exception, whichever may be the case, is thrown if 
+*   resource allocation is not possible.
 *
-*   \param size   The size of the resource.
-*   \return       An RAIIWrapper object which will be used to move initialise another.
+*   \tparam TYPE           The underlying data type of the resource.
+*   \tparam ALLOC_POLICY   The policy which provides the raw memory.
+*   \param size            The size of the resource.
+*   \return                An RAIIWrapper object which will be used to move initialise another.
 */
-template< class TYPE >
-RAIIWrapper<TYPE> createRAIIWrapper( small_t size ) {
+template< class TYPE, class ALLOC_POLICY >
+RAIIWrapper< TYPE, ALLOC_POLICY > createRAIIWrapper( large_t size ) {
 
    SN_ASSERT_POSITIVE( size );
    
@@ -166,18 +243,26 @@ RAIIWrapper<TYPE> createRAIIWrapper( small_t size ) {
    }
    #endif
    
-   TYPE * ptr = nullptr;   // vessel
+   if( size > std::numeric_limits< large_t >::max() / sizeof( TYPE ) ) {
+      SN_THROW_ALLOC_SIZE_ERROR();
+   }
+   
+   TYPE * ptr = static_cast< TYPE * >( ALLOC_POLICY::allocate( size * sizeof( TYPE ) ) );   // vessel
    
+   large_t constructed = 0;
    try {
-      ptr = new TYPE[size];
-   }
-   catch( const std::bad_alloc & ex ) {
-      SN_THROW_ALLOC_ERROR();
+      for( ; constructed < size; ++constructed )
+         new( ptr + constructed ) TYPE;
    }
+   catch( ... ) {
    
-   RAIIWrapper<TYPE> new_packet( ptr );
+      for( large_t i = 0; i < constructed; ++i )
+         ptr[i].~TYPE();
+      ALLOC_POLICY::deallocate( ptr, size * sizeof( TYPE ) );
+      throw;
+   }
    
-   return new_packet;
+   return RAIIWrapper< TYPE, ALLOC_POLICY >( ptr, size );
 }
 
 }   // namespace simpleNewton
@@ -0,0 +1,315 @@
+#ifndef SN_SOAFIELD3_HPP
+#define SN_SOAFIELD3_HPP
+
+#include <algorithm>
+#include <utility>
+
+#include <Types.hpp>
+#include <BasicBases.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include "AllocPolicy.hpp"
+#include "Field.hpp"
+#include "Vector3.hpp"
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class template SoAField3, which stores a field of 3-dimensional vectors as three separate component arrays, and the
+///   non-owning view SoASpan3.
+///   \file
+///   \addtogroup containers Containers
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class is a non-owning view of the three component arrays of a SoAField3. It is intended to be handed to compute kernels, which can
+*   then stream through each component with unit stride.
+*
+*   \tparam FP_TYPE_T   The floating point type of the components. A const qualified type yields a read-only view.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+struct SoASpan3 {
+
+   FP_TYPE_T * x;   ///< The head of the x-component array.
+   FP_TYPE_T * y;   ///< The head of the y-component array.
+   FP_TYPE_T * z;   ///< The head of the z-component array.
+
+   large_t size;    ///< The number of elements in each of the component arrays.
+
+   /** Operator: access to a component array by dimension.
+   *
+   *   \param dim   The dimension (0, 1 or 2) of the component.
+   *   \return      The head of the component array.
+   */
+   inline FP_TYPE_T * operator[]( small_t dim ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+
+      return ( dim == 0 ? x : ( dim == 1 ? y : z ) );
+   }
+};
+
+
+
+//===CLASS==================================================================================================================================
+
+/** This class stores a push-back enabled field of 3-dimensional vectors in the structure-of-arrays layout i.e., the x, y and z components
+*   reside in three separate Field objects. Loops over the components are therefore unit-stride and can be vectorized with full-width
+*   loads. Element-wise access is provided as a gather/scatter shim by way of Vector3. The component arrays are aligned to at least the SIMD
+*   width by default, so that kernels may declare them as aligned (OMP_ALIGNED).
+*
+*   \tparam FP_TYPE_T      The floating point type of the components.
+*   \tparam INIT_SIZE      The initial capacity of each component array.
+*   \tparam ALLOC_POLICY   The policy which provides the raw memory of the component arrays (see AllocPolicy.hpp).
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T, small_t INIT_SIZE = 10000, class ALLOC_POLICY = SIMDAlignedAlloc >
+class SoAField3 : private NonCopyable {
+
+public:
+
+   /** The alignment in bytes of the heads of the component arrays. */
+   static constexpr small_t alignment = ALLOC_POLICY::alignment;
+
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Default trivial constructor */
+   SoAField3() { SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >(); }
+
+   /** Default move constructor */
+   SoAField3( SoAField3 && ) = default;
+
+   /** Default destructor */
+   ~SoAField3();
+
+   /** @} */
+
+   /** \name Access
+   *   @{
+   */
+   /** A function to get the number of vectors in the field.
+   *
+   *   \return   The size of the field.
+   */
+   inline large_t getSize() const   { return x_.getSize(); }
+
+   /** A function to get the number of vectors for which resources are currently allocated.
+   *
+   *   \return   The capacity of the field.
+   */
+   inline large_t getCapacity() const   { return x_.getCapacity(); }
+
+   /** A function which gathers the components of an element into a Vector3.
+   *
+   *   \param index   The index of the element.
+   *   \return        A Vector3 object with the components of the element.
+   */
+   Vector3<FP_TYPE_T> get( large_t index ) const;
+
+   /** A function which scatters the components of a Vector3 into an element.
+   *
+   *   \param index   The index of the element.
+   *   \param val     The vector which is to be stored.
+   */
+   void set( large_t index, const Vector3<FP_TYPE_T> & val );
+
+   /** A function (non-const) to access a component array.
+   *
+   *   \param dim   The dimension (0, 1 or 2) of the component.
+   *   \return      A pointer to the head of the component array.
+   */
+   inline FP_TYPE_T * component( small_t dim ) {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+
+      return ( dim == 0 ? x_.raw_ptr() : ( dim == 1 ? y_.raw_ptr() : z_.raw_ptr() ) );
+   }
+
+   /** A function (const) to access a component array.
+   *
+   *   \param dim   The dimension (0, 1 or 2) of the component.
+   *   \return      A const qualified pointer to the head of the component array.
+   */
+   inline const FP_TYPE_T * component( small_t dim ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+
+      return ( dim == 0 ? x_.raw_ptr() : ( dim == 1 ? y_.raw_ptr() : z_.raw_ptr() ) );
+   }
+
+   /** A function (non-const) which returns a view of all three component arrays.
+   *
+   *   \return   A SoASpan3 over the component arrays.
+   */
+   inline SoASpan3<FP_TYPE_T> span() {
+      return SoASpan3<FP_TYPE_T>{ x_.raw_ptr(), y_.raw_ptr(), z_.raw_ptr(), getSize() };
+   }
+
+   /** A function (const) which returns a read-only view of all three component arrays.
+   *
+   *   \return   A read-only SoASpan3 over the component arrays.
+   */
+   inline SoASpan3<const FP_TYPE_T> span() const {
+      return SoASpan3<const FP_TYPE_T>{ x_.raw_ptr(), y_.raw_ptr(), z_.raw_ptr(), getSize() };
+   }
+
+   /** @} */
+
+   /** \name Utility
+   *   @{
+   */
+   /** A function which ensures that the field can hold at least the given number of vectors without further reallocation. Notes on 
+   *   exception safety: basic safety guaranteed. The function throws an AllocError exception if the required resource allocation were not 
+   *   possible.
+   *
+   *   \param n   The number of vectors which the field is to accommodate.
+   */
+   void reserve( large_t n ) {
+   
+      x_.reserve( n );
+      y_.reserve( n );
+      z_.reserve( n );
+   }
+   
+   /** A function which adds an element at the end of the field. Notes on exception safety: basic safety guaranteed. The function throws
+   *   an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param val   The vector to be inserted at the end of the field.
+   */
+   void pushBack( const Vector3<FP_TYPE_T> & val = Vector3<FP_TYPE_T>( FP_TYPE_T() ) ) {
+
+      x_.pushBack( FP_TYPE_T( val[0] ) );
+      y_.pushBack( FP_TYPE_T( val[1] ) );
+      z_.pushBack( FP_TYPE_T( val[2] ) );
+   }
+
+   /** A function which adds n copies of a vector at the end of the field, reallocating each component array at most once. Notes on 
+   *   exception safety: basic safety guaranteed. The function throws an AllocError exception if the required resource allocation were not 
+   *   possible.
+   *
+   *   \param n     The number of vectors to be added.
+   *   \param val   The value of the new vectors.
+   */
+   void pushBackN( large_t n, const Vector3<FP_TYPE_T> & val = Vector3<FP_TYPE_T>( FP_TYPE_T() ) ) {
+   
+      x_.pushBackN( n, val[0] );
+      y_.pushBackN( n, val[1] );
+      z_.pushBackN( n, val[2] );
+   }
+   
+   /** A function which adds n copies of a vector at the end of the field in parallel, statically scheduled in chunks of the given size (see
+   *   Field::pushBackN). Notes on exception safety: basic safety guaranteed. The function throws an AllocError exception if the required 
+   *   resource allocation were not possible.
+   *
+   *   \param n       The number of vectors to be added.
+   *   \param val     The value of the new vectors.
+   *   \param chunk   The chunk size of the static schedule.
+   */
+   void pushBackN( large_t n, const Vector3<FP_TYPE_T> & val, large_t chunk ) {
+   
+      x_.pushBackN( n, val[0], chunk );
+      y_.pushBackN( n, val[1], chunk );
+      z_.pushBackN( n, val[2], chunk );
+   }
+   
+   /** A function which removes the element at the end of the field. Notes on exception safety: strong safety guaranteed. The function
+   *   throws a PreconditionError exception if the field is empty.
+   *
+   *   \return   The removed element.
+   */
+   Vector3<FP_TYPE_T> popBack() {
+
+      FP_TYPE_T x = x_.popBack();
+      FP_TYPE_T y = y_.popBack();
+      FP_TYPE_T z = z_.popBack();
+
+      return Vector3<FP_TYPE_T>( x, y, z );
+   }
+
+   /** A function to fill every element of the field with the same vector.
+   *
+   *   \param val   The vector with which to fill the field.
+   */
+   void fill( const Vector3<FP_TYPE_T> & val ) {
+
+      std::fill( x_.raw_ptr(), x_.raw_ptr() + getSize(), val[0] );
+      std::fill( y_.raw_ptr(), y_.raw_ptr() + getSize(), val[1] );
+      std::fill( z_.raw_ptr(), z_.raw_ptr() + getSize(), val[2] );
+   }
+
+   /** A function which rearranges the vectors according to a permutation, such that the vector at index k is the one which was previously 
+   *   at index perm[k] (see Field::permute). Notes on exception safety: basic safety guaranteed. The function throws an AllocError exception
+   *   if the required resource allocation were not possible.
+   *
+   *   \param perm   The permutation, i.e., getSize() distinct indices within the size of the field.
+   */
+   void permute( const large_t * perm ) {
+
+      x_.permute( perm );
+      y_.permute( perm );
+      z_.permute( perm );
+   }
+
+   /** @} */
+
+private:
+
+   /* Component arrays */
+   Field< FP_TYPE_T, INIT_SIZE, ALLOC_POLICY > x_;   ///< The x-components.
+   Field< FP_TYPE_T, INIT_SIZE, ALLOC_POLICY > y_;   ///< The y-components.
+   Field< FP_TYPE_T, INIT_SIZE, ALLOC_POLICY > z_;   ///< The z-components.
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T, small_t INIT_SIZE, class ALLOC_POLICY >
+SoAField3< FP_TYPE_T, INIT_SIZE, ALLOC_POLICY >::~SoAField3() = default;
+
+template< typename FP_TYPE_T, small_t INIT_SIZE, class ALLOC_POLICY >
+constexpr small_t SoAField3< FP_TYPE_T, INIT_SIZE, ALLOC_POLICY >::alignment;
+
+template< typename FP_TYPE_T, small_t INIT_SIZE, class ALLOC_POLICY >
+Vector3<FP_TYPE_T> SoAField3< FP_TYPE_T, INIT_SIZE, ALLOC_POLICY >::get( large_t index ) const {
+
+   SN_ASSERT_INDEX_WITHIN_SIZE( index, getSize() );
+
+   return Vector3<FP_TYPE_T>( x_.raw_ptr()[index], y_.raw_ptr()[index], z_.raw_ptr()[index] );
+}
+
+template< typename FP_TYPE_T, small_t INIT_SIZE, class ALLOC_POLICY >
+void SoAField3< FP_TYPE_T, INIT_SIZE, ALLOC_POLICY >::set( large_t index, const Vector3<FP_TYPE_T> & val ) {
+
+   SN_ASSERT_INDEX_WITHIN_SIZE( index, getSize() );
+
+   x_.raw_ptr()[index] = val[0];
+   y_.raw_ptr()[index] = val[1];
+   z_.raw_ptr()[index] = val[2];
+}
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef SN_FASTBUFFER_HPP
 #define SN_FASTBUFFER_HPP
 
+#include <utility>
+
 #include <logger/Logger.hpp>
 #include <containers/DArray.hpp>
 
@@ -41,18 +43,19 @@ template< typename TYPE_T > class BaseComm;
 /** This container serves as a move-only buffer for quick transfers between loopers, MPI functions and others. It is highly recommended 
 *   that the data be moved out of the buffer immediately after use. 
 *
-*   \tparam TYPE_T   The data type of the resource
+*   \tparam TYPE_T         The data type of the resource
+*   \tparam ALLOC_POLICY   The policy which provides the raw memory (see AllocPolicy.hpp).
 */
 //==========================================================================================================================================
 
-template< typename TYPE_T >
-class FastBuffer : private NonCopyable, public DArray<TYPE_T> {
+template< typename TYPE_T, class ALLOC_POLICY = DefaultAlloc >
+class FastBuffer : private NonCopyable, public DArray< TYPE_T, ALLOC_POLICY > {
 
 private:
    
    /* Ancestral visibility */
-   using DArray<TYPE_T>::data_;
-   using DArray<TYPE_T>::size_;
+   using DArray< TYPE_T, ALLOC_POLICY >::data_;
+   using DArray< TYPE_T, ALLOC_POLICY >::size_;
    
    /* Length of a literal */
    small_t cptr_length( const TYPE_T * ptr ) {
@@ -72,7 +75,7 @@ public:
    *
    *   \param arr   The literal from which the direct initialization (by copy) takes place.
    */
-   FastBuffer( const TYPE_T * arr ) : DArray<TYPE_T>( cptr_length( arr ) ) {
+   FastBuffer( const TYPE_T * arr ) : DArray< TYPE_T, ALLOC_POLICY >( cptr_length( arr ) ) {
       std::copy( arr, arr + size_, data_.raw_ptr() );
    }
 
@@ -81,10 +84,10 @@ public:
    *   \param size   The desired size of the FastBuffer object upon construction.
    *   \param val    The value with which the contents of the FastBuffer need to be initialized. 
    */
-   FastBuffer( small_t size, const TYPE_T & val = {} ) : DArray<TYPE_T>( size, val ) {}
+   FastBuffer( small_t size, const TYPE_T & val = {} ) : DArray< TYPE_T, ALLOC_POLICY >( size, val ) {}
    
    /** Default move constructor. */
-   FastBuffer( FastBuffer<TYPE_T> && ) = default;
+   FastBuffer( FastBuffer && ) = default;
 
    /** Default destructor. */
    ~FastBuffer() = default;
@@ -95,8 +98,8 @@ public:
    *   @{
    */
    /** Assignment is possible as one-time move only. */
-   void operator=( FastBuffer<TYPE_T> && src ) {
-      DArray<TYPE_T>::operator=(src);
+   void operator=( FastBuffer && src ) {
+      DArray< TYPE_T, ALLOC_POLICY >::operator=( std::move(src) );
    }
    
    /** @} */
@@ -117,7 +120,7 @@ public:
          SN_THROW_OOR_ERROR();
       #endif
       
-      return DArray<TYPE_T>::operator[]( index );
+      return DArray< TYPE_T, ALLOC_POLICY >::operator[]( index );
    }
    
    /** @} */
@@ -131,9 +134,9 @@ public:
    *   \param operand   The FastBuffer object which has to be appended.
    *   \return          The concatenated FastBuffer object. 
    */
-   FastBuffer<TYPE_T> operator+( const FastBuffer<TYPE_T> & operand ) {
+   FastBuffer operator+( const FastBuffer & operand ) {
    
-      FastBuffer<TYPE_T> newOMPIB( size_ + operand.size_ );
+      FastBuffer newOMPIB( size_ + operand.size_ );
 
       std::copy( data_.raw_ptr(), data_.raw_ptr() + size_, newOMPIB.data_.raw_ptr() );
       std::copy( operand.data_.raw_ptr(), operand.data_.raw_ptr() + operand.size_, newOMPIB.data_.raw_ptr() + size_ );
@@ -147,8 +150,8 @@ public:
    *   @{
    */
    /** Output function which is compatible with the Logger. */
-   template< typename T >
-   friend Logger & operator<<( Logger & , const FastBuffer<T> & );
+   template< typename T, class A >
+   friend Logger & operator<<( Logger & , const FastBuffer< T, A > & );
    
    /** @} */
    
@@ -166,12 +169,13 @@ public:
 *   performance optimized.
 *
 *   \tparam T     The basic data type of the FastBuffer.
+*   \tparam A     The allocation policy of the FastBuffer.
 *   \param lg     A Logger instance.
 *   \param buff   The buffer from which the data has to be transferred to the Logger instance lg.
 *   \return       The Logger instance.
 */
-template< typename T >
-Logger & operator<<( Logger & lg, const FastBuffer<T> & buff ) {
+template< typename T, class A >
+Logger & operator<<( Logger & lg, const FastBuffer< T, A > & buff ) {
    
    for( uint_t i=0; i<buff.size_; ++i )
       lg <<  buff.data_[i];
@@ -44,6 +44,10 @@ namespace simpleNewton {
 *   corresponding wait function. This container can also be treated as an array whose elements correspond to multiple non-blocking 
 *   MPI operations.
 *
+*   A container may alternatively own persistent requests, which are set up once by BaseComm::sendInit and BaseComm::receiveInit and then
+*   started by BaseComm::startAll as often as required. A completed persistent request merely becomes inactive. The container frees its
+*   persistent requests when it is destroyed or when freePersistent is called.
+*
 *   \tparam TYPE_T   The type of the data upon which the non-blocking MPI operation is to be performed.
 */
 //==========================================================================================================================================
@@ -72,8 +76,12 @@ public:
    /** Move constructor */
    MPIRequest( MPIRequest && ) = default;
    
-   /** Destructor */
-   ~MPIRequest() = default;
+   /** Destructor, which frees the persistent requests. */
+   ~MPIRequest() {
+      
+      if( persistent_ )
+         freePersistent();
+   }
    
    /** @} */
 
@@ -136,6 +144,45 @@ public:
    
    
    
+   /** \name Persistent requests
+   * @{
+   */
+   /** A function to find out whether the container owns persistent requests.
+   *   \return   true if the requests are persistent, false if not.
+   */
+   bool isPersistent() const                                   { return persistent_; }
+   
+   /** A function which marks the requests of the container as persistent. It is called by the functions which set up persistent
+   *   operations. */
+   void setPersistent()                                        { persistent_ = true; }
+   
+   /** A function which frees all persistent requests, after which the container may be used for any kind of operation. The requests must
+   *   be inactive, i.e., not started or completed by a wait function. Nothing is freed if MPI has already been finalized.
+   */
+   void freePersistent() {
+      
+      if( req_.raw_ptr() == nullptr )   // Moved from
+         return;
+      
+      int finalized = 0;
+      MPI_Finalized( &finalized );
+      
+      for( small_t i = 0; i < size_; ++i ) {
+         
+         if( req_[i] != MPI_REQUEST_NULL && ! finalized )
+            MPI_Request_free( &req_[i] );
+         
+         req_[i] = MPI_REQUEST_NULL;
+         count_[i] = 0;
+      }
+      
+      persistent_ = false;
+   }
+   
+   /** @} */
+   
+   
+   
    /** \name State */
    /**   A function to check if all the MPI_Requests managed by the container have been cleared. Simply returns true if MPI is not included.
    *     \return   true if the MPI_Requests have been cleared, false if not.
@@ -160,6 +207,8 @@ private:
    RAIIWrapper< small_t > count_;   ///< The container for the transfer counts. Each non-blocking MPI Op's data transfer count is recorded.
                                     ///  Will only be compiled if MPI is included.
    RAIIWrapper< MPI_Request > req_;   ///< The container of MPI_Request instances. Will only be compiled if MPI is included.
+   
+   bool persistent_ = false;   ///< Whether the requests are persistent, i.e., owned by the container until they are freed.
 };
 
 #else   // MPI Guard
@@ -169,7 +218,13 @@ class MPIRequest : private NonCopyable {
 
 public:
 
+   MPIRequest( small_t = 1 ) {}
+   
    small_t getSize() const { return 0; }  
+   
+   bool isPersistent() const { return false; }
+   
+   void freePersistent() {}
 };
 #endif   // MPI Guard
 
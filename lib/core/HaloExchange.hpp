@@ -0,0 +1,518 @@
+#ifndef SN_HALOEXCHANGE_HPP
+#define SN_HALOEXCHANGE_HPP
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <Types.hpp>
+#include <Global.hpp>
+#include <BasicBases.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+#include <containers/mpi/FastBuffer.hpp>
+#include <containers/mpi/MPIRequest.hpp>
+
+#include <concurrency/BaseComm.hpp>
+
+#include <core/ProcTimer.hpp>
+
+#include <core/World.hpp>
+#include <core/kinematics/WorldKinematicsBB.hpp>
+
+#include <logger/Logger.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class HaloExchange, which copies the positions of the objects near the faces, edges and corners of a block to the
+///   neighbouring processes as ghosts.
+///   \file
+///   \addtogroup core Core
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class exchanges the halos of the blocks of the Cartesian process grid (see Simulator::setupDomains). An owned object which lies
+*   closer than the cutoff to a face, an edge or a corner of the block of its process is selected for every neighbour beyond it, i.e., for
+*   up to seven of the 26 neighbours. The positions of the selected objects are packed into one FastBuffer per neighbour and exchanged with
+*   persistent BaseComm requests (see BaseComm::sendInit), after the number of ghosts has been exchanged. The count requests are only set
+*   up anew when the neighbours change. A position request is bound to the positions of exactly the current number of ghosts, so that no
+*   more than the live positions are transferred, and is set up anew whenever that number changes or the send buffer grows. The received
+*   positions are appended to the kinematics as ghosts (see WorldKinematicsBB::allocateGhosts), ordered by neighbour. Since the blocks are
+*   at least as thick as the cutoff, every object within the cutoff of an owned object is either owned or a ghost after the exchange.
+*
+*   The exchange may be split into begin, which posts the messages, and finish, which completes them and inserts the ghosts, so that the
+*   forces on the interior objects can be computed while the messages are in flight. An owned object is interior if no neighbour lies
+*   within the cutoff, i.e., if all objects within its cutoff are owned, and boundary otherwise (see getInteriorSlots and getBoundarySlots).
+*
+*   The neighbours are identified by their direction, i.e., ( dx + 1 ) * 9 + ( dy + 1 ) * 3 + ( dz + 1 ) for the offsets dx, dy and dz in
+*   the process grid (see getDirection). The direction 13 is the process itself.
+*
+*   \tparam FP_TYPE_T   The floating point type of the positions.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class HaloExchange : private NonCopyable {
+
+public:
+
+   /** The number of directions, including the process itself. */
+   static constexpr small_t DIRECTIONS = 27;
+
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Direct initialization constructor. Notes on exception safety: strong safety guaranteed. The function throws an AllocError
+   *   exception if the required resource allocation were not possible.
+   *
+   *   \param cutoff   The interaction cutoff, i.e., the depth of the halo.
+   */
+   explicit HaloExchange( FP_TYPE_T cutoff ) : cutoff_( cutoff ) {
+
+      SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >();
+      SN_ASSERT( cutoff > FP_TYPE_T( 0 ) );
+
+      try {
+         send_buffers_.reserve( DIRECTIONS );
+         recv_buffers_.reserve( DIRECTIONS );
+         send_counts_.reserve( DIRECTIONS );
+         recv_counts_.reserve( DIRECTIONS );
+
+         for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+            send_buffers_.emplace_back( small_t( 3 ) );
+            recv_buffers_.emplace_back( small_t( 3 ) );
+            send_counts_.emplace_back( small_t( 1 ) );
+            recv_counts_.emplace_back( small_t( 1 ) );
+         }
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+
+      std::fill( ranks_, ranks_ + DIRECTIONS, -1 );
+      std::fill( bound_ranks_, bound_ranks_ + DIRECTIONS, -1 );
+      std::fill( ghost_offsets_, ghost_offsets_ + DIRECTIONS + 1, large_cast( 0 ) );
+   }
+
+   /** Default destructor. */
+   ~HaloExchange();
+
+   /** @} */
+
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the interaction cutoff.
+   *
+   *   \return   The cutoff.
+   */
+   inline FP_TYPE_T getCutoff() const   { return cutoff_; }
+
+   /** A function to obtain the direction of a neighbour from its offsets in the process grid.
+   *
+   *   \param dx   The offset along x, one of -1, 0 and 1.
+   *   \param dy   The offset along y, one of -1, 0 and 1.
+   *   \param dz   The offset along z, one of -1, 0 and 1.
+   *   \return     The direction.
+   */
+   static inline small_t getDirection( int dx, int dy, int dz ) {
+
+      SN_ASSERT( dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1 && dz >= -1 && dz <= 1 );
+      return small_cast( ( dx + 1 ) * 9 + ( dy + 1 ) * 3 + ( dz + 1 ) );
+   }
+
+   /** A function to obtain the rank of the neighbour in a direction at the last exchange.
+   *
+   *   \param direction   The direction.
+   *   \return            The rank, or -1 if there is no neighbour in this direction.
+   */
+   inline int getNeighbourRank( small_t direction ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( direction, DIRECTIONS );
+      return ranks_[direction];
+   }
+
+   /** A function to obtain the slots of the owned objects which were sent to the neighbour in a direction at the last exchange.
+   *
+   *   \param direction   The direction.
+   *   \return            The slots in the order of the ghosts on the neighbour.
+   */
+   inline const std::vector< large_t > & getSendSlots( small_t direction ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( direction, DIRECTIONS );
+      return send_slots_[direction];
+   }
+
+   /** A function to obtain the position of the first ghost from the neighbour in a direction among all ghosts of the last exchange. The
+   *   ghosts of the neighbour occupy the ghost positions [ getGhostOffset( direction ), getGhostOffset( direction + 1 ) ), so that the
+   *   first of them resides in the slot WorldKinematicsBB::getSize() + getGhostOffset( direction ).
+   *
+   *   \param direction   The direction, up to DIRECTIONS.
+   *   \return            The offset of the first ghost from the neighbour.
+   */
+   inline large_t getGhostOffset( small_t direction ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( direction, DIRECTIONS + 1 );
+      return ghost_offsets_[direction];
+   }
+
+   /** A function to obtain the slots of the owned objects which had no neighbour within the cutoff at the last exchange.
+   *
+   *   \return   The slots of the interior objects in ascending order.
+   */
+   inline const std::vector< large_t > & getInteriorSlots() const   { return interior_slots_; }
+
+   /** A function to obtain the slots of the owned objects which had a neighbour within the cutoff at the last exchange.
+   *
+   *   \return   The slots of the boundary objects in ascending order.
+   */
+   inline const std::vector< large_t > & getBoundarySlots() const   { return boundary_slots_; }
+
+   /** A function to find out whether an exchange has been begun but not finished.
+   *
+   *   \return   true if messages are in flight, false if not.
+   */
+   inline flag_t isPending() const   { return pending_; }
+
+   /** @} */
+
+   /** \name Primary functionality
+   *   @{
+   */
+   /** A function which selects the owned objects within the cutoff of the faces, edges and corners of the block of this process, sends their
+   *   positions to the respective neighbours and replaces the ghosts of the kinematics by the positions received from the neighbours. The
+   *   function must be called by all processes. Notes on exception safety: basic safety guaranteed. A PreconditionError exception is
+   *   thrown if the domain of the world has not been set up, an AllocError exception if the required resource allocation were not possible
+   *   and an MPIError exception if the communication failed.
+   *
+   *   \param world        The world, whose decomposition determines the neighbours and the block of this process.
+   *   \param kinematics   The kinematics of the objects of this process.
+   */
+   template< class KINEMATICS_BB >
+   void exchange( const World< FP_TYPE_T, KINEMATICS_BB > & world, WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      begin( world, kinematics );
+      finish( kinematics );
+   }
+
+   /** A function which discards the ghosts of the kinematics, selects the owned objects within the cutoff of the faces, edges and corners of
+   *   the block of this process, exchanges the number of ghosts with the neighbours and posts the non-blocking sends and receives of the 
+   *   positions. The owned positions must not change until finish has been called, and the creation or deletion of objects is not allowed
+   *   in between. The function must be called by all processes. Notes on exception safety: basic safety guaranteed. A PreconditionError
+   *   exception is thrown if the domain of the world has not been set up or if an exchange is pending, an AllocError exception if the
+   *   required resource allocation were not possible and an MPIError exception if the communication failed.
+   *
+   *   \param world        The world, whose decomposition determines the neighbours and the block of this process.
+   *   \param kinematics   The kinematics of the objects of this process.
+   */
+   template< class KINEMATICS_BB >
+   void begin( const World< FP_TYPE_T, KINEMATICS_BB > & world, WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      SN_ASSERT( world.isDomainInitialized() );
+      SN_ASSERT( ! pending_ );
+
+      #ifdef NDEBUG
+      if( ! world.isDomainInitialized() )
+         SN_THROW_PRECONDITION_ERROR( "PREC_HaloExchange_Domain_Error" );
+      if( pending_ )
+         SN_THROW_PRECONDITION_ERROR( "PREC_HaloExchange_Pending_Error" );
+      #endif
+
+      timer_ = ProcTimer();
+
+      kinematics.clearGhosts();
+
+      select( world, kinematics );
+      exchangeCounts();
+      postPositions( kinematics );
+
+      pending_ = true;
+   }
+
+   /** A function which waits for the positions posted by begin and appends them to the kinematics as ghosts. Notes on exception safety:
+   *   basic safety guaranteed. A PreconditionError exception is thrown if no exchange is pending, an AllocError exception if the required
+   *   resource allocation were not possible and an MPIError exception if the communication failed.
+   *
+   *   \param kinematics   The kinematics which were handed to begin.
+   */
+   void finish( WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      SN_ASSERT( pending_ );
+
+      #ifdef NDEBUG
+      if( ! pending_ )
+         SN_THROW_PRECONDITION_ERROR( "PREC_HaloExchange_Pending_Error" );
+      #endif
+
+      pending_ = false;
+      receivePositions( kinematics );
+
+      SN_LOG_REPORT_L2_EVENT( "Halo", "HaloExchange::finish received " << kinematics.getGhostCount() << " ghosts for "
+                                      << kinematics.getSize() << " objects in " << timer_.getAge() << " s" );
+   }
+
+   /** @} */
+
+private:
+
+   /* Selection of the objects within the cutoff of the boundary of the block, per neighbour. */
+   template< class KINEMATICS_BB >
+   void select( const World< FP_TYPE_T, KINEMATICS_BB > & world, const WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      const SoASpan3<const FP_TYPE_T> pos = kinematics.getPositionSpan();
+      const Vector3<FP_TYPE_T> corner = world.getDomainCorner();
+      const Vector3<FP_TYPE_T> extent = world.getDomainExtent();
+
+      FP_TYPE_T inner_lo[3], inner_hi[3];
+      for( small_t d = 0; d < 3; ++d ) {
+
+         inner_lo[d] = corner[d] + cutoff_;
+         inner_hi[d] = corner[d] + extent[d] - cutoff_;
+      }
+
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         ranks_[n] = ( n == 13 ) ? -1 : world.getNeighbourRank( int( n / 9 ) - 1, int( ( n / 3 ) % 3 ) - 1, int( n % 3 ) - 1 );
+         send_slots_[n].clear();
+      }
+
+      interior_slots_.clear();
+      boundary_slots_.clear();
+
+      try {
+         for( large_t i = 0; i < pos.size; ++i ) {
+
+            const FP_TYPE_T p[3] = { pos.x[i], pos.y[i], pos.z[i] };
+            int from[3], to[3];
+
+            for( small_t d = 0; d < 3; ++d ) {
+
+               from[d] = ( p[d] < inner_lo[d] ) ? -1 : 0;
+               to[d] = ( p[d] >= inner_hi[d] ) ? 1 : 0;
+            }
+
+            flag_t boundary = false;
+
+            if( from[0] != to[0] || from[1] != to[1] || from[2] != to[2] ) {
+
+               for( int dx = from[0]; dx <= to[0]; ++dx )
+                  for( int dy = from[1]; dy <= to[1]; ++dy )
+                     for( int dz = from[2]; dz <= to[2]; ++dz ) {
+
+                        const small_t n = getDirection( dx, dy, dz );
+                        if( ranks_[n] >= 0 ) {
+
+                           send_slots_[n].push_back( i );
+                           boundary = true;
+                        }
+                     }
+            }
+
+            if( boundary )
+               boundary_slots_.push_back( i );
+            else
+               interior_slots_.push_back( i );
+         }
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+   }
+
+   /* Exchange of the number of ghosts with every neighbour by persistent requests, which are set up anew if the neighbours change. The
+   *  send buffers are enlarged beforehand, which releases the position requests bound to them. */
+   void exchangeCounts() {
+
+      if( ! std::equal( ranks_, ranks_ + DIRECTIONS, bound_ranks_ ) )
+         bindCounts();
+
+      for( small_t k = 0; k < neighbour_count_; ++k ) {
+
+         const small_t n = neighbour_directions_[k];
+         const large_t send_count = send_slots_[n].size();
+
+         if( send_buffers_[n].getSize() < 3 * send_count ) {
+
+            send_requests_[n].freePersistent();
+            send_bound_[n] = 0;
+            send_buffers_[n].resize( std::max( 3 * send_count, 2 * send_buffers_[n].getSize() ) );
+         }
+
+         send_counts_[n].raw_ptr()[0] = send_count;
+      }
+
+      BaseComm< large_t >::startAll( int( neighbour_count_ ), count_recv_requests_ );
+      BaseComm< large_t >::startAll( int( neighbour_count_ ), count_send_requests_ );
+
+      BaseComm< large_t >::waitAll( DIRECTIONS, count_recv_requests_ );
+      BaseComm< large_t >::waitAll( DIRECTIONS, count_send_requests_ );
+   }
+
+   /* Set-up of the persistent requests of the counts, which occupy the first entries of their containers in the order of the directions.
+   *  The position requests of the previous neighbours are released and bound anew when they are first needed. */
+   void bindCounts() {
+
+      count_recv_requests_.freePersistent();
+      count_send_requests_.freePersistent();
+      neighbour_count_ = 0;
+
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         send_requests_[n].freePersistent();
+         recv_requests_[n].freePersistent();
+         send_bound_[n] = 0;
+         recv_bound_[n] = 0;
+
+         bound_ranks_[n] = ranks_[n];
+         if( ranks_[n] < 0 )
+            continue;
+
+         BaseComm< large_t >::receiveInit( recv_counts_[n], 1, ranks_[n], count_recv_requests_, neighbour_count_ );
+         BaseComm< large_t >::sendInit( send_counts_[n], ranks_[n], count_send_requests_, -1, neighbour_count_ );
+         neighbour_directions_[ neighbour_count_++ ] = n;
+      }
+   }
+
+   /* Start of the persistent receives and sends of the positions, which are bound anew if the number of ghosts has changed. */
+   void postPositions( const WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      const SoASpan3<const FP_TYPE_T> pos = kinematics.getPositionSpan();
+
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         ghost_offsets_[ n + 1 ] = ghost_offsets_[n];
+         if( ranks_[n] < 0 )
+            continue;
+
+         const large_t send_count = send_slots_[n].size();
+         const large_t recv_count = recv_counts_[n].raw_ptr()[0];
+         ghost_offsets_[ n + 1 ] += recv_count;
+
+         // Nothing is sent or received without ghosts. A message holds the positions of the ghosts and nothing else.
+         if( recv_count > 0 ) {
+
+            if( recv_bound_[n] != 3 * recv_count ) {
+
+               recv_requests_[n].freePersistent();
+               BaseComm< FP_TYPE_T >::receiveInit( recv_buffers_[n], int( 3 * recv_count ), ranks_[n], recv_requests_[n] );
+               recv_bound_[n] = 3 * recv_count;
+            }
+
+            BaseComm< FP_TYPE_T >::startAll( 1, recv_requests_[n] );
+         }
+
+         if( send_count > 0 ) {
+
+            if( send_bound_[n] != 3 * send_count ) {
+
+               send_requests_[n].freePersistent();
+               BaseComm< FP_TYPE_T >::sendInit( send_buffers_[n], ranks_[n], send_requests_[n], int( 3 * send_count ) );
+               send_bound_[n] = 3 * send_count;
+            }
+
+            FP_TYPE_T * buffer = send_buffers_[n].raw_ptr();
+            const large_t * slots = send_slots_[n].data();
+
+            for( large_t k = 0; k < send_count; ++k ) {
+
+               buffer[ 3 * k ] = pos.x[ slots[k] ];
+               buffer[ 3 * k + 1 ] = pos.y[ slots[k] ];
+               buffer[ 3 * k + 2 ] = pos.z[ slots[k] ];
+            }
+
+            BaseComm< FP_TYPE_T >::startAll( 1, send_requests_[n] );
+         }
+      }
+   }
+
+   /* Completion of the receives and the sends, and insertion of the positions as ghosts. */
+   void receivePositions( WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      for( small_t n = 0; n < DIRECTIONS; ++n )
+         if( ghost_offsets_[ n + 1 ] > ghost_offsets_[n] )
+            BaseComm< FP_TYPE_T >::template wait< MPIWaitOp::Receive >( recv_requests_[n] );
+
+      SoASpan3<FP_TYPE_T> ghosts = kinematics.allocateGhosts( ghost_offsets_[DIRECTIONS] );
+
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         const large_t offset = ghost_offsets_[n];
+         const large_t recv_count = ghost_offsets_[ n + 1 ] - offset;
+         const FP_TYPE_T * buffer = recv_buffers_[n].raw_ptr();
+
+         for( large_t k = 0; k < recv_count; ++k ) {
+
+            ghosts.x[ offset + k ] = buffer[ 3 * k ];
+            ghosts.y[ offset + k ] = buffer[ 3 * k + 1 ];
+            ghosts.z[ offset + k ] = buffer[ 3 * k + 2 ];
+         }
+      }
+
+      for( small_t n = 0; n < DIRECTIONS; ++n )
+         if( ranks_[n] >= 0 && ! send_slots_[n].empty() )
+            BaseComm< FP_TYPE_T >::template wait< MPIWaitOp::Send >( send_requests_[n] );
+   }
+
+   /* Members */
+   FP_TYPE_T cutoff_;                                        ///< The interaction cutoff.
+   int ranks_[DIRECTIONS];                                   ///< The rank of the neighbour in every direction, -1 if none.
+   std::vector< large_t > send_slots_[DIRECTIONS];           ///< The slots of the objects which are sent in every direction.
+   large_t ghost_offsets_[ DIRECTIONS + 1 ];                 ///< The offsets of the ghosts from every direction.
+   int bound_ranks_[DIRECTIONS];                             ///< The ranks to which the persistent count requests are bound.
+   small_t neighbour_directions_[DIRECTIONS] = {};           ///< The directions of the neighbours in the order of the count requests.
+   small_t neighbour_count_ = 0;                             ///< The number of neighbours.
+   std::vector< large_t > interior_slots_;                   ///< The slots of the objects without a neighbour within the cutoff.
+   std::vector< large_t > boundary_slots_;                   ///< The slots of the objects with a neighbour within the cutoff.
+   flag_t pending_ = false;                                  ///< Whether an exchange has been begun but not finished.
+   ProcTimer timer_;                                         ///< The timer of the pending exchange.
+
+   std::vector< FastBuffer< FP_TYPE_T > > send_buffers_;     ///< The packed positions which are sent in every direction.
+   std::vector< FastBuffer< FP_TYPE_T > > recv_buffers_;     ///< The packed positions which are received from every direction.
+   std::vector< FastBuffer< large_t > > send_counts_;        ///< The number of ghosts sent in every direction.
+   std::vector< FastBuffer< large_t > > recv_counts_;        ///< The number of ghosts received from every direction.
+   large_t send_bound_[DIRECTIONS] = {};                     ///< The size of the message to which every send is bound, zero if unbound.
+   large_t recv_bound_[DIRECTIONS] = {};                     ///< The size of the message to which every receive is bound, zero if unbound.
+
+   MPIRequest< FP_TYPE_T > send_requests_[DIRECTIONS];       ///< The persistent requests of the position sends, one per direction.
+   MPIRequest< FP_TYPE_T > recv_requests_[DIRECTIONS];       ///< The persistent requests of the position receives, one per direction.
+   MPIRequest< large_t > count_send_requests_{ DIRECTIONS }; ///< The persistent requests of the count sends, one per neighbour.
+   MPIRequest< large_t > count_recv_requests_{ DIRECTIONS }; ///< The persistent requests of the count receives, one per neighbour.
+};
+
+
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T > HaloExchange< FP_TYPE_T >::~HaloExchange() = default;
+
+template< typename FP_TYPE_T > constexpr small_t HaloExchange< FP_TYPE_T >::DIRECTIONS;
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -0,0 +1,516 @@
+#ifndef SN_OBJECTMIGRATION_HPP
+#define SN_OBJECTMIGRATION_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <Types.hpp>
+#include <Global.hpp>
+#include <BasicBases.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+#include <containers/mpi/FastBuffer.hpp>
+#include <containers/mpi/MPIRequest.hpp>
+
+#include <concurrency/OpenMP.hpp>
+#include <concurrency/BaseComm.hpp>
+
+#include <core/ProcTimer.hpp>
+
+#include <core/World.hpp>
+#include <core/kinematics/WorldKinematicsBB.hpp>
+
+#include <logger/Logger.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class ObjectMigration, which hands the objects which have left the block of a process over to the neighbouring processes.
+///   \file
+///   \addtogroup core Core
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class transfers the objects which have left the block of their process during integration to the neighbouring processes of the
+*   Cartesian process grid (see Simulator::setupDomains). It is meant to be called once per time step after WorldKinematicsBB::integrate
+*   and before the halo exchange (see HaloExchange).
+*
+*   A vectorized bounds test assigns every owned object the direction of the neighbour beyond the faces it has crossed. The faces of the
+*   block which lie on the boundary of the domain are never crossed, so that an object which leaves the domain stays with its process. The
+*   records of the leavers (see WorldKinematicsBB::packObject) are packed into one FastBuffer per neighbour, the number of leavers is
+*   exchanged with every neighbour by persistent requests (see BaseComm::sendInit) and the records with the neighbours which receive any. 
+*   The records travel by persistent requests as well, which are bound to the records of exactly the current number of leavers, so that no
+*   more than the live records are transferred, and which are set up anew whenever that number changes or the send buffer grows. Finally, the leavers are deleted in one step, which keeps the slots densely packed, and the arrivals are created. An object which has 
+*   moved further than one block is forwarded by the neighbour at the following steps.
+*
+*   An arrival is created anew, so that it receives a new handle, whose index may be that of a deleted object. Per-object data which the 
+*   user keeps outside of the kinematics, indexed by handle index, e.g. the masses of a force module, travels with the objects if it is 
+*   registered by setUserData.
+*
+*   All buffers persist between the calls and grow geometrically, and the kinematics is reserved for all arrivals at once, so that a step 
+*   allocates nothing once the traffic has settled. The directions are numbered as in HaloExchange.
+*
+*   \tparam FP_TYPE_T   The floating point type of the positions.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class ObjectMigration : private NonCopyable {
+
+   /* A friend indeed! The rebalancing moves objects with the same user data. */
+   template< typename FP_T, class KIN_BB > friend class Simulator;
+
+public:
+
+   /** The number of directions, including the process itself. */
+   static constexpr small_t DIRECTIONS = 27;
+
+   /** The direction of the process itself, i.e., of the objects which stay. */
+   static constexpr small_t STAY = 13;
+
+   /** This typedef identifies the function which writes the user data of a leaver into its record, before the leaver is deleted. */
+   using UserPacker = std::function< void( Object_ID_t , FP_TYPE_T * ) >;
+
+   /** This typedef identifies the function which reads the user data of an arrival from its record, after the arrival has been created. */
+   using UserUnpacker = std::function< void( Object_ID_t , const FP_TYPE_T * ) >;
+
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Default constructor. Notes on exception safety: strong safety guaranteed. The function throws an AllocError exception if the required
+   *   resource allocation were not possible.
+   */
+   ObjectMigration() {
+
+      SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >();
+
+      try {
+         send_buffers_.reserve( DIRECTIONS );
+         recv_buffers_.reserve( DIRECTIONS );
+         send_counts_.reserve( DIRECTIONS );
+         recv_counts_.reserve( DIRECTIONS );
+
+         for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+            send_buffers_.emplace_back( small_t( 1 ) );
+            recv_buffers_.emplace_back( small_t( 1 ) );
+            send_counts_.emplace_back( small_t( 1 ) );
+            recv_counts_.emplace_back( small_t( 1 ) );
+         }
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+
+      std::fill( ranks_, ranks_ + DIRECTIONS, -1 );
+      std::fill( bound_ranks_, bound_ranks_ + DIRECTIONS, -1 );
+   }
+
+   /** Default destructor. */
+   ~ObjectMigration();
+
+   /** @} */
+
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the number of objects which were sent to the neighbours at the last migration.
+   *
+   *   \return   The number of leavers.
+   */
+   inline large_t getSentCount() const       { return sent_; }
+
+   /** A function to obtain the number of objects which were received from the neighbours at the last migration.
+   *
+   *   \return   The number of arrivals.
+   */
+   inline large_t getReceivedCount() const   { return received_; }
+
+   /** @} */
+
+   /** \name User data
+   *   @{
+   */
+   /** A function which registers per-object data which is kept outside of the kinematics, so that it is transferred along with the 
+   *   objects. The record of every leaver is extended by the given number of values, which the packer fills in with the handle of the 
+   *   leaver. The unpacker is handed the new handle of the arrival, whose index may exceed the size of the arrays of the user (see 
+   *   WorldKinematicsBB::getIndexCount). The function must be called with the same number of values by all processes.
+   *
+   *   \param values   The number of values per object, zero to unregister.
+   *   \param pack     The packer.
+   *   \param unpack   The unpacker.
+   */
+   void setUserData( small_t values, UserPacker pack, UserUnpacker unpack ) {
+
+      SN_ASSERT( values == 0 || ( pack && unpack ) );
+
+      #ifdef NDEBUG
+      if( values > 0 && ! ( pack && unpack ) )
+         SN_THROW_INVALID_ARGUMENT( "IA_ObjectMigration_UserData" );
+      #endif
+
+      user_values_ = values;
+      user_pack_ = std::move( pack );
+      user_unpack_ = std::move( unpack );
+   }
+
+   /** A function to obtain the number of values of user data per object.
+   *
+   *   \return   The number of values which are appended to every record.
+   */
+   inline small_t getUserValueCount() const   { return user_values_; }
+
+   /** @} */
+
+   /** \name Primary functionality
+   *   @{
+   */
+   /** A function which sends the owned objects outside the block of this process to the respective neighbours and creates the objects
+   *   received from them. Ghosts are discarded. The function must be called by all processes. Notes on exception safety: basic safety
+   *   guaranteed. A PreconditionError exception is thrown if the domain of the world has not been set up, an AllocError exception if the
+   *   required resource allocation were not possible and an MPIError exception if the communication failed.
+   *
+   *   \param world        The world, whose decomposition determines the neighbours and the block of this process.
+   *   \param kinematics   The kinematics of the objects of this process.
+   *   \return             The number of objects which were received.
+   */
+   template< class KINEMATICS_BB >
+   large_t migrate( const World< FP_TYPE_T, KINEMATICS_BB > & world, WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      SN_ASSERT( world.isDomainInitialized() );
+
+      #ifdef NDEBUG
+      if( ! world.isDomainInitialized() )
+         SN_THROW_PRECONDITION_ERROR( "PREC_ObjectMigration_Domain_Error" );
+      #endif
+
+      ProcTimer timer;
+
+      kinematics.clearGhosts();
+
+      const large_t leavers = classify( world, kinematics );
+      pack( kinematics, leavers );
+      exchangeCounts();
+      exchangeRecords( kinematics );
+
+      SN_LOG_REPORT_L2_EVENT( "Migration", "ObjectMigration::migrate sent " << sent_ << " and received " << received_ << " objects in "
+                                           << timer.getAge() << " s" );
+      return received_;
+   }
+
+   /** @} */
+
+private:
+
+   /* The vectorized bounds test, which stores the direction of every owned object and returns the number of leavers. */
+   template< class KINEMATICS_BB >
+   large_t classify( const World< FP_TYPE_T, KINEMATICS_BB > & world, const WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      const SoASpan3<const FP_TYPE_T> pos = kinematics.getPositionSpan();
+      const large_t size = pos.size;
+      const Vector3<FP_TYPE_T> corner = world.getDomainCorner();
+      const Vector3<FP_TYPE_T> extent = world.getDomainExtent();
+
+      // The faces on the boundary of the domain are moved to infinity.
+      FP_TYPE_T lo[3], hi[3];
+      for( small_t d = 0; d < 3; ++d ) {
+
+         lo[d] = ( world.getProcessCoord( d ) > 0 ) ? corner[d] : std::numeric_limits< FP_TYPE_T >::lowest();
+         hi[d] = ( world.getProcessCoord( d ) + 1 < world.getProcessGridSize( d ) ) ? corner[d] + extent[d]
+                                                                                       : std::numeric_limits< FP_TYPE_T >::max();
+      }
+
+      for( small_t n = 0; n < DIRECTIONS; ++n )
+         ranks_[n] = ( n == STAY ) ? -1 : world.getNeighbourRank( int( n / 9 ) - 1, int( ( n / 3 ) % 3 ) - 1, int( n % 3 ) - 1 );
+
+      if( directions_.size() < size ) {
+
+         try {
+            directions_.resize( size + size / 8 );
+         }
+         catch( const std::bad_alloc & ) {
+            SN_THROW_ALLOC_ERROR();
+         }
+      }
+
+      const FP_TYPE_T * x = pos.x;
+      const FP_TYPE_T * y = pos.y;
+      const FP_TYPE_T * z = pos.z;
+      const FP_TYPE_T lo_x = lo[0], lo_y = lo[1], lo_z = lo[2];
+      const FP_TYPE_T hi_x = hi[0], hi_y = hi[1], hi_z = hi[2];
+      unsigned char * directions = directions_.data();
+      large_t leavers = 0;
+
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC OMP_REDUCTION( + : leavers ) )
+      for( large_t i = 0; i < size; ++i ) {
+
+         const int dx = int( x[i] >= hi_x ) - int( x[i] < lo_x );
+         const int dy = int( y[i] >= hi_y ) - int( y[i] < lo_y );
+         const int dz = int( z[i] >= hi_z ) - int( z[i] < lo_z );
+         const int n = ( dx + 1 ) * 9 + ( dy + 1 ) * 3 + ( dz + 1 );
+
+         directions[i] = static_cast< unsigned char >( n );
+         leavers += large_t( n != int( STAY ) );
+      }
+      SN_OPENMP_SYNC()
+
+      return leavers;
+   }
+
+   /* Collection of the leavers in ascending slot order and packing of their records per neighbour. */
+   void pack( const WorldKinematicsBB<FP_TYPE_T> & kinematics, large_t leavers ) {
+
+      const small_t state = kinematics.getRecordSize();
+      const small_t record = state + user_values_;
+      const large_t size = kinematics.getSize();
+      const unsigned char * directions = directions_.data();
+
+      std::fill( send_sizes_, send_sizes_ + DIRECTIONS, large_cast( 0 ) );
+      leavers_.clear();
+      sent_ = leavers;
+
+      if( leavers == 0 )
+         return;
+
+      try {
+         leavers_.reserve( leavers );
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+
+      for( large_t i = 0; i < size; ++i ) {
+
+         if( directions[i] != STAY ) {
+
+            leavers_.push_back( i );
+            ++send_sizes_[ directions[i] ];
+         }
+      }
+
+      // A buffer which grows releases the request which is bound to it.
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         SN_ASSERT( send_sizes_[n] == 0 || ranks_[n] >= 0 );
+         if( reserve( send_buffers_[n], send_sizes_[n] * record ) ) {
+
+            send_requests_[n].freePersistent();
+            send_bound_[n] = 0;
+         }
+         send_sizes_[n] = 0;
+      }
+
+      for( const large_t i : leavers_ ) {
+
+         const small_t n = directions[i];
+         FP_TYPE_T * values = send_buffers_[n].raw_ptr() + send_sizes_[n] * record;
+
+         kinematics.packObject( i, values );
+         if( user_values_ > 0 )
+            user_pack_( kinematics.getHandle( i ), values + state );
+         ++send_sizes_[n];
+      }
+   }
+
+   /* Exchange of the number of leavers with every neighbour by persistent requests, which are set up anew if the neighbours change. */
+   void exchangeCounts() {
+
+      if( ! std::equal( ranks_, ranks_ + DIRECTIONS, bound_ranks_ ) )
+         bindCounts();
+
+      for( small_t k = 0; k < neighbour_count_; ++k ) {
+
+         const small_t n = neighbour_directions_[k];
+         send_counts_[n].raw_ptr()[0] = send_sizes_[n];
+      }
+
+      BaseComm< large_t >::startAll( int( neighbour_count_ ), count_recv_requests_ );
+      BaseComm< large_t >::startAll( int( neighbour_count_ ), count_send_requests_ );
+
+      BaseComm< large_t >::waitAll( DIRECTIONS, count_recv_requests_ );
+      BaseComm< large_t >::waitAll( DIRECTIONS, count_send_requests_ );
+   }
+
+   /* Set-up of the persistent requests of the counts, which occupy the first entries of their containers in the order of the directions.
+   *  The record requests of the previous neighbours are released and bound anew when they are first needed. */
+   void bindCounts() {
+
+      count_recv_requests_.freePersistent();
+      count_send_requests_.freePersistent();
+      neighbour_count_ = 0;
+
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         send_requests_[n].freePersistent();
+         recv_requests_[n].freePersistent();
+         send_bound_[n] = 0;
+         recv_bound_[n] = 0;
+
+         bound_ranks_[n] = ranks_[n];
+         if( ranks_[n] < 0 )
+            continue;
+
+         BaseComm< large_t >::receiveInit( recv_counts_[n], 1, ranks_[n], count_recv_requests_, neighbour_count_ );
+         BaseComm< large_t >::sendInit( send_counts_[n], ranks_[n], count_send_requests_, -1, neighbour_count_ );
+         neighbour_directions_[ neighbour_count_++ ] = n;
+      }
+   }
+
+   /* Exchange of the records, deletion of the leavers and creation of the arrivals. */
+   void exchangeRecords( WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      const small_t state = kinematics.getRecordSize();
+      const small_t record = state + user_values_;
+      received_ = 0;
+
+      // Nothing is sent or received without leavers. A message holds the records of the leavers and nothing else.
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         if( ranks_[n] < 0 )
+            continue;
+
+         const large_t recv_size = recv_counts_[n].raw_ptr()[0];
+         const large_t recv_values = recv_size * record;
+         const large_t send_values = send_sizes_[n] * record;
+         received_ += recv_size;
+
+         if( recv_size > 0 ) {
+
+            if( recv_bound_[n] != recv_values ) {
+
+               recv_requests_[n].freePersistent();
+               BaseComm< FP_TYPE_T >::receiveInit( recv_buffers_[n], int( recv_values ), ranks_[n], recv_requests_[n] );
+               recv_bound_[n] = recv_values;
+            }
+
+            BaseComm< FP_TYPE_T >::startAll( 1, recv_requests_[n] );
+         }
+
+         if( send_sizes_[n] > 0 ) {
+
+            if( send_bound_[n] != send_values ) {
+
+               send_requests_[n].freePersistent();
+               BaseComm< FP_TYPE_T >::sendInit( send_buffers_[n], ranks_[n], send_requests_[n], int( send_values ) );
+               send_bound_[n] = send_values;
+            }
+
+            BaseComm< FP_TYPE_T >::startAll( 1, send_requests_[n] );
+         }
+      }
+
+      kinematics.deleteObjects( leavers_.data(), leavers_.size() );
+      kinematics.reserve( kinematics.getSize() + received_ );
+
+      for( small_t n = 0; n < DIRECTIONS; ++n ) {
+
+         if( ranks_[n] < 0 )
+            continue;
+
+         const large_t recv_size = recv_counts_[n].raw_ptr()[0];
+         if( recv_size > 0 ) {
+
+            BaseComm< FP_TYPE_T >::template wait< MPIWaitOp::Receive >( recv_requests_[n] );
+
+            // The arrivals from one neighbour are created at once and occupy the last slots.
+            try {
+               arrivals_.resize( recv_size );
+            }
+            catch( const std::bad_alloc & ) {
+               SN_THROW_ALLOC_ERROR();
+            }
+            kinematics.createObjects( recv_size, arrivals_.data() );
+
+            const FP_TYPE_T * buffer = recv_buffers_[n].raw_ptr();
+            const large_t first_slot = kinematics.getSize() - recv_size;
+            for( large_t k = 0; k < recv_size; ++k ) {
+
+               kinematics.unpackObject( first_slot + k, buffer + k * record );
+               if( user_values_ > 0 )
+                  user_unpack_( arrivals_[k], buffer + k * record + state );
+            }
+         }
+
+         if( send_sizes_[n] > 0 )
+            BaseComm< FP_TYPE_T >::template wait< MPIWaitOp::Send >( send_requests_[n] );
+      }
+   }
+
+   /* Geometric growth of a buffer to at least the required number of values, which returns whether the buffer has grown. */
+   static flag_t reserve( FastBuffer< FP_TYPE_T > & buffer, large_t values ) {
+
+      if( buffer.getSize() >= values )
+         return false;
+
+      buffer.resize( std::max( values, 2 * buffer.getSize() ) );
+      return true;
+   }
+
+   /* Members */
+   int ranks_[DIRECTIONS];                                   ///< The rank of the neighbour in every direction, -1 if none.
+   large_t send_sizes_[DIRECTIONS] = {};                     ///< The number of objects which are sent in every direction.
+   int bound_ranks_[DIRECTIONS];                             ///< The ranks to which the persistent count requests are bound.
+   small_t neighbour_directions_[DIRECTIONS] = {};           ///< The directions of the neighbours in the order of the count requests.
+   small_t neighbour_count_ = 0;                             ///< The number of neighbours.
+   std::vector< unsigned char > directions_;                 ///< The direction of every owned object.
+   std::vector< large_t > leavers_;                          ///< The slots of the leavers in ascending order.
+   std::vector< Object_ID_t > arrivals_;                     ///< The handles of the objects which arrived from one neighbour.
+   large_t sent_ = 0;                                        ///< The number of objects sent at the last migration.
+   large_t received_ = 0;                                    ///< The number of objects received at the last migration.
+   small_t user_values_ = 0;                                 ///< The number of values of user data per object.
+   UserPacker user_pack_;                                    ///< The packer of the user data.
+   UserUnpacker user_unpack_;                                ///< The unpacker of the user data.
+
+   std::vector< FastBuffer< FP_TYPE_T > > send_buffers_;     ///< The packed records which are sent in every direction.
+   std::vector< FastBuffer< FP_TYPE_T > > recv_buffers_;     ///< The packed records which are received from every direction.
+   std::vector< FastBuffer< large_t > > send_counts_;        ///< The number of objects sent in every direction.
+   std::vector< FastBuffer< large_t > > recv_counts_;        ///< The number of objects received from every direction.
+   large_t send_bound_[DIRECTIONS] = {};                     ///< The size of the message to which every send is bound, zero if unbound.
+   large_t recv_bound_[DIRECTIONS] = {};                     ///< The size of the message to which every receive is bound, zero if unbound.
+
+   MPIRequest< FP_TYPE_T > send_requests_[DIRECTIONS];       ///< The persistent requests of the record sends.
+   MPIRequest< FP_TYPE_T > recv_requests_[DIRECTIONS];       ///< The persistent requests of the record receives.
+   MPIRequest< large_t > count_send_requests_{ DIRECTIONS }; ///< The persistent requests of the count sends, one per neighbour.
+   MPIRequest< large_t > count_recv_requests_{ DIRECTIONS }; ///< The persistent requests of the count receives, one per neighbour.
+};
+
+
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T > ObjectMigration< FP_TYPE_T >::~ObjectMigration() = default;
+
+template< typename FP_TYPE_T > constexpr small_t ObjectMigration< FP_TYPE_T >::DIRECTIONS;
+template< typename FP_TYPE_T > constexpr small_t ObjectMigration< FP_TYPE_T >::STAY;
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -1,5 +1,6 @@
 #include "ProcSingleton.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <ctime>
@@ -110,10 +111,17 @@ void ProcSingleton::init( int argc, char ** argv, uint_t thread_count ) {
       
       int prov = 0;
       
-      info = MPI_Init_thread( &argc, &argv, MPI_THREAD_SERIALIZED, &prov );   // <---------------- MPI_Init for multithreading
+      // The threads either take turns in communicating or, if opted for, communicate concurrently on their own communicators.
+      #ifdef __SN_USE_MPI_THREAD_MULTIPLE__
+      const int required = MPI_THREAD_MULTIPLE;
+      #else
+      const int required = MPI_THREAD_SERIALIZED;
+      #endif
+      
+      info = MPI_Init_thread( &argc, &argv, required, &prov );   // <---------------- MPI_Init for multithreading
       
-      // Full thread support acquired? Maybe a problem with init?
-      if( prov != MPI_THREAD_SERIALIZED || info != MPI_SUCCESS ) {
+      // Full thread support acquired? Maybe a problem with init? The thread support levels are ordered.
+      if( prov < required || info != MPI_SUCCESS ) {
        
          std::cerr << "[PROCMAN__>][ERROR ]:   The MPI Manager could not be initialized with thread support. The program will now exit. "
                    << std::endl;
@@ -173,6 +181,30 @@ void ProcSingleton::init( int argc, char ** argv, uint_t thread_count ) {
       
       MPI_Comm_size( MPI_COMM_WORLD, & getPrivateInstance().comm_size_ );
       MPI_Comm_rank( MPI_COMM_WORLD, & getPrivateInstance().comm_rank_ );
+      
+      #if defined( __SN_USE_MPI_THREAD_MULTIPLE__ ) && defined( __SN_USE_OPENMP__ )
+      // One communicator per thread, so that the threads neither contend for locks nor match each other's messages
+      std::vector< MPI_Comm > & comms = getPrivateInstance().thread_comms_;
+      comms.assign( static_cast< size_t >( std::max( getPrivateInstance().omp_thread_size_, 1 ) ), MPI_COMM_NULL );
+      
+      for( MPI_Comm & comm : comms ) {
+         
+         if( MPI_Comm_dup( MPI_COMM_WORLD, &comm ) != MPI_SUCCESS ) {
+            
+            std::cerr << "[PROCMAN__>][ERROR ]:   The communicators of the threads could not be created. The program will now exit. "
+                      << std::endl;
+            
+            ////////////////////////////
+            //   EXIT POINT!
+            ExitProgram();
+            ////////////////////////////
+         }
+      }
+      
+      SN_MPI_ROOTPROC_REGION() {
+         std::cout << "[PROCMAN__>][ROOTPROC][EVENT ]:   " << comms.size() << " threads communicate concurrently. " << std::endl << std::endl;
+      }
+      #endif
 
       #endif   // Using MPI at all?
       
@@ -191,6 +223,18 @@ ProcSingleton::~ProcSingleton() {
    #ifdef __SN_USE_MPI__
    if( getPrivateInstance().is_initialized_with_multithreading_ || getPrivateInstance().is_initialized_ ) {
 
+      if( cart_comm_ != MPI_COMM_NULL )
+         MPI_Comm_free( &cart_comm_ );
+      
+      if( neighbour_comm_ != MPI_COMM_NULL )
+         MPI_Comm_free( &neighbour_comm_ );
+      
+      for( MPI_Comm & comm : thread_comms_ ) {
+         if( comm != MPI_COMM_NULL )
+            MPI_Comm_free( &comm );
+      }
+      thread_comms_.clear();
+      
       MPI_Finalize();
       std::cout << "[" << std::setprecision(2) << std::fixed << getPrivateInstance().timer_.getAge() * real_cast(1e+3) << " ms]"
                 << std::ends;
@@ -2,6 +2,7 @@
 #define SN_PROCSINGLETON_HPP
 
 #include <chrono>
+#include <vector>
 
 #include <Types.hpp>
 #include <BasicBases.hpp>
@@ -13,6 +14,10 @@
    #include <mpi.h>
 #endif
 
+#ifdef __SN_USE_OPENMP__
+   #include <omp.h>
+#endif
+
 //==========================================================================================================================================
 //
 //  This file is part of simpleNewton. simpleNewton is free software: you can 
@@ -93,6 +98,50 @@ public:
    */
    static inline int getCommRank()   { return getPrivateInstance().comm_rank_; }
    
+   #ifdef __SN_USE_MPI__
+   /** A function to obtain the Cartesian communicator of the process grid (see Simulator::setupDomains). The ranks in the communicator
+   *   are the ranks in MPI_COMM_WORLD.
+   *
+   *   \return   The Cartesian communicator, or MPI_COMM_NULL if the domains have not been set up.
+   */
+   static inline MPI_Comm getCartComm()   { return getPrivateInstance().cart_comm_; }
+   
+   /** A function to obtain the neighbourhood communicator of the process grid (see Simulator::setupDomains). It is a distributed graph
+   *   which connects every block with the blocks it shares a face, an edge or a corner with, so that neighbourhood collectives (see 
+   *   BaseComm::neighbourAlltoall) reach all of them. The neighbours are ordered by their direction index (dx+1)*9 + (dy+1)*3 + (dz+1), 
+   *   leaving out the offsets which leave the grid. The ranks in the communicator are the ranks in MPI_COMM_WORLD.
+   *
+   *   \return   The neighbourhood communicator, or MPI_COMM_NULL if the domains have not been set up.
+   */
+   static inline MPI_Comm getNeighbourComm()   { return getPrivateInstance().neighbour_comm_; }
+   
+   /** A function to find out whether MPI has been initialized with MPI_THREAD_MULTIPLE (see the CMake option 
+   *   SN_USE_MPI_THREAD_MULTIPLE), i.e., whether several threads may communicate at the same time.
+   *
+   *   \return   True if the threads communicate concurrently, false if their communication is serialized.
+   */
+   static inline bool isThreadMultiple()   { return ! getPrivateInstance().thread_comms_.empty(); }
+   
+   /** A function to obtain the communicator on which the calling thread communicates. With MPI_THREAD_MULTIPLE, every OpenMP thread has 
+   *   its own duplicate of MPI_COMM_WORLD, so that the messages of different threads never match each other. A message sent by a thread
+   *   is therefore received by the thread with the same number on the target process. Threads beyond the number of threads at 
+   *   initialization, and all threads without MPI_THREAD_MULTIPLE, communicate on MPI_COMM_WORLD. The ranks are those in MPI_COMM_WORLD.
+   *
+   *   \return   The communicator of the calling thread.
+   */
+   static inline MPI_Comm getThreadComm() {
+      
+      #if defined( __SN_USE_MPI_THREAD_MULTIPLE__ ) && defined( __SN_USE_OPENMP__ )
+      const std::vector< MPI_Comm > & comms = getPrivateInstance().thread_comms_;
+      const size_t thread = static_cast< size_t >( omp_get_thread_num() );
+      if( thread < comms.size() )
+         return comms[thread];
+      #endif
+      
+      return MPI_COMM_WORLD;
+   }
+   #endif
+   
    /** @} */
    
    /** \name Timer
@@ -143,11 +192,7 @@ private:
    *   \return   A reference to the world.
    */
    template< typename FP_TYPE_T, class KINEMATICS_BB >
-   static inline World< FP_TYPE_T, KINEMATICS_BB > & getWorld() {
-      
-      static World< FP_TYPE_T, KINEMATICS_BB > singleWorld;
-      return singleWorld;
-   }
+   static World< FP_TYPE_T, KINEMATICS_BB > & getWorld();
    
    /** @} */
    
@@ -165,10 +210,32 @@ private:
    
    /** Thread size */
    int omp_thread_size_ = 0;
+   
+   #ifdef __SN_USE_MPI__
+   /** Cartesian communicator of the process grid */
+   MPI_Comm cart_comm_ = MPI_COMM_NULL;
+   
+   /** Distributed graph communicator of the neighbouring blocks */
+   MPI_Comm neighbour_comm_ = MPI_COMM_NULL;
+   
+   /** Communicators of the threads with MPI_THREAD_MULTIPLE, empty otherwise */
+   std::vector< MPI_Comm > thread_comms_;
+   #endif
 };
 
 
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T, class KINEMATICS_BB >
+World< FP_TYPE_T, KINEMATICS_BB > & ProcSingleton::getWorld() {
+   
+   static World< FP_TYPE_T, KINEMATICS_BB > singleWorld;
+   return singleWorld;
+}
+#endif   // DOXYSKIP
+
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //   Scope Macros and important global functions
 /////////////////////////////////////////////////
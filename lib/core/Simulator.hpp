@@ -1,6 +1,10 @@
 #ifndef SN_SIMULATOR_HPP
 #define SN_SIMULATOR_HPP
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include <Global.hpp>
 #include <Types.hpp>
 #include <BasicBases.hpp>
@@ -10,8 +14,13 @@
 
 #include <containers/Vector3.hpp>
 
+#include <concurrency/BaseComm.hpp>
+
 #include <core/Exceptions.hpp>
 #include <core/ProcSingleton.hpp>
+#include <core/ProcTimer.hpp>
+#include <core/HaloExchange.hpp>
+#include <core/ObjectMigration.hpp>
 
 #include "kinematics/AllWKBBs.hpp"
 
@@ -43,14 +52,16 @@
 /** The space in which all global entities of the framework are accessible */
 namespace simpleNewton {
 
+/** This enumeration identifies the measure of the cost of a process by which the load is balanced (see Simulator::balanceLoad). */
+enum class LoadMeasure {
+   
+   ObjectCount,   ///< The number of objects owned by the process.
+   WorkTime       ///< The work time recorded by the process, distributed evenly over its objects.
+};
+
 template< typename FP_TYPE_T, class KINEMATIC_BB >
 class Simulator : private NonInstantiable {
 
-   static void performTimeStep( small_t ) {
-   
-      
-   }
-   
 public:
    
    /** This typedef identifies the type of kinematic engine being used. */
@@ -59,69 +70,556 @@ public:
    /** This typedef identifies the floating point precision being employed for the simulation. */
    using precType = FP_TYPE_T;
    
-   static void setupDomains( Vector3<precType> && diag ) {
+   /** A function which decomposes the domain into a Cartesian grid of equally sized blocks, one per process. Among all factorizations of
+   *   the number of processes, the grid whose blocks have the smallest surface, and with it the least halo traffic, for the aspect ratio
+   *   of the domain is chosen. If a cutoff is provided, grids whose blocks are thinner than the cutoff along any dimension are avoided
+   *   where possible. The grid is registered with MPI as a non-periodic Cartesian communicator (see ProcSingleton::getCartComm), and the 
+   *   26 neighbourhoods of the blocks as a distributed graph communicator (see ProcSingleton::getNeighbourComm). Notes on exception 
+   *   safety: basic safety guaranteed. An InvalidArgument exception is thrown if the diagonal is not positive or the cutoff is negative, 
+   *   and an MPIError exception if the communicators could not be created.
+   *
+   *   \param diag     The extent of the whole domain.
+   *   \param cutoff   The interaction cutoff, zero if there is none.
+   */
+   static void setupDomains( Vector3<precType> && diag, precType cutoff = precType( 0 ) ) {
       
-      // Check the argument for validity
+      // Check the arguments for validity
       SN_ASSERT_POSITIVE( diag );
+      SN_ASSERT( cutoff >= precType( 0 ) );
       
       #ifdef NDEBUG
-      if( diag <= 0 )
-         SN_THROW_INVALID_ARGUMENT( "IA_Domain_Diagonal_Error" )
+      if( diag <= 0 || cutoff < precType( 0 ) )
+         SN_THROW_INVALID_ARGUMENT( "IA_Domain_Diagonal_Error" );
       #endif
       
-      small_t num_proc = SN_MPI_SIZE();
-      small_t proc_rank = SN_MPI_RANK();
+      auto & world = ProcSingleton::getWorld< precType, kinematicsType >();
+      const small_t num_proc = small_cast( std::max( SN_MPI_SIZE(), 1 ) );
+      const int proc_rank = SN_MPI_RANK();
       
-      if( num_proc > 1 ) {
-      precType longest_dimension = diag.infinityNorm();
+      small_t grid[3] = { 1, 1, 1 };
+      if( ! chooseProcessGrid( diag, num_proc, cutoff, grid ) ) {
+         SN_LOG_REPORT_WARNING( "No grid of " << num_proc << " processes has blocks which are thicker than the cutoff " << cutoff
+                                << ". The grid " << grid[0] << "x" << grid[1] << "x" << grid[2] << " will be used." );
+      }
+      
+      int coords[3] = { 0, 0, 0 };
+      int neighbours[27];
+      std::fill( neighbours, neighbours + 27, -1 );
+      neighbours[13] = proc_rank;
+      
+      #ifdef __SN_USE_MPI__
+      if( SN_MPI_INITIALIZED() ) {
+         
+         // All dimensions are fixed, so that MPI_Dims_create merely validates the factorization. The ranks are not reordered, since the
+         // point-to-point communication uses MPI_COMM_WORLD.
+         int dims[3] = { int( grid[0] ), int( grid[1] ), int( grid[2] ) };
+         int periods[3] = { 0, 0, 0 };
+         MPI_Comm & cart = ProcSingleton::getPrivateInstance().cart_comm_;
+         MPI_Comm & graph = ProcSingleton::getPrivateInstance().neighbour_comm_;
+         
+         if( cart != MPI_COMM_NULL )
+            MPI_Comm_free( &cart );
+         if( graph != MPI_COMM_NULL )
+            MPI_Comm_free( &graph );
+         
+         int info = MPI_Dims_create( int( num_proc ), 3, dims );
+         if( info == MPI_SUCCESS )
+            info = MPI_Cart_create( MPI_COMM_WORLD, 3, dims, periods, 0, &cart );
+         if( info == MPI_SUCCESS )
+            info = MPI_Cart_coords( cart, proc_rank, 3, coords );
+         
+         for( int n = 0; n < 27 && info == MPI_SUCCESS; ++n ) {
+            
+            const int nc[3] = { coords[0] + n / 9 - 1, coords[1] + ( n / 3 ) % 3 - 1, coords[2] + n % 3 - 1 };
+            if( nc[0] >= 0 && nc[0] < dims[0] && nc[1] >= 0 && nc[1] < dims[1] && nc[2] >= 0 && nc[2] < dims[2] )
+               info = MPI_Cart_rank( cart, nc, &neighbours[n] );
+         }
+         
+         // The neighbourhoods are symmetric, hence every block both sends to and receives from its neighbours in direction order.
+         int adjacent[26];
+         int degree = 0;
+         for( int n = 0; n < 27; ++n ) {
+            if( n != 13 && neighbours[n] >= 0 )
+               adjacent[degree++] = neighbours[n];
+         }
+         
+         if( info == MPI_SUCCESS )
+            info = MPI_Dist_graph_create_adjacent( MPI_COMM_WORLD, degree, adjacent, MPI_UNWEIGHTED, degree, adjacent, MPI_UNWEIGHTED, 
+                                                   MPI_INFO_NULL, 0, &graph );
+         
+         if( info != MPI_SUCCESS )
+            SN_THROW_MPI_ERROR( "MPI_Cart_create_Error" );
+      }
+      #endif
       
-      if( std::fabs(diag.at(0) - longest_dimension) <= globalConstants::ZERO )
-         ProcSingleton::getWorld< precType, kinematicsType >().parallel_dimension_ = 0;
+      // Uniform block boundaries along each dimension
+      for( small_t d = 0; d < 3; ++d ) {
          
-      else if( std::fabs(diag.at(1) - longest_dimension) <= globalConstants::ZERO )
-         ProcSingleton::getWorld< precType, kinematicsType >().parallel_dimension_ = 1;
+         world.process_grid_[d] = grid[d];
+         world.process_coords_[d] = small_cast( coords[d] );
+         world.boundaries_[d].resize( grid[d] + 1 );
          
-      else if( std::fabs(diag.at(2) - longest_dimension) <= globalConstants::ZERO )
-         ProcSingleton::getWorld< precType, kinematicsType >().parallel_dimension_ = 2;
+         for( small_t i = 0; i < grid[d]; ++i )
+            world.boundaries_[d][i] = diag[d] * precType( i ) / precType( grid[d] );
+         world.boundaries_[d][ grid[d] ] = diag[d];
+      }
+      std::copy( neighbours, neighbours + 27, world.neighbour_ranks_ );
       
-      ProcSingleton::getWorld< precType, kinematicsType >().domain_ = std::move( diag );
-
-      // Split up the parallel dimension into equal sized blocks -> worlds.
-      precType block_side_length = longest_dimension / num_proc;
-
-      ProcSingleton::getWorld< precType, kinematicsType >().domain_.at( 
-      ProcSingleton::getWorld< precType, kinematicsType >().parallel_dimension_ ) = block_side_length;
-
-      ProcSingleton::getWorld< precType, kinematicsType >().domain_offset_ = proc_rank * block_side_length;
+      world.global_domain_ = std::move( diag );
+      updateBlock( world );
       
       // Paranoia! After all, that's what asserts are for!
-      SN_ASSERT( ProcSingleton::getWorld< precType, kinematicsType >().parallel_dimension_ > small_cast(-1) &&
-                 ProcSingleton::getWorld< precType, kinematicsType >().parallel_dimension_ < small_cast(3) );
+      SN_ASSERT_POSITIVE( world.domain_ );
+      
+      SN_LOG_REPORT_L2_EVENT( "Domains", "Simulator::setupDomains chose the process grid " << grid[0] << "x" << grid[1] << "x" << grid[2]
+                                         << ", this process owns block ( " << coords[0] << ", " << coords[1] << ", " << coords[2] << " )" );
+      
+      // Fly the flag!
+      world.domain_initialized_ = true;
+   }
+   
+   
+   
+   /** A function to obtain the world of the simulation.
+   *
+   *   \return   A const qualified reference to the world.
+   */
+   static inline const World< precType, kinematicsType > & getWorld() {
+      return ProcSingleton::getWorld< precType, kinematicsType >();
+   }
+   
+   /** A function which adds to the work time of this process, e.g., the duration of the force computation as measured by a ProcTimer.
+   *   The work time is the cost of the process if the load is balanced by LoadMeasure::WorkTime.
+   *
+   *   \param seconds   The duration of the work.
+   */
+   static inline void recordWorkTime( real_t seconds ) {
+      
+      SN_ASSERT( seconds >= real_cast( 0 ) );
+      ProcSingleton::getWorld< precType, kinematicsType >().work_time_ += seconds;
+   }
+   
+   /** A function which measures the load imbalance of the processes and, if it exceeds a threshold, moves the block boundaries such that
+   *   every process receives the same share of the total cost, and then migrates the objects to their new owners. The boundaries along
+   *   each dimension are placed at the quantiles of the global cost histogram along that dimension, i.e., the cost is bisected along every
+   *   axis, while the blocks remain a tensor-product grid. The Cartesian neighbourhood of every process is therefore preserved. The blocks 
+   *   are kept at least as thick as the provided extent along every dimension. The recorded work time is reset. The function must be 
+   *   called by all processes. Notes on exception safety: basic safety guaranteed. A PreconditionError exception is thrown if the domain 
+   *   has not been set up, an AllocError exception if the required resource allocation were not possible and an MPIError exception if the 
+   *   communication failed. Objects which migrate receive new handles on their new owner, and the per-object data which the user has 
+   *   registered with the migration of the time steps (see ObjectMigration::setUserData) is transferred along with them.
+   *
+   *   \param kinematics   The kinematics of the objects of this process.
+   *   \param measure      The measure of the cost of a process.
+   *   \param threshold    The imbalance, i.e., the ratio of the largest to the average cost minus one, above which the load is balanced.
+   *   \param min_extent   The smallest extent of a block along any dimension, usually the interaction cutoff.
+   *   \param migration    The migration whose user data is transferred, nullptr if there is none.
+   *   \return             true if the load was balanced, false if not.
+   */
+   static flag_t balanceLoad( WorldKinematicsBB< precType > & kinematics, LoadMeasure measure = LoadMeasure::ObjectCount, 
+                              real_t threshold = real_cast( 0.1 ), precType min_extent = precType( 0 ), 
+                              const ObjectMigration< precType > * migration = nullptr ) {
+      
+      auto & world = ProcSingleton::getWorld< precType, kinematicsType >();
+      
+      SN_ASSERT( world.domain_initialized_ );
+      SN_ASSERT( threshold >= real_cast( 0 ) );
+      
+      #ifdef NDEBUG
+      if( ! world.domain_initialized_ )
+         SN_THROW_PRECONDITION_ERROR( "PREC_Domain_Initialization_Error" );
+      #endif
+      
+      const large_t size = kinematics.getSize();
+      const real_t cost = ( measure == LoadMeasure::ObjectCount ) ? real_cast( size ) : world.work_time_;
+      const real_t weight = ( measure == LoadMeasure::ObjectCount || size == 0 ) ? real_cast( 1 ) : world.work_time_ / real_cast( size );
+      
+      world.work_time_ = real_cast( 0 );
+      
+      const small_t num_proc = world.process_grid_[0] * world.process_grid_[1] * world.process_grid_[2];
+      if( num_proc == 1 ) {
+         
+         world.load_imbalance_ = real_cast( 0 );
+         return false;
       }
-      else {   // single process mode
-         ProcSingleton::getWorld< precType, kinematicsType >().domain_ = std::move( diag );
+      
+      #ifdef __SN_USE_MPI__
+      ProcTimer timer;
+      
+      // The imbalance is measured by the largest and the total cost, whose reductions are in flight at the same time.
+      FastBuffer< real_t > local_cost( 1, cost ), max_cost( 1 ), total_cost( 1 );
+      MPIRequest< real_t > max_request, total_request;
+      BaseComm< real_t >::allreduce< MPIReduceMode::Immediate >( local_cost, max_cost, MPIReduceOp::Max, max_request );
+      BaseComm< real_t >::allreduce< MPIReduceMode::Immediate >( local_cost, total_cost, MPIReduceOp::Sum, total_request );
+      BaseComm< real_t >::wait< MPIWaitOp::Collective >( max_request );
+      BaseComm< real_t >::wait< MPIWaitOp::Collective >( total_request );
+      
+      const real_t average_cost = total_cost[0] / real_cast( num_proc );
+      world.load_imbalance_ = ( average_cost > real_cast( 0 ) ) ? max_cost[0] / average_cost - real_cast( 1 ) : real_cast( 0 );
+      
+      if( world.load_imbalance_ <= threshold )
+         return false;
+      
+      // Place the cuts along each dimension at the quantiles of the global cost histogram.
+      const SoASpan3< const precType > pos = kinematics.getPositionSpan();
+      const precType * component[3] = { pos.x, pos.y, pos.z };
+      
+      // The histogram is reduced in place, i.e., it is both the send and the receive buffer of the reduction.
+      FastBuffer< real_t > histogram( small_t( 1 ) );
+      for( small_t d = 0; d < 3; ++d ) {
+         
+         const small_t blocks = world.process_grid_[d];
+         if( blocks == 1 )
+            continue;
+         
+         const large_t bins = large_cast( blocks ) * HISTOGRAM_BINS_PER_BLOCK;
+         const precType extent = world.global_domain_[d];
+         
+         histogram.resize( bins );
+         real_t * cost_of = histogram.raw_ptr();
+         
+         for( large_t i = 0; i < size; ++i ) {
+            
+            const precType t = component[d][i] / extent * precType( bins );
+            const large_t bin = ( t <= precType( 0 ) ) ? 0 : std::min( large_cast( t ), bins - 1 );
+            cost_of[bin] += weight;
+         }
+         
+         BaseComm< real_t >::allreduce( histogram, histogram, MPIReduceOp::Sum );
+         
+         placeCuts( histogram, extent, min_extent, world.boundaries_[d] );
       }
       
-      // Paranoia! After all, that's what asserts are for!
-      SN_ASSERT_POSITIVE( ProcSingleton::getWorld< precType, kinematicsType >().domain_ );
+      updateBlock( world );
+      migrateObjects( kinematics, migration );
       
-      // Fly the flag!
-      ProcSingleton::getWorld< precType, kinematicsType >().domain_initialized_ = true;
+      SN_LOG_REPORT_L2_EVENT( "Domains", "Simulator::balanceLoad moved the block boundaries at an imbalance of " << world.load_imbalance_
+                                         << ", this process now owns " << kinematics.getSize() << " objects (" << timer.getAge() << " s)" );
+      return true;
+      
+      #else
+      (void) cost; (void) weight; (void) min_extent; (void) migration;
+      return false;
+      #endif
    }
    
    
    
-   static void simulate( precType _totalTime, precType _max_resolution ) {
+   /** A function which advances the objects of this process by one time step. The halo exchange is begun first, and the forces on the 
+   *   interior objects are computed from the owned positions while the positions of the boundary objects are in flight to the neighbours.
+   *   Once all ghosts have arrived, the forces on the boundary objects are computed from the owned positions and the ghosts. Finally, the
+   *   objects are integrated, and those which have left the block of this process are migrated to the neighbours. The duration of the 
+   *   force computation and of the integration is recorded as work time (see recordWorkTime). The function must be called by all 
+   *   processes. The force kernel is evaluated once per step, so that integrators which evaluate the forcing at intermediate stages, i.e.,
+   *   RungeKutta4WKBB, are rejected. VelocityVerletWKBB is opened before the forces are computed, so that the forces are those of the 
+   *   drifted positions and the closing half-kick uses them (see VelocityVerletWKBB::openStep and closeStep). Its forcing is not evaluated, 
+   *   and the accelerations of the initial positions have to have been set before the first step. Notes on exception safety: basic safety 
+   *   guaranteed. A PreconditionError exception is thrown if the domain has not been set up, an InvalidArgument exception if the 
+   *   kinematics are those of RungeKutta4WKBB, an AllocError exception if the required resource allocation were not possible and an 
+   *   MPIError exception if the communication failed.
+   *
+   *   \tparam FORCE_KERNEL   A callable with the signature void( WorldKinematicsBB<precType> & kinematics, const std::vector< large_t > &
+   *                          targets, SoASpan3<const precType> sources ), which writes the accelerations of the objects in the target slots
+   *                          due to the objects in the source slots. It must neither create nor delete objects.
+   *   \param kinematics      The kinematics of the objects of this process.
+   *   \param halo            The halo exchange, whose cutoff is the interaction cutoff of the force kernel.
+   *   \param migration       The migration of the objects between the processes.
+   *   \param forces          The force kernel.
+   */
+   template< class FORCE_KERNEL >
+   static void performTimeStep( WorldKinematicsBB< precType > & kinematics, HaloExchange< precType > & halo, 
+                                ObjectMigration< precType > & migration, FORCE_KERNEL && forces ) {
+      
+      const auto & world = ProcSingleton::getWorld< precType, kinematicsType >();
+      
+      // The stages of the Runge-Kutta method would need the forces of the stage positions, including those of the ghosts.
+      SN_ASSERT( dynamic_cast< RungeKutta4WKBB< precType > * >( &kinematics ) == nullptr );
+      
+      #ifdef NDEBUG
+      if( dynamic_cast< RungeKutta4WKBB< precType > * >( &kinematics ) != nullptr )
+         SN_THROW_INVALID_ARGUMENT( "IA_TimeStep_Integrator_Error" );
+      #endif
+      
+      // Velocity Verlet drifts first, so that the forces of this step are those which its closing half-kick needs.
+      VelocityVerletWKBB< precType > * verlet = dynamic_cast< VelocityVerletWKBB< precType > * >( &kinematics );
+      if( verlet != nullptr )
+         verlet->openStep();
       
-      small_t tsCount = small_cast( _totalTime / _max_resolution );
+      halo.begin( world, kinematics );
+      
+      // The interior objects interact with owned objects only, so that the ghosts are not needed yet.
+      ProcTimer interior_timer;
+      forces( kinematics, halo.getInteriorSlots(), kinematics.getPositionSpan() );
+      recordWorkTime( interior_timer.getAge() );
+      
+      halo.finish( kinematics );
+      
+      ProcTimer boundary_timer;
+      forces( kinematics, halo.getBoundarySlots(), kinematics.getHaloPositionSpan() );
+      if( verlet != nullptr )
+         verlet->closeStep();
+      else
+         kinematics.integrate();
+      recordWorkTime( boundary_timer.getAge() );
+      
+      migration.migrate( world, kinematics );
+   }
+   
+   /** A function which performs all time steps of a simulation (see performTimeStep). The time step of the kinematics is set to the 
+   *   given one, and the number of steps is the simulated time divided by the time step, rounded to the nearest integer. Notes on 
+   *   exception safety: basic safety guaranteed. An InvalidArgument exception is thrown if the time step is not positive or the simulated
+   *   time is negative, besides the exceptions of performTimeStep. The halo exchange and the migration are provided by the caller, so 
+   *   that the per-object data which the user has registered with the migration (see ObjectMigration::setUserData) travels along with 
+   *   the objects, and so that their buffers and requests outlive the simulation.
+   *
+   *   \tparam FORCE_KERNEL      The type of the force kernel.
+   *   \param kinematics         The kinematics of the objects of this process.
+   *   \param halo               The halo exchange, whose cutoff is the interaction cutoff of the force kernel.
+   *   \param migration          The migration of the objects between the processes.
+   *   \param forces             The force kernel.
+   *   \param _totalTime         The simulated time.
+   *   \param _max_resolution    The time step, which the kinematics are given.
+   */
+   template< class FORCE_KERNEL >
+   static void simulate( WorldKinematicsBB< precType > & kinematics, HaloExchange< precType > & halo, 
+                         ObjectMigration< precType > & migration, FORCE_KERNEL && forces, precType _totalTime, precType _max_resolution ) {
+      
+      SN_ASSERT( _totalTime >= precType( 0 ) );
+      
+      #ifdef NDEBUG
+      if( ! ( _totalTime >= precType( 0 ) ) )
+         SN_THROW_INVALID_ARGUMENT( "IA_Simulated_Time_Error" );
+      #endif
+      
+      kinematics.setTimeStep( _max_resolution );
+      
+      const small_t tsCount = small_cast( _totalTime / _max_resolution + precType( 0.5 ) );
       
       for( small_t ts = 0; ts < tsCount; ++ts ) {
          
-         performTimeStep( ts );
+         performTimeStep( kinematics, halo, migration, forces );
+      }
+   }
+   
+private:
+   
+   /** A function which chooses the process grid for a domain by enumerating all factorizations of the number of processes into three
+   *   factors. Grids whose blocks are at least as thick as the cutoff are preferred, and among these the one with the smallest block
+   *   surface. The choice is deterministic, so that every process arrives at the same grid.
+   *
+   *   \param diag       The extent of the whole domain.
+   *   \param num_proc   The number of processes.
+   *   \param cutoff     The interaction cutoff.
+   *   \param grid       The number of processes along each dimension (output).
+   *   \return           true if the blocks of the chosen grid are at least as thick as the cutoff, false if not.
+   */
+   static flag_t chooseProcessGrid( const Vector3<precType> & diag, small_t num_proc, precType cutoff, small_t grid[3] ) {
+      
+      flag_t best_thick = false;
+      precType best_surface = std::numeric_limits< precType >::max();
+      
+      for( small_t px = 1; px <= num_proc; ++px ) {
+         
+         if( num_proc % px != 0 )
+            continue;
+         
+         for( small_t py = 1; py <= num_proc / px; ++py ) {
+            
+            if( ( num_proc / px ) % py != 0 )
+               continue;
+            
+            const small_t pz = num_proc / px / py;
+            const precType ex = diag[0] / precType( px );
+            const precType ey = diag[1] / precType( py );
+            const precType ez = diag[2] / precType( pz );
+            
+            const flag_t thick = std::min( ex, std::min( ey, ez ) ) >= cutoff;
+            const precType surface = ex * ey + ey * ez + ez * ex;
+            
+            if( ( thick && ! best_thick ) || ( thick == best_thick && surface < best_surface ) ) {
+               
+               best_thick = thick;
+               best_surface = surface;
+               grid[0] = px;
+               grid[1] = py;
+               grid[2] = pz;
+            }
+         }
+      }
+      
+      return best_thick;
+   }
+   
+   /** The number of histogram bins per block along a dimension, by which the block boundaries are resolved in balanceLoad. */
+   static constexpr large_t HISTOGRAM_BINS_PER_BLOCK = 64;
+   
+   /** A function which places the block boundaries along a dimension at the quantiles of a cost histogram, such that every block receives 
+   *   the same share of the cost. The cost within a bin is taken to be uniformly distributed. Subsequently, the blocks are widened where 
+   *   necessary to be at least as thick as the smallest extent. If the histogram is empty or the dimension is too short to accommodate 
+   *   all blocks, the boundaries are left unchanged.
+   *
+   *   \param histogram    The global cost histogram along the dimension.
+   *   \param extent       The extent of the global domain along the dimension.
+   *   \param min_extent   The smallest extent of a block.
+   *   \param boundaries   The block boundaries along the dimension, including both ends of the domain (input and output).
+   */
+   static void placeCuts( const FastBuffer< real_t > & histogram, precType extent, precType min_extent, 
+                          std::vector< precType > & boundaries ) {
+      
+      const small_t blocks = small_cast( boundaries.size() - 1 );
+      const large_t bins = histogram.getSize();
+      
+      real_t total = real_cast( 0 );
+      for( large_t bin = 0; bin < bins; ++bin )
+         total += histogram[bin];
+      
+      if( total <= real_cast( 0 ) || precType( blocks ) * min_extent > extent )
+         return;
+      
+      large_t bin = 0;
+      real_t below = real_cast( 0 );   // The cost of all bins before bin.
+      
+      for( small_t k = 1; k < blocks; ++k ) {
+         
+         const real_t target = total * real_cast( k ) / real_cast( blocks );
+         while( bin < bins - 1 && below + histogram[bin] < target )
+            below += histogram[bin++];
+         
+         const real_t fraction = ( histogram[bin] > real_cast( 0 ) ) ? 
+                                 std::min( ( target - below ) / histogram[bin], real_cast( 1 ) ) : real_cast( 0 );
+         boundaries[k] = extent * precType( ( real_cast( bin ) + fraction ) / real_cast( bins ) );
+      }
+      
+      // Enforce the smallest extent from below, then from above.
+      for( small_t k = 1; k < blocks; ++k )
+         boundaries[k] = std::max( boundaries[k], boundaries[ k - 1 ] + min_extent );
+      for( small_t k = blocks - 1; k > 0; --k )
+         boundaries[k] = std::min( boundaries[k], boundaries[ k + 1 ] - min_extent );
+   }
+   
+   /** A function which sends every object which lies outside the block of this process to its owner and inserts the objects received from
+   *   other processes. The destinations may be any processes, so that the records are exchanged with BaseComm::alltoallv. The records 
+   *   are laid out as those of ObjectMigration, including the user data, and the arrivals are created in one batch. The function must be called by all processes. Notes on exception safety: 
+   *   basic safety guaranteed. The function throws an AllocError exception if the required resource allocation were not possible and an 
+   *   MPIError exception if the communication failed.
+   *
+   *   \param kinematics   The kinematics of the objects of this process.
+   *   \param migration    The migration whose user data is transferred, nullptr if there is none.
+   */
+   static void migrateObjects( WorldKinematicsBB< precType > & kinematics, const ObjectMigration< precType > * migration ) {
+      
+      #ifdef __SN_USE_MPI__
+      const auto & world = ProcSingleton::getWorld< precType, kinematicsType >();
+      const int num_proc = SN_MPI_SIZE();
+      const int rank = SN_MPI_RANK();
+      const large_t size = kinematics.getSize();
+      const int state = int( kinematics.getRecordSize() );
+      const int user = ( migration != nullptr ) ? int( migration->user_values_ ) : 0;
+      const int record = state + user;
+      const SoASpan3< const precType > pos = kinematics.getPositionSpan();
+      
+      std::vector< int > owner;
+      std::vector< large_t > leavers;
+      std::vector< Object_ID_t > arrivals;
+      
+      try {
+         owner.resize( size );
+         leavers.reserve( size );
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+      
+      FastBuffer< int > send_count( small_cast( num_proc ), 0 ), recv_count( small_cast( num_proc ) );
+      FastBuffer< int > send_offset( small_cast( num_proc ), 0 ), recv_offset( small_cast( num_proc ), 0 );
+      int * send_counts = send_count.raw_ptr();
+      
+      for( large_t i = 0; i < size; ++i ) {
+         
+         owner[i] = world.getOwnerRank( pos.x[i], pos.y[i], pos.z[i] );
+         if( owner[i] != rank ) {
+            
+            ++send_counts[ owner[i] ];
+            leavers.push_back( i );
+         }
+      }
+      
+      BaseComm< int >::alltoall( send_count, recv_count, 1 );
+      
+      // Counts and offsets in units of values from here on.
+      int * recv_counts = recv_count.raw_ptr();
+      int * send_offsets = send_offset.raw_ptr();
+      int * recv_offsets = recv_offset.raw_ptr();
+      int send_total = 0, recv_total = 0;
+      for( int p = 0; p < num_proc; ++p ) {
+         
+         send_counts[p] *= record;
+         recv_counts[p] *= record;
+         send_offsets[p] = send_total;
+         recv_offsets[p] = recv_total;
+         send_total += send_counts[p];
+         recv_total += recv_counts[p];
+      }
+      
+      // A FastBuffer is never empty, whereas the receive buffer is fitted to the received records.
+      FastBuffer< precType > send_buffer( small_cast( std::max( send_total, 1 ) ) ), recv_buffer( small_t( 1 ) );
+      
+      std::vector< int > cursor( send_offsets, send_offsets + num_proc );
+      for( const large_t i : leavers ) {
+         
+         precType * values = send_buffer.raw_ptr() + cursor[ owner[i] ];
+         kinematics.packObject( i, values );
+         if( user > 0 )
+            migration->user_pack_( kinematics.getHandle( i ), values + state );
+         cursor[ owner[i] ] += record;
+      }
+      
+      BaseComm< precType >::alltoallv( send_buffer, send_count, send_offset, recv_buffer, recv_count, recv_offset );
+      
+      kinematics.deleteObjects( leavers.data(), leavers.size() );
+      
+      const large_t arrived = large_cast( recv_total / record );
+      try {
+         arrivals.resize( arrived );
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+      kinematics.reserve( kinematics.getSize() + arrived );
+      kinematics.createObjects( arrived, arrivals.data() );
+      
+      const large_t first_slot = kinematics.getSize() - arrived;
+      for( large_t k = 0; k < arrived; ++k ) {
+         
+         const precType * values = recv_buffer.raw_ptr() + k * large_cast( record );
+         kinematics.unpackObject( first_slot + k, values );
+         if( user > 0 )
+            migration->user_unpack_( arrivals[k], values + state );
+      }
+      #else
+      (void) kinematics; (void) migration;
+      #endif
+   }
+   
+   /** A function which derives the corner and the extent of the block of this process from the block boundaries of the world.
+   *
+   *   \param world   The world.
+   */
+   static void updateBlock( World< precType, kinematicsType > & world ) {
+      
+      for( small_t d = 0; d < 3; ++d ) {
+         
+         const small_t c = world.process_coords_[d];
+         world.domain_corner_[d] = world.boundaries_[d][c];
+         world.domain_[d] = world.boundaries_[d][ c + 1 ] - world.boundaries_[d][c];
       }
    }
 };
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T, class KINEMATIC_BB > constexpr large_t Simulator< FP_TYPE_T, KINEMATIC_BB >::HISTOGRAM_BINS_PER_BLOCK;
+#endif   // DOXYSKIP
+
 }   // namespace simpleNewton
 
 #endif   // header guard
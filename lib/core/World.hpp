@@ -2,6 +2,7 @@
 #define SN_WORLD_HPP
 
 #include <algorithm>
+#include <vector>
 
 #include <Global.hpp>
 #include <Types.hpp>
@@ -58,15 +59,146 @@ public:
    using precType = FP_TYPE_T;
    
    World() { SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >(); SN_CT_REQUIRE_DERIVED_FROM< KINEMATICS_BB, WorldKinematicsBB< precType > >(); }
+
+   /** \name Domain
+   *   @{
+   */
+   /** A function to ascertain whether the domain of the world has been set up (see Simulator::setupDomains).
+   *
+   *   \return   true if the domain has been set up, false if not.
+   */
+   inline flag_t isDomainInitialized() const           { return domain_initialized_; }
+
+   /** A function to obtain the extent of the block of the domain which is owned by this process.
+   *
+   *   \return   The extent of the block in each dimension.
+   */
+   inline Vector3< precType > getDomainExtent() const   { return domain_; }
+
+   /** A function to obtain the lower corner of the block of the domain which is owned by this process.
+   *
+   *   \return   The lower corner of the block.
+   */
+   inline Vector3< precType > getDomainCorner() const   { return domain_corner_; }
+
+   /** A function to obtain the extent of the whole domain, i.e., the diagonal which was passed to Simulator::setupDomains.
+   *
+   *   \return   The extent of the global domain in each dimension.
+   */
+   inline Vector3< precType > getGlobalDomainExtent() const   { return global_domain_; }
+
+   /** @} */
+
+   /** \name Process grid
+   *   @{
+   */
+   /** A function to obtain the number of processes along a dimension of the Cartesian process grid.
+   *
+   *   \param dim   The dimension.
+   *   \return      The number of blocks along the dimension.
+   */
+   inline small_t getProcessGridSize( small_t dim ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+      return process_grid_[dim];
+   }
+
+   /** A function to obtain the coordinate of this process in the Cartesian process grid.
+   *
+   *   \param dim   The dimension.
+   *   \return      The index of the block of this process along the dimension.
+   */
+   inline small_t getProcessCoord( small_t dim ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+      return process_coords_[dim];
+   }
+
+   /** A function to obtain the boundaries of all blocks along a dimension. Block i spans boundaries[i] to boundaries[i+1].
+   *
+   *   \param dim   The dimension.
+   *   \return      The getProcessGridSize( dim ) + 1 boundaries.
+   */
+   inline const std::vector< precType > & getBlockBoundaries( small_t dim ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+      return boundaries_[dim];
+   }
+
+   /** A function to obtain the rank of a neighbouring process in the Cartesian process grid. The grid is not periodic.
+   *
+   *   \param dx   The offset along x, one of -1, 0 and 1.
+   *   \param dy   The offset along y, one of -1, 0 and 1.
+   *   \param dz   The offset along z, one of -1, 0 and 1.
+   *   \return     The rank of the neighbour, or -1 if the offset leaves the grid.
+   */
+   inline int getNeighbourRank( int dx, int dy, int dz ) const {
+
+      SN_ASSERT( dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1 && dz >= -1 && dz <= 1 );
+      return neighbour_ranks_[ ( dx + 1 ) * 9 + ( dy + 1 ) * 3 + ( dz + 1 ) ];
+   }
+
+   /** A function to find the block which contains a coordinate along a dimension. Coordinates outside the domain are assigned to the
+   *   outermost blocks.
+   *
+   *   \param x     The coordinate.
+   *   \param dim   The dimension.
+   *   \return      The index of the block along the dimension.
+   */
+   inline small_t locateBlock( precType x, small_t dim ) const {
+      
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+      
+      const std::vector< precType > & b = boundaries_[dim];
+      return small_cast( std::upper_bound( b.begin() + 1, b.end() - 1, x ) - ( b.begin() + 1 ) );
+   }
    
+   /** A function to find the process which owns a position. The ranks in the process grid are assigned in row-major order of the
+   *   coordinates, as in the Cartesian communicator, whose ranks are not reordered (see Simulator::setupDomains).
+   *
+   *   \param x   The x-coordinate of the position.
+   *   \param y   The y-coordinate of the position.
+   *   \param z   The z-coordinate of the position.
+   *   \return    The rank of the owner.
+   */
+   inline int getOwnerRank( precType x, precType y, precType z ) const {
+      
+      return int( ( locateBlock( x, 0 ) * process_grid_[1] + locateBlock( y, 1 ) ) * process_grid_[2] + locateBlock( z, 2 ) );
+   }
+
+   /** @} */
+
+   /** \name Load balance
+   *   @{
+   */
+   /** A function to obtain the load imbalance which was measured by the last call of Simulator::balanceLoad.
+   *
+   *   \return   The ratio of the largest to the average cost of a process, minus one.
+   */
+   inline real_t getLoadImbalance() const   { return load_imbalance_; }
    
+   /** A function to obtain the work time which has been recorded since the last balance (see Simulator::recordWorkTime).
+   *
+   *   \return   The work time of this process in seconds.
+   */
+   inline real_t getWorkTime() const   { return work_time_; }
    
+   /** @} */
+
 private:
 
-   Vector3< precType > domain_ = {};
-   precType            domain_offset_ = {};
-   flag_t              domain_initialized_ = false;
-   small_t             parallel_dimension_ = -1;
+   Vector3< precType >     domain_ = {};                   ///< The extent of the block of this process.
+   Vector3< precType >     domain_corner_ = {};            ///< The lower corner of the block of this process.
+   Vector3< precType >     global_domain_ = {};            ///< The extent of the whole domain.
+   flag_t                  domain_initialized_ = false;    ///< Whether the domain has been set up.
+
+   small_t                 process_grid_[3] = { 1, 1, 1 };        ///< The number of processes along each dimension.
+   small_t                 process_coords_[3] = { 0, 0, 0 };      ///< The coordinates of this process in the grid.
+   std::vector< precType > boundaries_[3];                        ///< The block boundaries along each dimension.
+   int                     neighbour_ranks_[27] = {};             ///< The ranks of the 26 neighbours and this process.
+
+   real_t                  work_time_ = 0;                        ///< The work time since the last balance.
+   real_t                  load_imbalance_ = 0;                   ///< The imbalance measured by the last balance.
 };
 
 }   // namespace simpleNewton
@@ -0,0 +1,713 @@
+#ifndef SN_BARNESHUTFORCES_HPP
+#define SN_BARNESHUTFORCES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <Types.hpp>
+#include <Global.hpp>
+#include <BasicBases.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/SoAField3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+#include <core/ProcTimer.hpp>
+
+#include <core/kinematics/WorldKinematicsBB.hpp>
+#include <core/forces/DirectSumForces.hpp>
+
+#include <geometry/SpaceFillingCurve.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class BarnesHutForces, which approximates the inverse-square accelerations of all objects with an octree.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class approximates the same inverse-square accelerations as DirectSumForces in O(N log N) operations by the Barnes-Hut method.
+*   The objects are sorted along the Morton curve, and a linear octree is built over the sorted order, i.e., every node covers a contiguous
+*   range of objects and the children of a node are stored contiguously. The first levels of the tree are built serially and the subtrees
+*   below them in parallel. The monopole (total source strength and centre of source strength) and the bounding box of every node are then
+*   computed in a bottom-up pass. In the tree walk, each thread traverses the tree with an explicit stack for a chunk of targets in Morton
+*   order, so that consecutive walks touch the same nodes. A node is accepted as a whole if the target lies outside its bounding box and
+*
+*   |r - r_com| > s / theta + delta,
+*
+*   where s is the longest edge of the bounding box, delta the distance between the centre of the box and the centre of source strength,
+*   and theta the opening angle. Otherwise it is opened; the objects of an opened leaf are summed directly in a vectorized loop. A theta of
+*   zero therefore reproduces the direct sum.
+*
+*   The tree is kept between applications. If no object has moved farther than a fraction (the refit tolerance) of the extent of the tree
+*   since it was built, the tree is only refit: the topology and the order are kept and the bottom-up pass is repeated with the current
+*   positions. Since the bounding boxes are recomputed, refitting does not affect the accuracy of the acceptance criterion, only the quality
+*   of the tree. Otherwise, or if the number of objects or their storage order has changed, the tree is rebuilt. The monopole is only 
+*   meaningful for source strengths of equal sign, i.e., for gravity.
+*
+*   \tparam FP_TYPE_T   The floating point type of the kinematics.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class BarnesHutForces : private NonCopyable {
+
+public:
+
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Direct initialization constructor.
+   *
+   *   \param coupling          The coupling constant C (see DirectSumForces).
+   *   \param softening         The softening length eps.
+   *   \param theta             The opening angle.
+   *   \param refit_tolerance   The largest displacement since the last build, relative to the extent of the tree, for which the tree is
+   *                            refit instead of rebuilt.
+   */
+   BarnesHutForces( FP_TYPE_T coupling, FP_TYPE_T softening = FP_TYPE_T( 0 ), FP_TYPE_T theta = FP_TYPE_T( 0.5 ),
+                    FP_TYPE_T refit_tolerance = FP_TYPE_T( 0.05 ) )
+   : coupling_( coupling ), softening_( softening ), theta_( theta ), refit_tolerance_( refit_tolerance ) {
+
+      SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >();
+      SN_ASSERT( theta >= FP_TYPE_T( 0 ) );
+
+      #ifdef NDEBUG
+      if( theta < FP_TYPE_T( 0 ) )
+         SN_THROW_INVALID_ARGUMENT( "IA_BarnesHut_Opening_Angle_Error" );
+      #endif
+   }
+
+   /** Default destructor. */
+   ~BarnesHutForces() = default;
+
+   /** @} */
+
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the coupling constant.
+   *
+   *   \return   The coupling constant.
+   */
+   inline FP_TYPE_T getCoupling() const         { return coupling_; }
+
+   /** A function to obtain the softening length.
+   *
+   *   \return   The softening length.
+   */
+   inline FP_TYPE_T getSoftening() const        { return softening_; }
+
+   /** A function to obtain the opening angle.
+   *
+   *   \return   The opening angle.
+   */
+   inline FP_TYPE_T getOpeningAngle() const     { return theta_; }
+
+   /** A function to obtain the refit tolerance.
+   *
+   *   \return   The refit tolerance.
+   */
+   inline FP_TYPE_T getRefitTolerance() const   { return refit_tolerance_; }
+
+   /** A function to obtain the number of nodes of the current tree.
+   *
+   *   \return   The number of nodes.
+   */
+   inline large_t getNodeCount() const          { return nodes_.size(); }
+
+   /** A function which sets the opening angle. It takes effect with the next application. A smaller angle is more accurate and more
+   *   expensive.
+   *
+   *   \param theta   The opening angle, which must not be negative.
+   */
+   inline void setOpeningAngle( FP_TYPE_T theta ) {
+
+      SN_ASSERT( theta >= FP_TYPE_T( 0 ) );
+
+      #ifdef NDEBUG
+      if( theta < FP_TYPE_T( 0 ) )
+         SN_THROW_INVALID_ARGUMENT( "IA_BarnesHut_Opening_Angle_Error" );
+      #endif
+
+      theta_ = theta;
+   }
+
+   /** A function which sets the refit tolerance. A tolerance of zero rebuilds the tree as soon as any object has moved.
+   *
+   *   \param tolerance   The largest displacement since the last build, relative to the extent of the tree, for which the tree is refit.
+   */
+   inline void setRefitTolerance( FP_TYPE_T tolerance )   { refit_tolerance_ = tolerance; }
+
+   /** A function which discards the tree, so that it is rebuilt in the next application. */
+   inline void invalidate()                               { nodes_.clear(); built_for_ = nullptr; }
+
+   /** @} */
+
+   /** \name Primary functionality
+   *   @{
+   */
+   /** A function which computes the accelerations of all objects of the kinematics and writes them into its acceleration field. The tree
+   *   is rebuilt or refit beforehand. The duration of the tree update and the interaction rate of the walk are reported as level 2 events.
+   *   The tree is allocated before its parallel construction, so that no allocation can fail within a parallel region. Notes on exception
+   *   safety: basic safety guaranteed. The function throws an InvalidArgument exception if no source strengths are given and an AllocError 
+   *   exception if the tree could not be allocated.
+   *
+   *   \param kinematics   The kinematics of the world.
+   *   \param source       The source strengths, indexed by handle index (see WorldKinematicsBB::getHandleIndex).
+   *   \param target       The target factors, indexed by handle index. If it is nullptr, every factor is one.
+   */
+   void apply( WorldKinematicsBB<FP_TYPE_T> & kinematics, const FP_TYPE_T * source, const FP_TYPE_T * target = nullptr ) {
+
+      const large_t size = kinematics.getSize();
+      if( size == 0 )
+         return;
+
+      SN_ASSERT( source != nullptr );
+
+      #ifdef NDEBUG
+      if( source == nullptr )
+         SN_THROW_INVALID_ARGUMENT( "IA_BarnesHut_Source_Error" );
+      #endif
+
+      const SoASpan3<const FP_TYPE_T> pos = kinematics.getPositionSpan();
+
+      ProcTimer timer;
+
+      flag_t rebuilt = false;
+      try {
+         rebuilt = update( kinematics, pos, source );
+      }
+      catch( const std::bad_alloc & ) {
+         invalidate();
+         SN_THROW_ALLOC_ERROR();
+      }
+
+      SN_LOG_REPORT_L2_EVENT( "Forces", "BarnesHutForces::apply " << ( rebuilt ? "rebuilt" : "refit" ) << " the tree of " << nodes_.size()
+                                        << " nodes in " << timer.getAge() << " s" );
+
+      walk( kinematics.getAccelerationSpan(), kinematics.getObjectIndices(), target );
+   }
+
+   /** @} */
+
+private:
+
+   /* A node of the linear octree */
+   struct Node {
+
+      FP_TYPE_T com[3];     // The centre of source strength.
+      FP_TYPE_T strength;   // The total source strength.
+      FP_TYPE_T lo[3];      // The lower corner of the bounding box of the objects.
+      FP_TYPE_T hi[3];      // The upper corner of the bounding box of the objects.
+      FP_TYPE_T crit2;      // The square of the distance from the centre beyond which the node is accepted.
+      large_t begin;        // The first object (in the sorted order) covered by the node.
+      large_t end;          // The object following the last one covered by the node.
+      large_t child;        // The index of the first child, zero for a leaf.
+      small_t children;     // The number of children.
+      small_t level;        // The level of refinement.
+   };
+
+   /* A function which rebuilds or refits the tree. Returns true if the tree was rebuilt. */
+   flag_t update( const WorldKinematicsBB<FP_TYPE_T> & kinematics, SoASpan3<const FP_TYPE_T> pos, const FP_TYPE_T * source ) {
+
+      const large_t size = pos.size;
+
+      const large_t * indices = kinematics.getObjectIndices();
+
+      if( built_for_ == &kinematics && built_layout_ == kinematics.getLayoutVersion() && order_.size() == size && ! nodes_.empty() ) {
+
+         gather( pos, indices, source );
+
+         // The largest displacement since the build decides whether refitting is sufficient.
+         const FP_TYPE_T * x = sx_.data();
+         const FP_TYPE_T * y = sy_.data();
+         const FP_TYPE_T * z = sz_.data();
+         const FP_TYPE_T * x0 = anchor_x_.data();
+         const FP_TYPE_T * y0 = anchor_y_.data();
+         const FP_TYPE_T * z0 = anchor_z_.data();
+         FP_TYPE_T disp2 = FP_TYPE_T( 0 );
+
+         SN_OPENMP_FORK()
+         SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC OMP_REDUCTION( max : disp2 ) )
+         for( large_t k = 0; k < size; ++k ) {
+
+            const FP_TYPE_T dx = x[k] - x0[k];
+            const FP_TYPE_T dy = y[k] - y0[k];
+            const FP_TYPE_T dz = z[k] - z0[k];
+            disp2 = std::max( disp2, dx * dx + dy * dy + dz * dz );
+         }
+         SN_OPENMP_SYNC()
+
+         const FP_TYPE_T limit = refit_tolerance_ * extent_;
+         if( disp2 <= limit * limit ) {
+
+            computeMoments();
+            return false;
+         }
+      }
+
+      build( pos, indices, source );
+      built_for_ = &kinematics;
+      built_layout_ = kinematics.getLayoutVersion();
+      return true;
+   }
+
+   /* A function which copies the positions and source strengths into the sorted order. The sources are looked up by handle index. */
+   void gather( SoASpan3<const FP_TYPE_T> pos, const large_t * indices, const FP_TYPE_T * source ) {
+
+      const large_t size = pos.size;
+      const large_t * order = order_.data();
+      FP_TYPE_T * x = sx_.data();
+      FP_TYPE_T * y = sy_.data();
+      FP_TYPE_T * z = sz_.data();
+      FP_TYPE_T * s = ss_.data();
+
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC )
+      for( large_t k = 0; k < size; ++k ) {
+
+         const large_t h = order[k];
+         x[k] = pos.x[h];
+         y[k] = pos.y[h];
+         z[k] = pos.z[h];
+         s[k] = source[ indices[h] ];
+      }
+      SN_OPENMP_SYNC()
+   }
+
+   /* A function which sorts the objects along the Morton curve and builds the tree over the sorted order. */
+   void build( SoASpan3<const FP_TYPE_T> pos, const large_t * indices, const FP_TYPE_T * source ) {
+
+      const large_t size = pos.size;
+
+      keys_.resize( size );
+      order_.resize( size );
+      sx_.resize( size );
+      sy_.resize( size );
+      sz_.resize( size );
+      ss_.resize( size );
+
+      const sfc::Bounds<FP_TYPE_T> bounds = sfc::computeBounds( pos );
+      extent_ = bounds.extent;
+      sfc::computeKeys( pos, bounds, sfc::Curve::Morton, keys_.data() );
+
+      large_t * order = order_.data();
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC )
+      for( large_t k = 0; k < size; ++k )
+         order[k] = k;
+      SN_OPENMP_SYNC()
+
+      sfc::sortByKey( keys_.data(), order_.data(), size );
+
+      gather( pos, indices, source );
+      anchor_x_ = sx_;
+      anchor_y_ = sy_;
+      anchor_z_ = sz_;
+
+      // The top of the tree is built serially. Its nodes at the level SUBTREE_LEVEL become the roots of independent subtrees.
+      nodes_.clear();
+      nodes_.push_back( makeNode( 0, size, 0 ) );
+
+      std::vector< large_t > stubs;
+      split( 0, stubs );
+      top_count_ = nodes_.size();
+
+      // The nodes of the subtrees are counted in parallel, allocated serially and then refined in parallel into their own ranges, which
+      // follow the top in the order of the stubs.
+      const large_t stub_count = stubs.size();
+      subtree_ranges_.assign( stub_count + 1, 0 );
+      large_t * ranges = subtree_ranges_.data();
+      const large_t * stub = stubs.data();
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_DYNAMIC )
+      for( large_t s = 0; s < stub_count; ++s )
+         ranges[ s + 1 ] = countNodes( nodes_[ stub[s] ].begin, nodes_[ stub[s] ].end, nodes_[ stub[s] ].level );
+      SN_OPENMP_SYNC()
+
+      ranges[0] = top_count_;
+      for( large_t s = 0; s < stub_count; ++s )
+         ranges[ s + 1 ] += ranges[s];
+
+      nodes_.resize( ranges[ stub_count ] );
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_DYNAMIC )
+      for( large_t s = 0; s < stub_count; ++s )
+         refine( stub[s], ranges[s] );
+      SN_OPENMP_SYNC()
+
+      computeMoments();
+   }
+
+   /* A function which creates a node without moments. */
+   static Node makeNode( large_t begin, large_t end, small_t level ) {
+
+      Node node = {};
+      node.begin = begin;
+      node.end = end;
+      node.level = level;
+      return node;
+   }
+
+   /* A function which determines whether a node over the objects [begin, end) at the given level is refined. */
+   static flag_t isRefined( large_t begin, large_t end, small_t level ) {
+      return end - begin > LEAF_SIZE && level < sfc::KEY_BITS;
+   }
+
+   /* A function which finds the end of the range of the objects from lower on which share the octant of the object at lower. The keys
+   *  are sorted, therefore the objects of each octant form a contiguous range.
+   */
+   large_t octantEnd( large_t lower, large_t end, small_t level ) const {
+
+      const ID_t * keys = keys_.data();
+      const small_t oct = sfc::octant( keys[lower], level );
+      return large_cast( std::partition_point( keys + lower, keys + end, [=]( ID_t key ) { return sfc::octant( key, level ) == oct; } ) 
+                         - keys );
+   }
+
+   /* A function which serially refines the top of the tree in depth-first order. The children of a node are appended contiguously. The 
+   *  refinement stops at the level SUBTREE_LEVEL, where the nodes are collected as the roots of the subtrees.
+   */
+   void split( large_t index, std::vector< large_t > & stubs ) {
+
+      const large_t begin = nodes_[index].begin;
+      const large_t end = nodes_[index].end;
+      const small_t level = nodes_[index].level;
+
+      if( ! isRefined( begin, end, level ) )
+         return;
+
+      if( level == SUBTREE_LEVEL ) {
+
+         stubs.push_back( index );
+         return;
+      }
+
+      const large_t first = nodes_.size();
+      small_t children = 0;
+
+      for( large_t lower = begin; lower < end; ++children ) {
+
+         const large_t upper = octantEnd( lower, end, small_t( level + 1 ) );
+         nodes_.push_back( makeNode( lower, upper, small_t( level + 1 ) ) );
+         lower = upper;
+      }
+
+      nodes_[index].child = first;
+      nodes_[index].children = children;
+
+      for( small_t c = 0; c < children; ++c )
+         split( first + c, stubs );
+   }
+
+   /* A function which counts the descendants of a node over the objects [begin, end) at the given level. It allocates nothing and may 
+   *  therefore be called within a parallel region.
+   */
+   large_t countNodes( large_t begin, large_t end, small_t level ) const {
+
+      if( ! isRefined( begin, end, level ) )
+         return 0;
+
+      large_t count = 0;
+      for( large_t lower = begin; lower < end; ) {
+
+         const large_t upper = octantEnd( lower, end, small_t( level + 1 ) );
+         count += 1 + countNodes( lower, upper, small_t( level + 1 ) );
+         lower = upper;
+      }
+
+      return count;
+   }
+
+   /* A function which recursively refines a node in depth-first order into the allocated nodes from cursor on, whose number countNodes 
+   *  has determined. The children of a node are stored contiguously. It allocates nothing and may therefore be called within a parallel 
+   *  region. Returns the cursor after the descendants of the node.
+   */
+   large_t refine( large_t index, large_t cursor ) {
+
+      const large_t begin = nodes_[index].begin;
+      const large_t end = nodes_[index].end;
+      const small_t level = nodes_[index].level;
+
+      if( ! isRefined( begin, end, level ) )
+         return cursor;
+
+      const large_t first = cursor;
+      small_t children = 0;
+
+      for( large_t lower = begin; lower < end; ++children ) {
+
+         const large_t upper = octantEnd( lower, end, small_t( level + 1 ) );
+         nodes_[ cursor++ ] = makeNode( lower, upper, small_t( level + 1 ) );
+         lower = upper;
+      }
+
+      nodes_[index].child = first;
+      nodes_[index].children = children;
+
+      for( small_t c = 0; c < children; ++c )
+         cursor = refine( first + c, cursor );
+
+      return cursor;
+   }
+
+   /* A function which computes the moments, bounding boxes and acceptance radii of all nodes bottom-up. Children are always stored after
+   *  their parents, so that a reverse sweep visits them first. The subtrees are swept in parallel, the top serially.
+   */
+   void computeMoments() {
+
+      const large_t stub_count = subtree_ranges_.size() - 1;
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_DYNAMIC )
+      for( large_t s = 0; s < stub_count; ++s ) {
+         for( large_t j = subtree_ranges_[ s + 1 ]; j > subtree_ranges_[s]; --j )
+            computeNode( j - 1 );
+      }
+      SN_OPENMP_SYNC()
+
+      for( large_t j = top_count_; j > 0; --j )
+         computeNode( j - 1 );
+   }
+
+   /* A function which computes the moments of a single node from its objects or its children. */
+   void computeNode( large_t index ) {
+
+      Node & node = nodes_[index];
+
+      FP_TYPE_T strength = FP_TYPE_T( 0 ), weight = FP_TYPE_T( 0 );
+      FP_TYPE_T cx = FP_TYPE_T( 0 ), cy = FP_TYPE_T( 0 ), cz = FP_TYPE_T( 0 );
+      FP_TYPE_T lo_x = std::numeric_limits< FP_TYPE_T >::max(), hi_x = std::numeric_limits< FP_TYPE_T >::lowest();
+      FP_TYPE_T lo_y = lo_x, lo_z = lo_x, hi_y = hi_x, hi_z = hi_x;
+
+      if( node.children == 0 ) {
+
+         const FP_TYPE_T * x = sx_.data();
+         const FP_TYPE_T * y = sy_.data();
+         const FP_TYPE_T * z = sz_.data();
+         const FP_TYPE_T * s = ss_.data();
+
+         for( large_t k = node.begin; k < node.end; ++k ) {
+
+            const FP_TYPE_T w = std::abs( s[k] );
+            strength += s[k];
+            weight += w;
+            cx += w * x[k];   cy += w * y[k];   cz += w * z[k];
+            lo_x = std::min( lo_x, x[k] );   hi_x = std::max( hi_x, x[k] );
+            lo_y = std::min( lo_y, y[k] );   hi_y = std::max( hi_y, y[k] );
+            lo_z = std::min( lo_z, z[k] );   hi_z = std::max( hi_z, z[k] );
+         }
+      }
+      else {
+
+         for( large_t c = node.child; c < node.child + node.children; ++c ) {
+
+            const Node & child = nodes_[c];
+            const FP_TYPE_T w = std::abs( child.strength );   // Equal to the weight of the child for strengths of equal sign.
+            strength += child.strength;
+            weight += w;
+            cx += w * child.com[0];   cy += w * child.com[1];   cz += w * child.com[2];
+            lo_x = std::min( lo_x, child.lo[0] );   hi_x = std::max( hi_x, child.hi[0] );
+            lo_y = std::min( lo_y, child.lo[1] );   hi_y = std::max( hi_y, child.hi[1] );
+            lo_z = std::min( lo_z, child.lo[2] );   hi_z = std::max( hi_z, child.hi[2] );
+         }
+      }
+
+      node.lo[0] = lo_x;   node.lo[1] = lo_y;   node.lo[2] = lo_z;
+      node.hi[0] = hi_x;   node.hi[1] = hi_y;   node.hi[2] = hi_z;
+      node.strength = strength;
+
+      const FP_TYPE_T mid_x = FP_TYPE_T( 0.5 ) * ( lo_x + hi_x );
+      const FP_TYPE_T mid_y = FP_TYPE_T( 0.5 ) * ( lo_y + hi_y );
+      const FP_TYPE_T mid_z = FP_TYPE_T( 0.5 ) * ( lo_z + hi_z );
+
+      if( weight > FP_TYPE_T( 0 ) ) {
+         node.com[0] = cx / weight;   node.com[1] = cy / weight;   node.com[2] = cz / weight;
+      }
+      else {
+         node.com[0] = mid_x;   node.com[1] = mid_y;   node.com[2] = mid_z;
+      }
+
+      if( theta_ > FP_TYPE_T( 0 ) ) {
+
+         const FP_TYPE_T edge = std::max( hi_x - lo_x, std::max( hi_y - lo_y, hi_z - lo_z ) );
+         const FP_TYPE_T dx = node.com[0] - mid_x;
+         const FP_TYPE_T dy = node.com[1] - mid_y;
+         const FP_TYPE_T dz = node.com[2] - mid_z;
+         const FP_TYPE_T crit = edge / theta_ + std::sqrt( dx * dx + dy * dy + dz * dz );
+         node.crit2 = crit * crit;
+      }
+      else {
+         node.crit2 = std::numeric_limits< FP_TYPE_T >::max();
+      }
+   }
+
+   /* A function which walks the tree for every target and writes the accelerations. */
+   void walk( SoASpan3<FP_TYPE_T> acc, const large_t * indices, const FP_TYPE_T * target ) const {
+
+      const large_t size = order_.size();
+      const FP_TYPE_T * x = sx_.data();
+      const FP_TYPE_T * y = sy_.data();
+      const FP_TYPE_T * z = sz_.data();
+      const FP_TYPE_T * s = ss_.data();
+      const large_t * order = order_.data();
+      const Node * nodes = nodes_.data();
+
+      const FP_TYPE_T eps2 = softening_ * softening_;
+      const FP_TYPE_T coupling = coupling_;
+      large_t interactions = 0;
+
+      ProcTimer timer;
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_DYNAMIC_CS( WALK_CHUNK ) OMP_REDUCTION( + : interactions ) )
+      for( large_t k = 0; k < size; ++k ) {
+
+         const FP_TYPE_T xi = x[k];
+         const FP_TYPE_T yi = y[k];
+         const FP_TYPE_T zi = z[k];
+
+         FP_TYPE_T ax = FP_TYPE_T( 0 );
+         FP_TYPE_T ay = FP_TYPE_T( 0 );
+         FP_TYPE_T az = FP_TYPE_T( 0 );
+
+         large_t stack[ STACK_SIZE ];
+         small_t top = 0;
+         stack[ top++ ] = 0;
+
+         while( top > 0 ) {
+
+            const Node & node = nodes[ stack[ --top ] ];
+
+            const FP_TYPE_T dx = node.com[0] - xi;
+            const FP_TYPE_T dy = node.com[1] - yi;
+            const FP_TYPE_T dz = node.com[2] - zi;
+            const FP_TYPE_T r2 = dx * dx + dy * dy + dz * dz;
+
+            const flag_t inside = xi >= node.lo[0] && xi <= node.hi[0] && yi >= node.lo[1] && yi <= node.hi[1] &&
+                                  zi >= node.lo[2] && zi <= node.hi[2];
+
+            if( ! inside && r2 > node.crit2 ) {
+
+               const FP_TYPE_T rinv = forces::internal::RSqrt< FP_TYPE_T >::eval( r2 + eps2 );
+               const FP_TYPE_T w = node.strength * rinv * rinv * rinv;
+               ax += w * dx;
+               ay += w * dy;
+               az += w * dz;
+               ++interactions;
+            }
+            else if( node.children == 0 ) {
+
+               const large_t j0 = node.begin;
+               const large_t j1 = node.end;
+
+               SN_OPENMP_SIMD_LOOP( OMP_REDUCTION( + : ax, ay, az ) )
+               for( large_t j = j0; j < j1; ++j ) {
+
+                  const FP_TYPE_T ex = x[j] - xi;
+                  const FP_TYPE_T ey = y[j] - yi;
+                  const FP_TYPE_T ez = z[j] - zi;
+                  const FP_TYPE_T q2 = ex * ex + ey * ey + ez * ez + eps2;
+
+                  // The self-interaction (and any coincident pair without softening) does not contribute, see RSqrt.
+                  const FP_TYPE_T rinv = forces::internal::RSqrt< FP_TYPE_T >::eval( q2 );
+                  const FP_TYPE_T w = s[j] * rinv * rinv * rinv;
+
+                  ax += w * ex;
+                  ay += w * ey;
+                  az += w * ez;
+               }
+               interactions += j1 - j0;
+            }
+            else {
+
+               SN_ASSERT( top + node.children <= STACK_SIZE );
+
+               for( small_t c = 0; c < node.children; ++c )
+                  stack[ top++ ] = node.child + c;
+            }
+         }
+
+         const large_t h = order[k];
+         const FP_TYPE_T factor = ( target != nullptr ) ? coupling * target[ indices[h] ] : coupling;
+         acc.x[h] = factor * ax;
+         acc.y[h] = factor * ay;
+         acc.z[h] = factor * az;
+      }
+      SN_OPENMP_SYNC()
+
+      const real_t seconds = timer.getAge();
+      if( seconds > real_cast( 0 ) ) {
+         SN_LOG_REPORT_L2_EVENT( "Forces", "BarnesHutForces::apply computed " << interactions << " interactions at "
+                                           << real_cast( interactions ) / seconds * real_cast( 1e-9 ) << " G/s" );
+      }
+   }
+
+   /* Tree parameters */
+   static constexpr large_t LEAF_SIZE     = 16;                                ///< Largest number of objects in a leaf.
+   static constexpr small_t SUBTREE_LEVEL = 2;                                 ///< Level of the roots of the parallel subtrees.
+   static constexpr small_t STACK_SIZE    = 8 * ( sfc::KEY_BITS + 1 );         ///< Depth of the walk stack.
+   static constexpr large_t WALK_CHUNK    = 64;                                ///< Targets per scheduled chunk of the walk.
+
+   /* Members */
+   FP_TYPE_T coupling_;           ///< The coupling constant.
+   FP_TYPE_T softening_;          ///< The softening length.
+   FP_TYPE_T theta_;              ///< The opening angle.
+   FP_TYPE_T refit_tolerance_;    ///< The relative displacement up to which the tree is refit.
+   FP_TYPE_T extent_ = {};        ///< The extent of the tree at the last build.
+
+   const WorldKinematicsBB<FP_TYPE_T> * built_for_ = nullptr;   ///< The kinematics for which the tree was built.
+   large_t built_layout_ = 0;                                   ///< The layout version of the kinematics at the last build.
+
+   std::vector< Node > nodes_;                ///< The nodes, top first and then subtree by subtree.
+   large_t top_count_ = 0;                    ///< The number of nodes of the serially built top.
+   std::vector< large_t > subtree_ranges_;    ///< The node ranges of the subtrees.
+
+   std::vector< ID_t > keys_;                 ///< The sorted Morton keys.
+   std::vector< large_t > order_;             ///< The slots of the objects in the sorted order.
+   std::vector< FP_TYPE_T > sx_, sy_, sz_;    ///< The positions in the sorted order.
+   std::vector< FP_TYPE_T > ss_;              ///< The source strengths in the sorted order.
+   std::vector< FP_TYPE_T > anchor_x_, anchor_y_, anchor_z_;   ///< The sorted positions at the last build.
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T > constexpr large_t BarnesHutForces< FP_TYPE_T >::LEAF_SIZE;
+template< typename FP_TYPE_T > constexpr small_t BarnesHutForces< FP_TYPE_T >::SUBTREE_LEVEL;
+template< typename FP_TYPE_T > constexpr small_t BarnesHutForces< FP_TYPE_T >::STACK_SIZE;
+template< typename FP_TYPE_T > constexpr large_t BarnesHutForces< FP_TYPE_T >::WALK_CHUNK;
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -0,0 +1,402 @@
+#ifndef SN_CELLLIST_HPP
+#define SN_CELLLIST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <vector>
+
+#include <Types.hpp>
+#include <Global.hpp>
+#include <BasicBases.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+#include <core/World.hpp>
+
+#include <geometry/SpaceFillingCurve.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class CellList, which bins objects into cells of the interaction cutoff for short-range neighbour searches.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class bins the objects of a world into a regular grid of cells whose edges are at least as long as the interaction cutoff, so
+*   that every pair of objects closer than the cutoff lies in the same or in adjacent cells. Objects outside the domain are binned into the
+*   nearest boundary cell, which preserves this property. The binning is a counting sort of the objects by cell index, which is performed
+*   by the parallel radix sort of the space-filling curve utilities; the result is an array of slots ordered by cell and an array of cell
+*   offsets into it.
+*
+*   The pair traversal visits, for every cell, the pairs within the cell and the pairs with the 13 cells of its forward half shell, so that
+*   every pair within the cutoff is enumerated exactly once. The cells are processed in 18 colours, the cells of one colour being
+*   distributed among the threads: the half shells of two cells of the same colour never overlap, therefore a pair kernel may accumulate
+*   into both objects of a pair without atomic operations.
+*
+*   The positions may include ghosts (see WorldKinematicsBB::getHaloPositionSpan), which then occupy the slots from getOwnedCount() on.
+*   Ghosts act as sources only: pairs of two ghosts are skipped, and in a pair of an owned object and a ghost the owned object is always
+*   the first, so that a pair kernel never writes to a ghost as long as it writes to its first object only or checks the second slot.
+*
+*   \tparam FP_TYPE_T   The floating point type of the positions.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class CellList : private NonCopyable {
+
+public:
+
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Direct initialization constructor.
+   *
+   *   \param corner   The lower corner of the domain.
+   *   \param extent   The extent of the domain in each dimension.
+   *   \param cutoff   The interaction cutoff, the smallest edge of a cell.
+   */
+   CellList( const Vector3<FP_TYPE_T> & corner, const Vector3<FP_TYPE_T> & extent, FP_TYPE_T cutoff ) {
+
+      SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >();
+
+      setup( corner, extent, cutoff );
+   }
+
+   /** Constructor which takes the domain of a world. Notes on exception safety: strong safety guaranteed. A PreconditionError exception is
+   *   thrown if the domain of the world has not been set up.
+   *
+   *   \param world    The world, whose domain is covered by the cells.
+   *   \param cutoff   The interaction cutoff, the smallest edge of a cell.
+   */
+   template< class KINEMATICS_BB >
+   CellList( const World< FP_TYPE_T, KINEMATICS_BB > & world, FP_TYPE_T cutoff ) {
+
+      SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >();
+      SN_ASSERT( world.isDomainInitialized() );
+
+      #ifdef NDEBUG
+      if( ! world.isDomainInitialized() )
+         SN_THROW_PRECONDITION_ERROR( "PREC_CellList_Domain_Error" );
+      #endif
+
+      setup( world.getDomainCorner(), world.getDomainExtent(), cutoff );
+   }
+
+   /** Default destructor. */
+   ~CellList() = default;
+
+   /** @} */
+
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the interaction cutoff.
+   *
+   *   \return   The cutoff.
+   */
+   inline FP_TYPE_T getCutoff() const                    { return cutoff_; }
+
+   /** A function to obtain the number of cells in a dimension.
+   *
+   *   \param dim   The dimension (0, 1 or 2).
+   *   \return      The number of cells.
+   */
+   inline large_t getCellCount( small_t dim ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( dim, 3 );
+
+      return dims_[dim];
+   }
+
+   /** A function to obtain the total number of cells.
+   *
+   *   \return   The number of cells.
+   */
+   inline large_t getCellCount() const                   { return dims_[0] * dims_[1] * dims_[2]; }
+
+   /** A function to obtain the number of objects binned in the last build.
+   *
+   *   \return   The number of objects.
+   */
+   inline large_t getSize() const                        { return objects_.size(); }
+
+   /** A function to obtain the number of owned objects binned in the last build. The slots from this number on are ghosts.
+   *
+   *   \return   The number of owned objects.
+   */
+   inline large_t getOwnedCount() const                  { return owned_; }
+
+   /** A function which computes the index of the cell containing a position. Positions outside the domain are assigned to the nearest
+   *   boundary cell.
+   *
+   *   \param x   The x-coordinate.
+   *   \param y   The y-coordinate.
+   *   \param z   The z-coordinate.
+   *   \return    The linear cell index, z running fastest.
+   */
+   inline large_t getCellIndex( FP_TYPE_T x, FP_TYPE_T y, FP_TYPE_T z ) const {
+      return ( cellCoord( x, 0 ) * dims_[1] + cellCoord( y, 1 ) ) * dims_[2] + cellCoord( z, 2 );
+   }
+
+   /** A function to obtain the slots of the objects in the order of their cells.
+   *
+   *   \return   A pointer to the getSize() slots.
+   */
+   inline const large_t * getObjects() const             { return objects_.data(); }
+
+   /** A function to obtain the offsets of the cells into the array of slots. The objects of cell c are getObjects()[ offsets[c] ] to
+   *   getObjects()[ offsets[c+1] - 1 ].
+   *
+   *   \return   A pointer to the getCellCount() + 1 offsets.
+   */
+   inline const large_t * getCellOffsets() const         { return offsets_.data(); }
+
+   /** @} */
+
+   /** \name Primary functionality
+   *   @{
+   */
+   /** A function which bins the objects by their current positions. Notes on exception safety: basic safety guaranteed. The function
+   *   throws an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param pos   A view of the positions, indexed by slot (see WorldKinematicsBB::getSlot).
+   */
+   void build( SoASpan3<const FP_TYPE_T> pos )           { build( pos, pos.size ); }
+
+   /** A function which bins the owned objects and the ghosts by their current positions. Notes on exception safety: basic safety
+   *   guaranteed. The function throws an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param pos     A view of the positions of the owned objects and the ghosts, indexed by slot (see
+   *                  WorldKinematicsBB::getHaloPositionSpan).
+   *   \param owned   The number of owned objects, i.e., the first ghost slot (see WorldKinematicsBB::getSize).
+   */
+   void build( SoASpan3<const FP_TYPE_T> pos, large_t owned ) {
+
+      SN_ASSERT( owned <= pos.size );
+
+      #ifdef NDEBUG
+      if( owned > pos.size )
+         SN_THROW_INVALID_ARGUMENT( "IA_CellList_Owned_Error" );
+      #endif
+
+      const large_t size = pos.size;
+      const large_t cells = getCellCount();
+
+      try {
+         keys_.resize( size );
+         objects_.resize( size );
+         offsets_.resize( cells + 1 );
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+
+      ID_t * keys = keys_.data();
+      large_t * objects = objects_.data();
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t i = 0; i < size; ++i ) {
+
+         keys[i] = getCellIndex( pos.x[i], pos.y[i], pos.z[i] );
+         objects[i] = i;
+      }
+      SN_OPENMP_SYNC()
+
+      small_t key_bits = 1;
+      while( key_bits < 64 && ( ID_t( 1 ) << key_bits ) < cells )
+         ++key_bits;
+
+      sfc::sortByKey( keys, objects, size, key_bits );
+
+      large_t * offsets = offsets_.data();
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t c = 0; c <= cells; ++c )
+         offsets[c] = large_cast( std::lower_bound( keys, keys + size, ID_t( c ) ) - keys );
+      SN_OPENMP_SYNC()
+
+      owned_ = owned;
+   }
+
+   /** A function which calls a kernel for every pair of objects closer than the cutoff, exactly once per pair. The kernel is called
+   *   concurrently, but never concurrently for two pairs which share an object. The cells must have been built with the same positions.
+   *   Pairs of two ghosts are skipped, and the first object of a pair is never a ghost.
+   *
+   *   \tparam PAIR_KERNEL   A callable with the signature void( large_t i, large_t j, FP_TYPE_T dx, FP_TYPE_T dy, FP_TYPE_T dz, FP_TYPE_T r2 ),
+   *                         where ( dx, dy, dz ) is the position of j relative to i and r2 its squared length.
+   *   \param pos            A view of the positions, indexed by slot (see WorldKinematicsBB::getSlot).
+   *   \param kernel         The pair kernel.
+   */
+   template< class PAIR_KERNEL >
+   void forEachPair( SoASpan3<const FP_TYPE_T> pos, PAIR_KERNEL && kernel ) const {
+
+      SN_ASSERT( pos.size == objects_.size() );
+
+      const FP_TYPE_T cutoff2 = cutoff_ * cutoff_;
+      const large_t owned = owned_;
+      const large_t * objects = objects_.data();
+      const large_t * offsets = offsets_.data();
+
+      // Colour ( cx mod 2, cy mod 3, cz mod 3 ): a half shell spans [cx, cx+1] x [cy-1, cy+1] x [cz-1, cz+1]. The implicit barrier of
+      // the work-sharing loop separates the colours.
+      SN_OPENMP_FORK()
+      for( small_t colour = 0; colour < 18; ++colour ) {
+
+         const large_t ox = colour / 9;
+         const large_t oy = colour / 3 % 3;
+         const large_t oz = colour % 3;
+         const large_t nx = ( dims_[0] + 1 - ox ) / 2;
+         const large_t ny = ( dims_[1] + 2 - oy ) / 3;
+         const large_t nz = ( dims_[2] + 2 - oz ) / 3;
+         const large_t count = nx * ny * nz;
+
+         OMP_FOR_LOOP( OMP_DYNAMIC )
+         for( large_t n = 0; n < count; ++n ) {
+
+            const large_t cx = ox + 2 * ( n / ( ny * nz ) );
+            const large_t cy = oy + 3 * ( n / nz % ny );
+            const large_t cz = oz + 3 * ( n % nz );
+            const large_t cell = ( cx * dims_[1] + cy ) * dims_[2] + cz;
+
+            for( large_t a = offsets[cell]; a < offsets[ cell + 1 ]; ++a ) {
+
+               const large_t i = objects[a];
+               const FP_TYPE_T xi = pos.x[i];
+               const FP_TYPE_T yi = pos.y[i];
+               const FP_TYPE_T zi = pos.z[i];
+
+               // Pairs within the own cell.
+               for( large_t b = a + 1; b < offsets[ cell + 1 ]; ++b )
+                  visit( pos, i, objects[b], xi, yi, zi, cutoff2, owned, kernel );
+
+               // Pairs with the forward half shell.
+               for( small_t s = 0; s < 13; ++s ) {
+
+                  const long nbx = long( cx ) + HALF_SHELL[s][0];
+                  const long nby = long( cy ) + HALF_SHELL[s][1];
+                  const long nbz = long( cz ) + HALF_SHELL[s][2];
+                  if( nbx >= long( dims_[0] ) || nby < 0 || nby >= long( dims_[1] ) || nbz < 0 || nbz >= long( dims_[2] ) )
+                     continue;
+
+                  const large_t other = ( large_t( nbx ) * dims_[1] + large_t( nby ) ) * dims_[2] + large_t( nbz );
+                  for( large_t b = offsets[other]; b < offsets[ other + 1 ]; ++b )
+                     visit( pos, i, objects[b], xi, yi, zi, cutoff2, owned, kernel );
+               }
+            }
+         }
+      }
+      SN_OPENMP_SYNC()
+   }
+
+   /** @} */
+
+private:
+
+   /* A function which sets up the grid. */
+   void setup( const Vector3<FP_TYPE_T> & corner, const Vector3<FP_TYPE_T> & extent, FP_TYPE_T cutoff ) {
+
+      SN_ASSERT( cutoff > FP_TYPE_T( 0 ) );
+
+      #ifdef NDEBUG
+      if( ! ( cutoff > FP_TYPE_T( 0 ) ) )
+         SN_THROW_INVALID_ARGUMENT( "IA_CellList_Cutoff_Error" );
+      #endif
+
+      cutoff_ = cutoff;
+      for( small_t d = 0; d < 3; ++d ) {
+
+         lo_[d] = corner[d];
+         dims_[d] = std::max( large_cast( std::floor( extent[d] / cutoff ) ), large_cast( 1 ) );
+         inv_width_[d] = FP_TYPE_T( dims_[d] ) / std::max( extent[d], cutoff );
+      }
+   }
+
+   /* A function which computes the cell coordinate of a position component, clamped to the grid. */
+   inline large_t cellCoord( FP_TYPE_T val, small_t dim ) const {
+
+      const FP_TYPE_T c = ( val - lo_[dim] ) * inv_width_[dim];
+      if( c < FP_TYPE_T( 0 ) )
+         return 0;
+
+      return std::min( large_cast( c ), dims_[dim] - 1 );
+   }
+
+   /* A function which tests a pair against the cutoff and hands it to the kernel, owned object first. Pairs of two ghosts are skipped. */
+   template< class PAIR_KERNEL >
+   static inline void visit( SoASpan3<const FP_TYPE_T> pos, large_t i, large_t j, FP_TYPE_T xi, FP_TYPE_T yi, FP_TYPE_T zi,
+                             FP_TYPE_T cutoff2, large_t owned, PAIR_KERNEL & kernel ) {
+
+      if( i >= owned && j >= owned )
+         return;
+
+      const FP_TYPE_T dx = pos.x[j] - xi;
+      const FP_TYPE_T dy = pos.y[j] - yi;
+      const FP_TYPE_T dz = pos.z[j] - zi;
+      const FP_TYPE_T r2 = dx * dx + dy * dy + dz * dz;
+
+      if( r2 < cutoff2 ) {
+
+         if( i < owned )
+            kernel( i, j, dx, dy, dz, r2 );
+         else
+            kernel( j, i, -dx, -dy, -dz, r2 );
+      }
+   }
+
+   /* The forward half shell: the 13 neighbour offsets which are lexicographically greater than zero. */
+   static constexpr int HALF_SHELL[13][3] = { {  0,  0,  1 },
+                                              {  0,  1, -1 }, {  0,  1,  0 }, {  0,  1,  1 },
+                                              {  1, -1, -1 }, {  1, -1,  0 }, {  1, -1,  1 },
+                                              {  1,  0, -1 }, {  1,  0,  0 }, {  1,  0,  1 },
+                                              {  1,  1, -1 }, {  1,  1,  0 }, {  1,  1,  1 } };
+
+   /* Members */
+   FP_TYPE_T cutoff_ = {};           ///< The interaction cutoff.
+   FP_TYPE_T lo_[3] = {};            ///< The lower corner of the grid.
+   FP_TYPE_T inv_width_[3] = {};     ///< The reciprocal edge lengths of the cells.
+   large_t dims_[3] = { 1, 1, 1 };   ///< The number of cells in each dimension.
+   large_t owned_ = 0;               ///< The number of owned objects of the last build.
+
+   std::vector< ID_t > keys_;         ///< The sorted cell indices of the objects.
+   std::vector< large_t > objects_;   ///< The slots of the objects in the order of their cells.
+   std::vector< large_t > offsets_;   ///< The offsets of the cells into objects_.
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T > constexpr int CellList< FP_TYPE_T >::HALF_SHELL[13][3];
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -0,0 +1,256 @@
+#ifndef SN_DIRECTSUMFORCES_HPP
+#define SN_DIRECTSUMFORCES_HPP
+
+#include <cmath>
+#include <algorithm>
+
+#include <Types.hpp>
+#include <Global.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/RAIIWrapper.hpp>
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+#include <core/ProcTimer.hpp>
+
+#include <core/kinematics/WorldKinematicsBB.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class DirectSumForces, which computes the pairwise inverse-square accelerations of all objects by direct summation.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace forces {
+namespace internal {
+
+/* Reciprocal square root, which is zero at zero, so that the self-interaction (and any coincident pair without softening) does not 
+*  contribute. The zero is selected by a mask instead of a branch, so that the force loops vectorize into packed square roots and 
+*  divisions (which requires -fno-math-errno, see the top-level CMakeLists.txt).
+*/
+template< typename FP_TYPE_T > struct RSqrt {
+   static inline FP_TYPE_T eval( FP_TYPE_T x ) {
+      
+      const FP_TYPE_T mask = FP_TYPE_T( x > FP_TYPE_T( 0 ) );
+      return mask / std::sqrt( x + ( FP_TYPE_T( 1 ) - mask ) );
+   }
+};
+
+}   // namespace internal
+}   // namespace forces
+#endif   // DOXYSKIP
+
+
+
+//===CLASS==================================================================================================================================
+
+/** This class computes inverse-square (gravitational or Coulomb) accelerations by direct summation over all pairs of objects,
+*
+*   a_i = C * t_i * sum_j s_j * ( r_j - r_i ) / ( |r_j - r_i|^2 + eps^2 )^(3/2),
+*
+*   where C is the coupling constant, s_j the source strength of object j and t_i the target factor of object i. For gravity, C is the
+*   gravitational constant, s_j the mass and t_i one. For Coulomb interaction, C is the negative Coulomb constant, s_j the charge and t_i the
+*   charge-to-mass ratio. The softening length eps removes the singularity of close encounters. The targets are processed in blocks which 
+*   are distributed among the threads, and the sources in tiles which fit into the L1 cache, so that a tile is reused for all targets of a 
+*   block. The innermost loop over the sources is vectorized and uses a branch-free reciprocal square root.
+*
+*   \tparam FP_TYPE_T   The floating point type of the kinematics.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class DirectSumForces : private NonCopyable {
+
+public:
+   
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Direct initialization constructor.
+   *
+   *   \param coupling    The coupling constant C.
+   *   \param softening   The softening length eps.
+   */
+   DirectSumForces( FP_TYPE_T coupling, FP_TYPE_T softening = FP_TYPE_T( 0 ) ) : coupling_( coupling ), softening_( softening ) {
+      SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >();
+   }
+   
+   /** Default destructor. */
+   ~DirectSumForces() = default;
+   
+   /** @} */
+   
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the coupling constant.
+   *
+   *   \return   The coupling constant.
+   */
+   inline FP_TYPE_T getCoupling() const    { return coupling_; }
+   
+   /** A function to obtain the softening length.
+   *
+   *   \return   The softening length.
+   */
+   inline FP_TYPE_T getSoftening() const   { return softening_; }
+   
+   /** @} */
+   
+   /** \name Primary functionality
+   *   @{
+   */
+   /** A function which computes the accelerations of all objects of the kinematics and writes them into its acceleration field. The 
+   *   source strengths are gathered into the storage order of the kinematics beforehand. The interaction rate is reported as a level 2 
+   *   event. Notes on exception safety: strong safety guaranteed. The function throws an AllocError exception if the required resource 
+   *   allocation were not possible.
+   *
+   *   \param kinematics   The kinematics of the world.
+   *   \param source       The source strengths, indexed by handle index (see WorldKinematicsBB::getHandleIndex).
+   *   \param target       The target factors, indexed by handle index. If it is nullptr, every factor is one.
+   */
+   void apply( WorldKinematicsBB<FP_TYPE_T> & kinematics, const FP_TYPE_T * source, const FP_TYPE_T * target = nullptr ) const {
+      
+      const large_t size = kinematics.getSize();
+      if( size == 0 )
+         return;
+      
+      SN_ASSERT( source != nullptr );
+      
+      const SoASpan3<const FP_TYPE_T> pos = kinematics.getPositionSpan();
+      const SoASpan3<FP_TYPE_T> acc = kinematics.getAccelerationSpan();
+      const large_t * indices = kinematics.getObjectIndices();
+      
+      // The sources in slot order, so that the innermost loop remains unit-stride.
+      RAIIWrapper< FP_TYPE_T, SIMDAlignedAlloc > strengths = createRAIIWrapper< FP_TYPE_T, SIMDAlignedAlloc >( size );
+      FP_TYPE_T * s = strengths.raw_ptr();
+      
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t j = 0; j < size; ++j )
+         s[j] = source[ indices[j] ];
+      SN_OPENMP_SYNC()
+      
+      const FP_TYPE_T * x = pos.x;
+      const FP_TYPE_T * y = pos.y;
+      const FP_TYPE_T * z = pos.z;
+      
+      const FP_TYPE_T eps2 = softening_ * softening_;
+      const FP_TYPE_T coupling = coupling_;
+      const large_t blocks = ( size + TARGET_BLOCK - 1 ) / TARGET_BLOCK;
+      
+      ProcTimer timer;
+      
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t block = 0; block < blocks; ++block ) {
+         
+         const large_t i0 = block * TARGET_BLOCK;
+         const large_t i1 = std::min( i0 + TARGET_BLOCK, size );
+         
+         FP_TYPE_T sum_x[ TARGET_BLOCK ] = {};
+         FP_TYPE_T sum_y[ TARGET_BLOCK ] = {};
+         FP_TYPE_T sum_z[ TARGET_BLOCK ] = {};
+         
+         for( large_t j0 = 0; j0 < size; j0 += SOURCE_TILE ) {
+            
+            const large_t j1 = std::min( j0 + SOURCE_TILE, size );
+            
+            for( large_t i = i0; i < i1; ++i ) {
+               
+               const FP_TYPE_T xi = x[i];
+               const FP_TYPE_T yi = y[i];
+               const FP_TYPE_T zi = z[i];
+               
+               FP_TYPE_T ax = FP_TYPE_T( 0 );
+               FP_TYPE_T ay = FP_TYPE_T( 0 );
+               FP_TYPE_T az = FP_TYPE_T( 0 );
+               
+               SN_OPENMP_SIMD_LOOP( OMP_REDUCTION( + : ax, ay, az ) )
+               for( large_t j = j0; j < j1; ++j ) {
+                  
+                  const FP_TYPE_T dx = x[j] - xi;
+                  const FP_TYPE_T dy = y[j] - yi;
+                  const FP_TYPE_T dz = z[j] - zi;
+                  const FP_TYPE_T r2 = dx * dx + dy * dy + dz * dz + eps2;
+                  
+                  // The self-interaction (and any coincident pair without softening) does not contribute, see RSqrt.
+                  const FP_TYPE_T rinv = forces::internal::RSqrt< FP_TYPE_T >::eval( r2 );
+                  const FP_TYPE_T w = s[j] * rinv * rinv * rinv;
+                  
+                  ax += w * dx;
+                  ay += w * dy;
+                  az += w * dz;
+               }
+               
+               sum_x[ i - i0 ] += ax;
+               sum_y[ i - i0 ] += ay;
+               sum_z[ i - i0 ] += az;
+            }
+         }
+         
+         for( large_t i = i0; i < i1; ++i ) {
+            
+            const FP_TYPE_T factor = ( target != nullptr ) ? coupling * target[ indices[i] ] : coupling;
+            acc.x[i] = factor * sum_x[ i - i0 ];
+            acc.y[i] = factor * sum_y[ i - i0 ];
+            acc.z[i] = factor * sum_z[ i - i0 ];
+         }
+      }
+      SN_OPENMP_SYNC()
+      
+      const real_t seconds = timer.getAge();
+      if( seconds > real_cast( 0 ) ) {
+         SN_LOG_REPORT_L2_EVENT( "Forces", "DirectSumForces::apply computed " << size * size << " interactions at " 
+                                           << real_cast( size ) * real_cast( size ) / seconds * real_cast( 1e-9 ) << " G/s" );
+      }
+   }
+   
+   /** @} */
+   
+private:
+   
+   /* Blocking */
+   static constexpr large_t TARGET_BLOCK = 64;                                                       ///< Targets per block.
+   static constexpr large_t SOURCE_TILE  = globalConstants::L1_BLOCK_SIZE / ( 4 * sizeof( FP_TYPE_T ) );   ///< Sources per tile.
+   
+   /* Members */
+   FP_TYPE_T coupling_;    ///< The coupling constant.
+   FP_TYPE_T softening_;   ///< The softening length.
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T > constexpr large_t DirectSumForces< FP_TYPE_T >::TARGET_BLOCK;
+template< typename FP_TYPE_T > constexpr large_t DirectSumForces< FP_TYPE_T >::SOURCE_TILE;
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -0,0 +1,335 @@
+#ifndef SN_VERLETLIST_HPP
+#define SN_VERLETLIST_HPP
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <Types.hpp>
+#include <Global.hpp>
+#include <BasicBases.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/DArray.hpp>
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+#include <core/ProcTimer.hpp>
+
+#include <core/World.hpp>
+#include <core/kinematics/WorldKinematicsBB.hpp>
+#include <core/forces/CellList.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class VerletList, which stores the neighbours of every object within the cutoff plus a skin in compressed rows.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class stores, for every object, the slots of all objects closer than the cutoff plus a skin in the compressed sparse row format:
+*   the neighbours of object i are neighbours[ offsets[i] ] to neighbours[ offsets[i+1] - 1 ]. Every pair is stored in the rows of both its
+*   objects, so that a force kernel may traverse the rows in parallel and write to the row object only. The list is built from a CellList
+*   with the enlarged cutoff in two passes of its race-free pair traversal, one counting and one filling the rows.
+*
+*   As long as no object has moved by more than half the skin since the build, every pair within the cutoff is still contained in the list.
+*   The displacement is taken from the displacement bound of the kinematics, which the integrators maintain within their kernels, so that
+*   update() only rebuilds when this is no longer guaranteed, or when the number of objects or their storage order has changed.
+*
+*   The list may also be built from the owned objects and the ghosts of a halo exchange (see WorldKinematicsBB::getHaloPositionSpan). The
+*   ghosts are sources only: there is a row for every owned object, and a ghost appears in the rows of the owned objects near it. Since the
+*   ghosts are received anew by every halo exchange, such a list is valid until the next exchange only.
+*
+*   \tparam FP_TYPE_T   The floating point type of the positions.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class VerletList : private NonCopyable {
+
+public:
+
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** Direct initialization constructor.
+   *
+   *   \param corner   The lower corner of the domain.
+   *   \param extent   The extent of the domain in each dimension.
+   *   \param cutoff   The interaction cutoff.
+   *   \param skin     The skin which is added to the cutoff when building the list.
+   */
+   VerletList( const Vector3<FP_TYPE_T> & corner, const Vector3<FP_TYPE_T> & extent, FP_TYPE_T cutoff, FP_TYPE_T skin )
+   : cells_( corner, extent, cutoff + skin ), cutoff_( cutoff ), skin_( skin ) {
+
+      SN_ASSERT( skin >= FP_TYPE_T( 0 ) );
+   }
+
+   /** Constructor which takes the domain of a world. Notes on exception safety: strong safety guaranteed. A PreconditionError exception is
+   *   thrown if the domain of the world has not been set up.
+   *
+   *   \param world    The world, whose domain is covered by the cells.
+   *   \param cutoff   The interaction cutoff.
+   *   \param skin     The skin which is added to the cutoff when building the list.
+   */
+   template< class KINEMATICS_BB >
+   VerletList( const World< FP_TYPE_T, KINEMATICS_BB > & world, FP_TYPE_T cutoff, FP_TYPE_T skin )
+   : cells_( world, cutoff + skin ), cutoff_( cutoff ), skin_( skin ) {
+
+      SN_ASSERT( skin >= FP_TYPE_T( 0 ) );
+   }
+
+   /** Default destructor. */
+   ~VerletList();
+
+   /** @} */
+
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the interaction cutoff.
+   *
+   *   \return   The cutoff.
+   */
+   inline FP_TYPE_T getCutoff() const             { return cutoff_; }
+
+   /** A function to obtain the skin.
+   *
+   *   \return   The skin.
+   */
+   inline FP_TYPE_T getSkin() const               { return skin_; }
+
+   /** A function to obtain the number of objects of the last build.
+   *
+   *   \return   The number of rows.
+   */
+   inline large_t getSize() const                 { return size_; }
+
+   /** A function to obtain the number of positions of the last build, i.e., the number of owned objects plus the number of ghosts.
+   *
+   *   \return   The number of sources.
+   */
+   inline large_t getSourceCount() const          { return sources_; }
+
+   /** A function to obtain the number of times the list has been built.
+   *
+   *   \return   The number of builds.
+   */
+   inline large_t getBuildCount() const           { return builds_; }
+
+   /** A function to obtain the row offsets.
+   *
+   *   \return   A pointer to the getSize() + 1 offsets.
+   */
+   inline const large_t * getOffsets() const      { return offsets_.raw_ptr(); }
+
+   /** A function to obtain the packed neighbour slots.
+   *
+   *   \return   A pointer to the neighbour slots.
+   */
+   inline const large_t * getNeighbours() const   { return neighbours_.raw_ptr(); }
+
+   /** A function to obtain the number of neighbours of an object.
+   *
+   *   \param slot   The slot of the object (see WorldKinematicsBB::getSlot).
+   *   \return       The number of neighbours within the cutoff plus the skin at the last build.
+   */
+   inline large_t getNeighbourCount( large_t slot ) const {
+
+      SN_ASSERT_INDEX_WITHIN_SIZE( slot, size_ );
+
+      return offsets_[ slot + 1 ] - offsets_[slot];
+   }
+
+   /** @} */
+
+   /** \name Primary functionality
+   *   @{
+   */
+   /** A function which rebuilds the list if the displacement bound of the kinematics exceeds half the skin or if the number of objects
+   *   or their storage order has changed. Notes on exception safety: basic safety guaranteed. The function throws an AllocError exception
+   *   if the required resource allocation were not possible.
+   *
+   *   \param kinematics   The kinematics of the world.
+   *   \return             true if the list was rebuilt, false if not.
+   */
+   flag_t update( WorldKinematicsBB<FP_TYPE_T> & kinematics ) {
+
+      if( builds_ > 0 && kinematics.getSize() == size_ && sources_ == size_ && kinematics.getLayoutVersion() == layout_version_ &&
+          kinematics.getDisplacementBound() <= FP_TYPE_T( 0.5 ) * skin_ )
+         return false;
+
+      build( kinematics );
+      return true;
+   }
+
+   /** A function which builds the list from the current positions and resets the displacement bound of the kinematics. Notes on exception
+   *   safety: basic safety guaranteed. The function throws an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param kinematics   The kinematics of the world.
+   */
+   void build( WorldKinematicsBB<FP_TYPE_T> & kinematics )   { build( kinematics, kinematics.getPositionSpan() ); }
+
+   /** A function which builds the list from the current positions of the owned objects and of the ghosts, and resets the displacement
+   *   bound of the kinematics. The list has a row for every owned object, whose neighbours may include ghosts. Notes on exception safety:
+   *   basic safety guaranteed. The function throws an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param kinematics   The kinematics of the world.
+   *   \param pos          The positions of the owned objects and the ghosts (see WorldKinematicsBB::getHaloPositionSpan).
+   */
+   void build( WorldKinematicsBB<FP_TYPE_T> & kinematics, SoASpan3<const FP_TYPE_T> pos ) {
+
+      const large_t size = kinematics.getSize();
+
+      SN_ASSERT( pos.size >= size );
+
+      #ifdef NDEBUG
+      if( pos.size < size )
+         SN_THROW_INVALID_ARGUMENT( "IA_VerletList_Sources_Error" );
+      #endif
+
+      ProcTimer timer;
+
+      cells_.build( pos, size );
+
+      if( offsets_.getSize() != size + 1 )
+         offsets_.resize( size + 1 );
+
+      // First pass: count the neighbours of every object into the following offset.
+      large_t * offsets = offsets_.raw_ptr();
+      offsets_.fill( 0 );
+      cells_.forEachPair( pos, [=]( large_t i, large_t j, FP_TYPE_T, FP_TYPE_T, FP_TYPE_T, FP_TYPE_T ) {
+         ++offsets[ i + 1 ];
+         if( j < size )
+            ++offsets[ j + 1 ];
+      } );
+
+      for( large_t i = 0; i < size; ++i )
+         offsets[ i + 1 ] += offsets[i];
+
+      const large_t total = offsets[size];
+      if( total > neighbours_.getSize() )
+         neighbours_.resize( total + total / 8 );   // Some slack, since the number of pairs fluctuates between builds.
+
+      // Second pass: fill the rows.
+      try {
+         cursor_.assign( offsets, offsets + size );
+      }
+      catch( const std::bad_alloc & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+
+      large_t * cursor = cursor_.data();
+      large_t * neighbours = neighbours_.raw_ptr();
+      cells_.forEachPair( pos, [=]( large_t i, large_t j, FP_TYPE_T, FP_TYPE_T, FP_TYPE_T, FP_TYPE_T ) {
+         neighbours[ cursor[i]++ ] = j;
+         if( j < size )
+            neighbours[ cursor[j]++ ] = i;
+      } );
+
+      size_ = size;
+      sources_ = pos.size;
+      layout_version_ = kinematics.getLayoutVersion();
+      ++builds_;
+      kinematics.resetDisplacementBound();
+
+      SN_LOG_REPORT_L2_EVENT( "Neighbours", "VerletList::build stored " << total << " neighbours of " << size << " objects in "
+                                            << timer.getAge() << " s" );
+   }
+
+   /** A function which calls a kernel for every neighbour within the cutoff of every object. The objects are distributed among the threads,
+   *   and each pair is visited twice, once from either side. The kernel may therefore write to the first object without synchronization.
+   *   If the list was built with ghosts, the second object may be a ghost, which is never the first.
+   *
+   *   \tparam PAIR_KERNEL   A callable with the signature void( large_t i, large_t j, FP_TYPE_T dx, FP_TYPE_T dy, FP_TYPE_T dz, FP_TYPE_T r2 ),
+   *                         where ( dx, dy, dz ) is the position of j relative to i and r2 its squared length.
+   *   \param pos            A view of the positions, indexed by slot, which covers the same sources as the last build.
+   *   \param kernel         The pair kernel.
+   */
+   template< class PAIR_KERNEL >
+   void forEachNeighbour( SoASpan3<const FP_TYPE_T> pos, PAIR_KERNEL && kernel ) const {
+
+      SN_ASSERT( pos.size == sources_ );
+
+      const large_t size = size_;
+      const FP_TYPE_T cutoff2 = cutoff_ * cutoff_;
+      const large_t * offsets = offsets_.raw_ptr();
+      const large_t * neighbours = neighbours_.raw_ptr();
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_DYNAMIC_CS( 64 ) )
+      for( large_t i = 0; i < size; ++i ) {
+
+         const FP_TYPE_T xi = pos.x[i];
+         const FP_TYPE_T yi = pos.y[i];
+         const FP_TYPE_T zi = pos.z[i];
+
+         for( large_t n = offsets[i]; n < offsets[ i + 1 ]; ++n ) {
+
+            const large_t j = neighbours[n];
+            const FP_TYPE_T dx = pos.x[j] - xi;
+            const FP_TYPE_T dy = pos.y[j] - yi;
+            const FP_TYPE_T dz = pos.z[j] - zi;
+            const FP_TYPE_T r2 = dx * dx + dy * dy + dz * dz;
+
+            if( r2 < cutoff2 )
+               kernel( i, j, dx, dy, dz, r2 );
+         }
+      }
+      SN_OPENMP_SYNC()
+   }
+
+   /** @} */
+
+private:
+
+   /* Members */
+   CellList<FP_TYPE_T> cells_;                 ///< The cells of the enlarged cutoff.
+   FP_TYPE_T cutoff_;                          ///< The interaction cutoff.
+   FP_TYPE_T skin_;                            ///< The skin.
+
+   large_t size_ = 0;                          ///< The number of objects of the last build.
+   large_t sources_ = 0;                       ///< The number of owned objects and ghosts of the last build.
+   large_t builds_ = 0;                        ///< The number of builds.
+   large_t layout_version_ = 0;                ///< The layout version of the kinematics at the last build.
+
+   DArray< large_t > offsets_ = DArray< large_t >( 1, 0 );      ///< The row offsets.
+   DArray< large_t > neighbours_ = DArray< large_t >( 1, 0 );   ///< The packed neighbour slots.
+   std::vector< large_t > cursor_;                              ///< The fill cursors of the rows.
+};
+
+
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T > VerletList< FP_TYPE_T >::~VerletList() = default;
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
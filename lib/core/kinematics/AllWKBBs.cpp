@@ -0,0 +1,39 @@
+#include "AllWKBBs.hpp"
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the explicit instantiations of all kinematics black-boxes with the floating point types.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+template class EulerExplicitWKBB< real_t >;
+template class EulerExplicitWKBB< single_t >;
+template class VelocityVerletWKBB< real_t >;
+template class VelocityVerletWKBB< single_t >;
+template class LeapfrogWKBB< real_t >;
+template class LeapfrogWKBB< single_t >;
+template class RungeKutta4WKBB< real_t >;
+template class RungeKutta4WKBB< single_t >;
+
+}   // namespace simpleNewton
+#endif
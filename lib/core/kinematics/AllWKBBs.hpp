@@ -25,5 +25,8 @@
 
 #include "WorldKinematicsBB.hpp"
 #include "EulerExplicitWKBB.hpp"
+#include "VelocityVerletWKBB.hpp"
+#include "LeapfrogWKBB.hpp"
+#include "RungeKutta4WKBB.hpp"
 
 #endif   // header guard
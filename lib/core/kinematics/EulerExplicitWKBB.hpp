@@ -5,13 +5,14 @@
 #include <vector>
 
 #include <Types.hpp>
+#include <Global.hpp>
 
 #include <asserts/Asserts.hpp>
 #include <asserts/TypeConstraints.hpp>
 
 #include <core/Exceptions.hpp>
 
-#include <containers/Field.hpp>
+#include <containers/SoAField3.hpp>
 #include <containers/Vector3.hpp>
 
 #include <concurrency/OpenMP.hpp>
@@ -58,13 +59,14 @@ class EulerExplicitWKBB : public WorldKinematicsBB<FP_TYPE_T> {
    using WorldKinematicsBB<FP_TYPE_T>::size_;
 
    
-   EulerExplicitWKBB() = default;
-   
 public:
    
-   /** \name Destructor
+   /** \name Constructors and destructor
    *   @{
    */
+   /** The default constructor creates kinematics without any objects. */
+   EulerExplicitWKBB() = default;
+   
    ~EulerExplicitWKBB() = default;
 
    /** @} */
@@ -76,37 +78,71 @@ public:
    /** A function which allocates field resources for a new object. Notes on exception safety: basic safety guaranteed. The function throws 
    *   an AllocError exception if the required resource allocation were not possible.
    *
-   *   \return   A handle to the newly created object
+   *   \return   A handle to the newly created object.
    */
    Object_ID_t createObject() override final {
-      
-      try {
-         
-         position_.pushBack();
-         velocity_.pushBack();
-         acceleration_.pushBack();
-      }
-      catch( const AllocError & ) {
-         SN_THROW_ALLOC_ERROR();
-      }
-      
-      return ++size_;
+      return this->appendObject();
    }
 
-   /** A pure virtual function which requires all base classes to implement a method of kinematic integration. */   
+   /** A function which performs the explicit Euler step. The threads share the objects in a static schedule of cache-sized chunks (see 
+   *   getKernelChunk), and every thread streams through the x, y and z components of its chunks in a vectorized loop. The achieved memory 
+   *   bandwidth is reported as a level 2 event.
+   */
    void integrate() override final {
       
-      if( size_ == 0 )
+      this->clearGhosts();
+      
+      if( size_ == 0 ) {
+         this->completeStep();
          return;
+      }
       
       SN_ASSERT( position_.getSize() == size_ && velocity_.getSize() == size_ && acceleration_.getSize() == size_ );
       
-      SN_OPENMP_SIMD_LOOP( OMP_PRIVATE( timeStep_ ) )
-      for( large_t i = 0; i < size_; ++i ) {
-
-         position_[i] += velocity_[i] * timeStep_;
-         velocity_[i] += acceleration_[i] * timeStep_;
+      const FP_TYPE_T dt = timeStep_;
+      const large_t size = size_;
+      const large_t chunk = this->getKernelChunk();
+      
+      FP_TYPE_T * px = position_.component( 0 );
+      FP_TYPE_T * py = position_.component( 1 );
+      FP_TYPE_T * pz = position_.component( 2 );
+      FP_TYPE_T * vx = velocity_.component( 0 );
+      FP_TYPE_T * vy = velocity_.component( 1 );
+      FP_TYPE_T * vz = velocity_.component( 2 );
+      const FP_TYPE_T * ax = acceleration_.component( 0 );
+      const FP_TYPE_T * ay = acceleration_.component( 1 );
+      const FP_TYPE_T * az = acceleration_.component( 2 );
+      
+      FP_TYPE_T step2 = FP_TYPE_T( 0 );
+      
+      ProcTimer timer;
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) OMP_REDUCTION( max : step2 )
+                               OMP_ALIGNED( px, py, pz, vx, vy, vz, ax, ay, az : globalConstants::SIMD_ALIGNMENT ) )
+      for( large_t i = 0; i < size; ++i ) {
+         
+         const FP_TYPE_T dx = vx[i] * dt;
+         const FP_TYPE_T dy = vy[i] * dt;
+         const FP_TYPE_T dz = vz[i] * dt;
+         step2 = std::max( step2, dx * dx + dy * dy + dz * dz );
+
+         px[i] += dx;
+         py[i] += dy;
+         pz[i] += dz;
+         
+         vx[i] += ax[i] * dt;
+         vy[i] += ay[i] * dt;
+         vz[i] += az[i] * dt;
       }
+      SN_OPENMP_SYNC()
+      
+      this->trackDisplacement( step2 );
+      
+      // Loads of position, velocity and acceleration, stores of position and velocity.
+      this->reportBandwidth( "EulerExplicitWKBB::integrate", 15 * size * sizeof( FP_TYPE_T ), timer.getAge() );
+      
+      this->completeStep();
    }
    
    /** @} */
@@ -0,0 +1,126 @@
+#ifndef SN_LEAPFROGWKBB_HPP
+#define SN_LEAPFROGWKBB_HPP
+
+#include <Types.hpp>
+#include <Global.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+#include "WorldKinematicsBB.hpp"
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class LeapfrogWKBB, which derives from WorldKinematicsBB and implements the leapfrog method.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class implements the second order, symplectic leapfrog method in its kick-drift form, in which the velocities are stored at the 
+*   half time steps between the positions. The accelerations are expected to have been computed for the current positions whenever 
+*   integrate is called. The first call kicks the initial velocities by half a time step, every further call kicks them by a full step. Each 
+*   step is a single, fused pass over the state. Velocities which are synchronous with the positions are available through 
+*   getSynchronizedVelocity.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class LeapfrogWKBB : public WorldKinematicsBB<FP_TYPE_T> {
+
+   /* Ancestral visibility */
+   using WorldKinematicsBB<FP_TYPE_T>::timeStep_;
+   using WorldKinematicsBB<FP_TYPE_T>::size_;
+
+   
+public:
+   
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** The default constructor creates kinematics without any objects. */
+   LeapfrogWKBB() = default;
+   
+   ~LeapfrogWKBB() = default;
+
+   /** @} */
+   
+   /** \name Access
+   *   @{
+   */
+   /** A function to obtain the velocity of an object at the time of the current positions, interpolated from the staggered velocity with 
+   *   the current acceleration. The accelerations have to have been computed for the current positions. Notes on exception safety: strong 
+   *   safety guaranteed. The function throws an OORError exception if the provided index is invalid.
+   *
+   *   \param handle   The handle which identifies the physical object.
+   *   \return         The synchronized velocity vector of the physical object.
+   */
+   Vector3<FP_TYPE_T> getSynchronizedVelocity( Object_ID_t handle ) const {
+      return this->getVelocity( handle ) + this->getAcceleration( handle ) * ( lastStep_ / FP_TYPE_T( 2 ) );
+   }
+   
+   /** @} */
+   
+   /** \name Primary functionality
+   *   @{
+   */
+
+   /** A function which allocates field resources for a new object. Notes on exception safety: basic safety guaranteed. The function throws 
+   *   an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \return   A handle to the newly created object.
+   */
+   Object_ID_t createObject() override final {
+      return this->appendObject();
+   }
+   
+   /** A function which performs a leapfrog step: the kick of the staggered velocities from the previous half step to the next, followed 
+   *   by the drift, in one fused pass over the state.
+   */
+   void integrate() override final {
+      
+      this->clearGhosts();
+      
+      this->kickDrift( ( lastStep_ + timeStep_ ) / FP_TYPE_T( 2 ), timeStep_, "LeapfrogWKBB::integrate" );
+      lastStep_ = timeStep_;
+      
+      this->completeStep();
+   }
+   
+   /** @} */
+   
+private:
+   
+   /** The time step of the previous call of integrate, zero before the first call. */
+   FP_TYPE_T lastStep_ = {};
+};
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -0,0 +1,343 @@
+#ifndef SN_RUNGEKUTTA4WKBB_HPP
+#define SN_RUNGEKUTTA4WKBB_HPP
+
+#include <functional>
+
+#include <Types.hpp>
+#include <Global.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+#include "WorldKinematicsBB.hpp"
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class RungeKutta4WKBB, which derives from WorldKinematicsBB and implements the classical Runge-Kutta method of fourth
+///   order.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class implements the classical, fourth order Runge-Kutta method for forcings which may depend on time, position and velocity, 
+*   e.g. drag or driven, non-conservative forcing. The forcing is evaluated four times per step. Between two evaluations a single, fused 
+*   pass over memory accumulates the weighted stage and builds the state of the next stage. The four stage buffers which this requires, 
+*   the accumulated positions and velocities and the stage positions and velocities, are grown along with the state and reused across all 
+*   steps. If no forcing has been set, the accelerations stored in the kinematics are held constant over the step.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class RungeKutta4WKBB : public WorldKinematicsBB<FP_TYPE_T> {
+
+   /* Ancestral visibility */
+   using WorldKinematicsBB<FP_TYPE_T>::currentTime_;
+   using WorldKinematicsBB<FP_TYPE_T>::timeStep_;
+
+   using WorldKinematicsBB<FP_TYPE_T>::position_;
+   using WorldKinematicsBB<FP_TYPE_T>::velocity_;
+   using WorldKinematicsBB<FP_TYPE_T>::acceleration_;
+
+   using WorldKinematicsBB<FP_TYPE_T>::size_;
+
+   
+public:
+   
+   /** This typedef identifies the forcing, which computes the accelerations of all objects at a given time, from given positions and 
+   *   velocities.
+   */
+   using Forcing = std::function< void( FP_TYPE_T , SoASpan3<const FP_TYPE_T> , SoASpan3<const FP_TYPE_T> , SoASpan3<FP_TYPE_T> ) >;
+   
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** The default constructor creates kinematics without any objects. */
+   RungeKutta4WKBB() = default;
+   
+   ~RungeKutta4WKBB();
+
+   /** @} */
+   
+   /** \name Access
+   *   @{
+   */
+   /** A function to set the forcing. It is called with the time, the positions and the velocities of a stage and writes the accelerations 
+   *   into the last argument.
+   *
+   *   \param forcing   The forcing.
+   */
+   void setForcing( Forcing forcing )   { forcing_ = std::move( forcing ); }
+   
+   /** @} */
+   
+   /** \name Primary functionality
+   *   @{
+   */
+
+   /** A function which allocates field resources for a new object. Notes on exception safety: basic safety guaranteed. The function throws 
+   *   an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \return   A handle to the newly created object.
+   */
+   Object_ID_t createObject() override final {
+      return this->appendObject();
+   }
+   
+   /** A function which performs a Runge-Kutta step and advances the current time (see completeStep). The accelerations hold those of the
+   *   last stage upon return.
+   */
+   void integrate() override final {
+      
+      this->clearGhosts();
+      
+      if( size_ == 0 ) {
+         this->completeStep();
+         return;
+      }
+      
+      SN_ASSERT( sumPosition_.getSize() == size_ && stageVelocity_.getSize() == size_ );
+      
+      const FP_TYPE_T t  = currentTime_;
+      const FP_TYPE_T dt = timeStep_;
+      const FP_TYPE_T sixth = dt / FP_TYPE_T( 6 );
+      const FP_TYPE_T third = dt / FP_TYPE_T( 3 );
+      const FP_TYPE_T half  = dt / FP_TYPE_T( 2 );
+      
+      evaluate( t, position_, velocity_ );
+      accumulate( true, sixth, half );
+      
+      evaluate( t + half, stagePosition_, stageVelocity_ );
+      accumulate( false, third, half );
+      
+      evaluate( t + half, stagePosition_, stageVelocity_ );
+      accumulate( false, third, dt );
+      
+      evaluate( t + dt, stagePosition_, stageVelocity_ );
+      finish( sixth );
+      
+      this->completeStep();
+   }
+   
+   /** @} */
+   
+protected:
+   
+   /** A function which grows the state fields and the stage buffers by n objects.
+   *
+   *   \param n   The number of objects to be appended.
+   */
+   void growObjects( large_t n ) override {
+      
+      WorldKinematicsBB<FP_TYPE_T>::growObjects( n );
+      
+      const large_t chunk = this->getKernelChunk();
+      const Vector3<FP_TYPE_T> zero( FP_TYPE_T( 0 ) );
+      
+      sumPosition_.pushBackN( n, zero, chunk );
+      sumVelocity_.pushBackN( n, zero, chunk );
+      stagePosition_.pushBackN( n, zero, chunk );
+      stageVelocity_.pushBackN( n, zero, chunk );
+   }
+   
+   /** A function which reserves the state fields and the stage buffers for n objects.
+   *
+   *   \param n   The number of objects which the fields are to accommodate.
+   */
+   void reserveObjects( large_t n ) override {
+      
+      WorldKinematicsBB<FP_TYPE_T>::reserveObjects( n );
+      
+      sumPosition_.reserve( n );
+      sumVelocity_.reserve( n );
+      stagePosition_.reserve( n );
+      stageVelocity_.reserve( n );
+   }
+   
+   /** A function which shrinks the state fields and the stage buffers by n objects. The stage buffers only hold intermediate results of a 
+   *   step, so they are neither moved nor permuted along with the state.
+   *
+   *   \param n   The number of objects to be removed.
+   */
+   void shrinkObjects( large_t n ) override {
+      
+      WorldKinematicsBB<FP_TYPE_T>::shrinkObjects( n );
+      
+      for( large_t k = 0; k < n; ++k ) {
+         
+         sumPosition_.popBack();
+         sumVelocity_.popBack();
+         stagePosition_.popBack();
+         stageVelocity_.popBack();
+      }
+   }
+   
+private:
+   
+   /* Stage evaluation: the accelerations of a stage are computed into the acceleration field. */
+   void evaluate( FP_TYPE_T t, const SoAField3< FP_TYPE_T, 10000, HugePageAlloc > & pos, 
+                              const SoAField3< FP_TYPE_T, 10000, HugePageAlloc > & vel ) {
+      
+      if( forcing_ )
+         forcing_( t, pos.span(), vel.span(), acceleration_.span() );
+   }
+   
+   /* Fused pass after the first three stages. The sums are started from (or added to) with weight w, and the state of the next stage is 
+   *  built with the step h. The first stage differentiates the positions with the state velocities, all others with the stage velocities.
+   */
+   void accumulate( flag_t first, FP_TYPE_T w, FP_TYPE_T h ) {
+      
+      const large_t size = size_;
+      const large_t chunk = this->getKernelChunk();
+      
+      ProcTimer timer;
+      
+      SN_OPENMP_FORK()
+      for( small_t dim = 0; dim < 3; ++dim ) {
+         
+         const FP_TYPE_T * x = position_.component( dim );
+         const FP_TYPE_T * v = velocity_.component( dim );
+         const FP_TYPE_T * a = acceleration_.component( dim );
+         FP_TYPE_T * xa = sumPosition_.component( dim );
+         FP_TYPE_T * va = sumVelocity_.component( dim );
+         FP_TYPE_T * xs = stagePosition_.component( dim );
+         FP_TYPE_T * vs = stageVelocity_.component( dim );
+         
+         if( first ) {
+            
+            SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) OMP_NOWAIT 
+                                     OMP_ALIGNED( x, v, a, xa, va, xs, vs : globalConstants::SIMD_ALIGNMENT ) )
+            for( large_t i = 0; i < size; ++i ) {
+               
+               xa[i] = x[i] + w * v[i];
+               va[i] = v[i] + w * a[i];
+               xs[i] = x[i] + h * v[i];
+               vs[i] = v[i] + h * a[i];
+            }
+         }
+         else {
+            
+            SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) OMP_NOWAIT 
+                                     OMP_ALIGNED( x, v, a, xa, va, xs, vs : globalConstants::SIMD_ALIGNMENT ) )
+            for( large_t i = 0; i < size; ++i ) {
+               
+               const FP_TYPE_T k = vs[i];
+               
+               xa[i] += w * k;
+               va[i] += w * a[i];
+               xs[i] = x[i] + h * k;
+               vs[i] = v[i] + h * a[i];
+            }
+         }
+      }
+      SN_OPENMP_SYNC()
+      
+      // First pass: loads of x, v, a and stores of the four buffers. Further passes additionally load the sums and the stage velocities.
+      this->reportBandwidth( "RungeKutta4WKBB::accumulate", ( first ? 21 : 30 ) * size * sizeof( FP_TYPE_T ), timer.getAge() );
+   }
+   
+   /* Fused pass after the last stage: the state is the sum plus the last stage with weight w. The components are updated in a single 
+   *  loop, so that the largest displacement of the step can be reduced along the way.
+   */
+   void finish( FP_TYPE_T w ) {
+      
+      const large_t size = size_;
+      const large_t chunk = this->getKernelChunk();
+      
+      FP_TYPE_T * x = position_.component( 0 );
+      FP_TYPE_T * y = position_.component( 1 );
+      FP_TYPE_T * z = position_.component( 2 );
+      FP_TYPE_T * vx = velocity_.component( 0 );
+      FP_TYPE_T * vy = velocity_.component( 1 );
+      FP_TYPE_T * vz = velocity_.component( 2 );
+      const FP_TYPE_T * ax = acceleration_.component( 0 );
+      const FP_TYPE_T * ay = acceleration_.component( 1 );
+      const FP_TYPE_T * az = acceleration_.component( 2 );
+      const FP_TYPE_T * xa = sumPosition_.component( 0 );
+      const FP_TYPE_T * ya = sumPosition_.component( 1 );
+      const FP_TYPE_T * za = sumPosition_.component( 2 );
+      const FP_TYPE_T * vxa = sumVelocity_.component( 0 );
+      const FP_TYPE_T * vya = sumVelocity_.component( 1 );
+      const FP_TYPE_T * vza = sumVelocity_.component( 2 );
+      const FP_TYPE_T * vxs = stageVelocity_.component( 0 );
+      const FP_TYPE_T * vys = stageVelocity_.component( 1 );
+      const FP_TYPE_T * vzs = stageVelocity_.component( 2 );
+      
+      FP_TYPE_T step2 = FP_TYPE_T( 0 );
+      
+      ProcTimer timer;
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) OMP_REDUCTION( max : step2 ) )
+      for( large_t i = 0; i < size; ++i ) {
+         
+         const FP_TYPE_T nx = xa[i] + w * vxs[i];
+         const FP_TYPE_T ny = ya[i] + w * vys[i];
+         const FP_TYPE_T nz = za[i] + w * vzs[i];
+         const FP_TYPE_T dx = nx - x[i];
+         const FP_TYPE_T dy = ny - y[i];
+         const FP_TYPE_T dz = nz - z[i];
+         step2 = std::max( step2, dx * dx + dy * dy + dz * dz );
+         
+         x[i] = nx;
+         y[i] = ny;
+         z[i] = nz;
+         vx[i] = vxa[i] + w * ax[i];
+         vy[i] = vya[i] + w * ay[i];
+         vz[i] = vza[i] + w * az[i];
+      }
+      SN_OPENMP_SYNC()
+      
+      this->trackDisplacement( step2 );
+      
+      // Loads of x, the sums, the stage velocities and a, stores of x and v.
+      this->reportBandwidth( "RungeKutta4WKBB::finish", 21 * size * sizeof( FP_TYPE_T ), timer.getAge() );
+   }
+   
+   /** The forcing, which may be empty. */
+   Forcing forcing_ = {};
+   
+   /** \name Stage buffers
+   *   @{
+   */
+   SoAField3< FP_TYPE_T, 10000, HugePageAlloc > sumPosition_ = {};     ///< The weighted sum of the position derivatives.
+   SoAField3< FP_TYPE_T, 10000, HugePageAlloc > sumVelocity_ = {};     ///< The weighted sum of the velocity derivatives.
+   SoAField3< FP_TYPE_T, 10000, HugePageAlloc > stagePosition_ = {};   ///< The positions at which the next stage is evaluated.
+   SoAField3< FP_TYPE_T, 10000, HugePageAlloc > stageVelocity_ = {};   ///< The velocities at which the next stage is evaluated.
+   /** @} */
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T >
+RungeKutta4WKBB< FP_TYPE_T >::~RungeKutta4WKBB() = default;
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -0,0 +1,158 @@
+#ifndef SN_VELOCITYVERLETWKBB_HPP
+#define SN_VELOCITYVERLETWKBB_HPP
+
+#include <functional>
+
+#include <Types.hpp>
+#include <Global.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <core/Exceptions.hpp>
+
+#include <containers/SoAField3.hpp>
+#include <containers/Vector3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+#include "WorldKinematicsBB.hpp"
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the class VelocityVerletWKBB, which derives from WorldKinematicsBB and implements the velocity Verlet method.
+///   \file
+///   \addtogroup math Math
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+//===CLASS==================================================================================================================================
+
+/** This class implements the second order, symplectic velocity Verlet method. A step kicks the velocities by half a time step with the 
+*   accelerations of the current positions, drifts the positions by a full step, computes the accelerations of the new positions with the 
+*   forcing and kicks the velocities by the second half step, so that positions and velocities are synchronous between two calls of 
+*   integrate. The first kick and the drift are fused into a single pass over the state. The accelerations are expected to have been 
+*   computed for the current positions whenever integrate is called, which the forcing of the previous step ensures. The forcing is 
+*   evaluated with the half-step velocities, so that the method is only of second order for forces which do not depend on the velocities. 
+*   If no forcing has been set, the accelerations are held constant over the step.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+class VelocityVerletWKBB : public WorldKinematicsBB<FP_TYPE_T> {
+
+   /* Ancestral visibility */
+   using WorldKinematicsBB<FP_TYPE_T>::currentTime_;
+   using WorldKinematicsBB<FP_TYPE_T>::timeStep_;
+   using WorldKinematicsBB<FP_TYPE_T>::size_;
+
+   
+public:
+   
+   /** This typedef identifies the forcing, which computes the accelerations of all objects at a given time, from given positions and 
+   *   velocities.
+   */
+   using Forcing = std::function< void( FP_TYPE_T , SoASpan3<const FP_TYPE_T> , SoASpan3<const FP_TYPE_T> , SoASpan3<FP_TYPE_T> ) >;
+   
+   /** \name Constructors and destructor
+   *   @{
+   */
+   /** The default constructor creates kinematics without any objects. */
+   VelocityVerletWKBB() = default;
+   
+   ~VelocityVerletWKBB();
+
+   /** @} */
+   
+   /** \name Access
+   *   @{
+   */
+   /** A function to set the forcing. It is called with the time, the positions and the velocities after the drift and writes the 
+   *   accelerations into the last argument.
+   *
+   *   \param forcing   The forcing.
+   */
+   void setForcing( Forcing forcing )   { forcing_ = std::move( forcing ); }
+   
+   /** @} */
+   
+   /** \name Primary functionality
+   *   @{
+   */
+
+   /** A function which allocates field resources for a new object. Notes on exception safety: basic safety guaranteed. The function throws 
+   *   an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \return   A handle to the newly created object.
+   */
+   Object_ID_t createObject() override final {
+      return this->appendObject();
+   }
+   
+   /** A function which performs a velocity Verlet step, i.e., the opening half-kick fused with the drift, the computation of the 
+   *   accelerations of the new positions and the closing half-kick, and advances the current time.
+   */
+   void integrate() override final {
+      
+      openStep();
+      
+      if( forcing_ )
+         forcing_( currentTime_ + timeStep_, this->getPositionSpan(), this->getVelocitySpan(), this->getAccelerationSpan() );
+      
+      closeStep();
+   }
+   
+   /** A function which performs the first part of a step, i.e., the opening half-kick fused with the drift, for callers which compute the
+   *   accelerations of the new positions themselves, e.g., from the owned objects and the ghosts (see Simulator::performTimeStep). The 
+   *   forcing is not evaluated. The step is concluded by closeStep once the accelerations have been computed.
+   */
+   void openStep() {
+      
+      this->clearGhosts();
+      this->kickDrift( timeStep_ / FP_TYPE_T( 2 ), timeStep_, "VelocityVerletWKBB::openStep" );
+   }
+   
+   /** A function which concludes a step which has been opened by openStep, i.e., the closing half-kick with the accelerations of the new
+   *   positions, and advances the current time. The ghosts are discarded, since they are stale after the step.
+   */
+   void closeStep() {
+      
+      this->clearGhosts();
+      this->kick( timeStep_ / FP_TYPE_T( 2 ), "VelocityVerletWKBB::closeStep" );
+      
+      this->completeStep();
+   }
+   
+   /** @} */
+   
+private:
+   
+   /** The forcing, which computes the accelerations of the new positions. */
+   Forcing forcing_ = {};
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template< typename FP_TYPE_T >
+VelocityVerletWKBB< FP_TYPE_T >::~VelocityVerletWKBB() = default;
+#endif   // DOXYSKIP
+
+}   // namespace simpleNewton
+
+#endif   // header guard
@@ -2,20 +2,28 @@
 #define SN_WORLDKINEMATICSBB_HPP
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 #include <Types.hpp>
+#include <Global.hpp>
 #include <BasicBases.hpp>
 
 #include <asserts/Asserts.hpp>
 #include <asserts/TypeConstraints.hpp>
 
 #include <containers/Field.hpp>
+#include <containers/SoAField3.hpp>
 #include <containers/Vector3.hpp>
 
+#include <concurrency/OpenMP.hpp>
+
 #include <core/Exceptions.hpp>
+#include <core/ProcTimer.hpp>
 
 #include <geometry/Object.hpp>
+#include <geometry/SpaceFillingCurve.hpp>
 
 //==========================================================================================================================================
 //
@@ -42,12 +50,35 @@
 /** The space in which all global entities of the framework are accessible */
 namespace simpleNewton {
 
+//===CLASS==================================================================================================================================
+
+/** This struct describes a contiguous, half-open range of object handles [first, last) as returned by the batched creation of objects.
+*/
+//==========================================================================================================================================
+
+struct HandleRange {
+
+   Object_ID_t first;   ///< The handle of the first object in the range.
+   Object_ID_t last;    ///< The handle following that of the last object in the range.
+
+   /** A function to obtain the number of handles in the range.
+   *
+   *   \return   The number of handles.
+   */
+   inline large_t getSize() const   { return last - first; }
+};
+
+
+
 template< typename FP_TYPE_T >
 class WorldKinematicsBB : private NonCopyable, private NonMovable {
 
    /* A friend indeed! And for generations to come. */
    template< typename FP_T, class KINEMATICS_BB > friend class World;
    
+protected:
+   
+   /* Only black boxes and the world may create kinematics. */
    WorldKinematicsBB() { SN_CT_REQUIRE_FP_TYPE< FP_TYPE_T >(); }
    
 public:
@@ -55,6 +86,17 @@ public:
    /** This typedef identifies the floating point precision type being employed by the kinematics engine. */
    using precType = FP_TYPE_T;
    
+   /** The number of low bits of a handle which hold its index. The remaining high bits hold the generation of the index, which is 
+   *   incremented whenever an object is deleted, so that stale handles to a reused index are detected.
+   */
+   static constexpr small_t HANDLE_INDEX_BITS = 40;
+   
+   /** The mask of the index bits of a handle. */
+   static constexpr Object_ID_t HANDLE_INDEX_MASK = ( Object_ID_t( 1 ) << HANDLE_INDEX_BITS ) - 1;
+   
+   /** The largest generation of an index. An index which reaches it is retired instead of being reused. */
+   static constexpr large_t HANDLE_MAX_GENERATION = large_t( std::numeric_limits< Object_ID_t >::max() >> HANDLE_INDEX_BITS );
+   
    /** \name Constructors and destructor
    *   @{
    */
@@ -72,84 +114,329 @@ public:
    */
    large_t getSize() const   { return size_; }
    
-   /** A function (const) to obtain the position of an object existing in the world. Notes on exception safety: strong safety 
-   *   guaranteed. The function throws an OORError exception if the provided index is invalid.
+   /** A function (const) to obtain the position of an object existing in the world. The position is gathered from the component
+   *   arrays. Notes on exception safety: strong safety guaranteed. The function throws an OORError exception if the provided index is 
+   *   invalid.
    *
    *   \param handle   The handle which identifies the physical object.
    *   \return         The position vector of the physical object identified by the handle provided as argument.
    */
-   const Vector3<FP_TYPE_T> & getPosition( Object_ID_t handle ) const {
-      
-      SN_ASSERT_INDEX_WITHIN_SIZE( handle, size_ );
-      
-      #ifdef NDEBUG
-      if( handle >= size_ ) {
-         SN_THROW_OOR_ERROR();
-      }
-      #endif
+   Vector3<FP_TYPE_T> getPosition( Object_ID_t handle ) const {
       
-      return position_[ handle ];
+      return position_.get( slotOf( handle ) );
    }
    
-   /** A function (const) to obtain the velocity of an object existing in the world. Notes on exception safety: strong safety 
-   *   guaranteed. The function throws an OORError exception if the provided index is invalid.
+   /** A function (const) to obtain the velocity of an object existing in the world. The velocity is gathered from the component
+   *   arrays. Notes on exception safety: strong safety guaranteed. The function throws an OORError exception if the provided index is 
+   *   invalid.
    *
    *   \param handle   The handle which identifies the physical object.
    *   \return         The velocity vector of the physical object identified by the handle provided as argument.
    */
-   const Vector3<FP_TYPE_T> & getVelocity( Object_ID_t handle ) const {
-      
-      SN_ASSERT_INDEX_WITHIN_SIZE( handle, size_ );
-      
-      #ifdef NDEBUG
-      if( handle >= size_ ) {
-         SN_THROW_OOR_ERROR();
-      }
-      #endif
+   Vector3<FP_TYPE_T> getVelocity( Object_ID_t handle ) const {
       
-      return velocity_[ handle ];
+      return velocity_.get( slotOf( handle ) );
    }
 
-   /** A function (const) to obtain the acceleration of an object existing in the world. Notes on exception safety: strong safety 
-   *   guaranteed. The function throws an OORError exception if the provided index is invalid.
+   /** A function (const) to obtain the acceleration of an object existing in the world. The acceleration is gathered from the component
+   *   arrays. Notes on exception safety: strong safety guaranteed. The function throws an OORError exception if the provided index is 
+   *   invalid.
    *
    *   \param handle   The handle which identifies the physical object.
    *   \return         The acceleration vector of the physical object identified by the handle provided as argument.
    */
-   const Vector3<FP_TYPE_T> & getAcceleration( Object_ID_t handle ) const {
+   Vector3<FP_TYPE_T> getAcceleration( Object_ID_t handle ) const {
       
-      SN_ASSERT_INDEX_WITHIN_SIZE( handle, size_ );
+      return acceleration_.get( slotOf( handle ) );
+   }
+   
+   /** A function which can be used to set the position of an object. The position is scattered into the component arrays. Notes on 
+   *   exception safety: strong safety guaranteed. The function throws an OORError exception if the provided index is invalid.
+   *
+   *   \param _pos     The new position.
+   *   \param handle   The handle to the object.
+   */
+   inline void setPosition( const Vector3<FP_TYPE_T> & _pos, Object_ID_t handle ) {
       
-      #ifdef NDEBUG
-      if( handle >= size_ ) {
-         SN_THROW_OOR_ERROR();
-      }
-      #endif
+      position_.set( slotOf( handle ), _pos );
+      displacement_bound_ = std::numeric_limits< FP_TYPE_T >::max();   // An arbitrary jump cannot be bounded.
+   }
+   
+   /** A function which can be used to set the velocity of an object. The velocity is scattered into the component arrays. Notes on 
+   *   exception safety: strong safety guaranteed. The function throws an OORError exception if the provided index is invalid.
+   *
+   *   \param _vel     The new velocity.
+   *   \param handle   The handle to the object.
+   */
+   inline void setVelocity( const Vector3<FP_TYPE_T> & _vel, Object_ID_t handle ) {
       
-      return acceleration_[ handle ];
+      velocity_.set( slotOf( handle ), _vel );
    }
    
    /** A function which can be used to set the acceleration calculated by the response system. Notes on exception safety: strong safety 
    *   guaranteed. The function throws an OORError exception if the provided index is invalid.
    *
+   *   \param _acc     The new acceleration vector.
+   *   \param handle   The handle to the object.
+   */
+   inline void setAcceleration( const Vector3<FP_TYPE_T> & _acc, Object_ID_t handle ) {
+      
+      acceleration_.set( slotOf( handle ), _acc );
+   }
+   
+   /** A function which can be used to set every component of the acceleration of an object to the same value. Notes on exception 
+   *   safety: strong safety guaranteed. The function throws an OORError exception if the provided index is invalid.
+   *
    *   \param _acc     The new acceleration value.
    *   \param handle   The handle to the object.
    */
    inline void setAcceleration( FP_TYPE_T _acc, Object_ID_t handle ) {
+      setAcceleration( Vector3<FP_TYPE_T>( _acc ), handle );
+   }
+   
+   /** @} */
+   
+   /** \name Displacement tracking
+   *   @{
+   */
+   /** A function to obtain an upper bound of the distance by which any object has moved since the last reset. The integrators add the 
+   *   largest displacement of each step, which they reduce within their kernels at virtually no cost, so the bound is the sum of these 
+   *   maxima. Setting a position explicitly makes the bound infinite. Neighbour lists use it to decide when to rebuild.
+   *
+   *   \return   The displacement bound.
+   */
+   inline FP_TYPE_T getDisplacementBound() const   { return displacement_bound_; }
+   
+   /** A function which resets the displacement bound to zero, e.g. after a neighbour list has been rebuilt. */
+   inline void resetDisplacementBound()            { displacement_bound_ = FP_TYPE_T( 0 ); }
+   
+   /** @} */
+   
+   /** \name Time step
+   *   @{
+   */
+   /** A function to obtain the time step by which integrate advances the objects.
+   *
+   *   \return   The time step.
+   */
+   inline FP_TYPE_T getTimeStep() const   { return timeStep_; }
+   
+   /** A function to obtain the current time, which every completed step advances by the time step.
+   *
+   *   \return   The current time.
+   */
+   inline FP_TYPE_T getCurrentTime() const   { return currentTime_; }
+   
+   /** A function to set the time step by which integrate advances the objects. Notes on exception safety: strong safety guaranteed. The 
+   *   function throws an InvalidArgument exception if the time step is not positive.
+   *
+   *   \param dt   The time step.
+   */
+   void setTimeStep( FP_TYPE_T dt ) {
       
-      SN_ASSERT_INDEX_WITHIN_SIZE( handle, size_ );
+      SN_ASSERT( dt > FP_TYPE_T( 0 ) );
       
       #ifdef NDEBUG
-      if( handle >= size_ ) {
-         SN_THROW_OOR_ERROR();
-      }
+      if( ! ( dt > FP_TYPE_T( 0 ) ) )
+         SN_THROW_INVALID_ARGUMENT( "IA_Time_Step_Error" );
       #endif
       
-      acceleration_[ handle ] = _acc;
+      timeStep_ = dt;
+   }
+   
+   /** @} */
+   
+   /** \name Handles and storage order
+   *   @{
+   */
+   /** A function to obtain the index of a handle. Indices are dense and are reused after deletion, so that per-object data which the user
+   *   keeps outside of the kinematics can be indexed by them (see getIndexCount).
+   *
+   *   \param handle   The handle.
+   *   \return         The index of the handle.
+   */
+   static inline large_t getHandleIndex( Object_ID_t handle )        { return large_t( handle & HANDLE_INDEX_MASK ); }
+   
+   /** A function to obtain the generation of a handle.
+   *
+   *   \param handle   The handle.
+   *   \return         The generation of the handle.
+   */
+   static inline large_t getHandleGeneration( Object_ID_t handle )   { return large_t( handle >> HANDLE_INDEX_BITS ); }
+   
+   /** A function to obtain the number of indices which have been handed out so far, i.e., the size which arrays indexed by handle index 
+   *   require.
+   *
+   *   \return   The number of indices.
+   */
+   inline large_t getIndexCount() const   { return slots_.getSize(); }
+   
+   /** A function to ascertain whether a handle refers to an existing object. Handles of deleted objects are invalid, even if their index 
+   *   has been reused.
+   *
+   *   \param handle   The handle.
+   *   \return         true if the object exists, false if not.
+   */
+   inline flag_t isValidHandle( Object_ID_t handle ) const {
+      
+      const large_t index = getHandleIndex( handle );
+      return index < slots_.getSize() && slots_[index] != NO_SLOT && generations_[index] == getHandleGeneration( handle );
+   }
+   
+   /** A function to obtain the slot of an object, i.e., its index in the component arrays (see getPositionSpan). Slots change whenever 
+   *   the objects are reordered, whereas handles remain valid. Notes on exception safety: strong safety guaranteed. The function throws an 
+   *   OORError exception if the provided handle is invalid.
+   *
+   *   \param handle   The handle which identifies the physical object.
+   *   \return         The slot of the object.
+   */
+   inline large_t getSlot( Object_ID_t handle ) const   { return slotOf( handle ); }
+   
+   /** A function to obtain the handle of the object which occupies a slot.
+   *
+   *   \param slot   The slot.
+   *   \return       The handle of the object in the slot.
+   */
+   inline Object_ID_t getHandle( large_t slot ) const {
+      
+      SN_ASSERT_INDEX_WITHIN_SIZE( slot, size_ );
+      
+      const large_t index = indices_[slot];
+      return Object_ID_t( index ) | ( Object_ID_t( generations_[index] ) << HANDLE_INDEX_BITS );
+   }
+   
+   /** A function which exposes the handle indices of the objects in slot order, so that kernels over the component arrays can look up 
+   *   per-object data which the user keeps indexed by handle index, e.g. masses[ getObjectIndices()[slot] ].
+   *
+   *   \return   A pointer to getSize() handle indices, one per slot.
+   */
+   inline const large_t * getObjectIndices() const   { return indices_.raw_ptr(); }
+   
+   /** A function to obtain the version of the storage order. It is incremented by every reorder and deletion, so that structures which 
+   *   hold slots, such as neighbour lists and trees, can detect that they are stale.
+   *
+   *   \return   The layout version.
+   */
+   inline large_t getLayoutVersion() const   { return layout_version_; }
+   
+   /** A function to obtain the number of time steps between two automatic reorders.
+   *
+   *   \return   The reorder interval, zero if automatic reordering is disabled.
+   */
+   inline large_t getReorderInterval() const   { return reorder_interval_; }
+   
+   /** A function which makes the kinematics reorder its objects automatically after every given number of calls of integrate.
+   *
+   *   \param steps   The reorder interval. Zero disables automatic reordering.
+   *   \param curve   The space-filling curve along which the objects are ordered.
+   */
+   inline void setReorderInterval( large_t steps, sfc::Curve curve = sfc::Curve::Hilbert ) {
+      
+      reorder_interval_ = steps;
+      reorder_curve_ = curve;
+      steps_since_reorder_ = 0;
+   }
+   
+   /** A function which permutes all per-object fields so that the objects are stored in the order of their keys along a space-filling 
+   *   curve. Objects which are close in space then also lie close in memory, which improves the locality of neighbour searches and force
+   *   kernels. The keys are sorted by a parallel radix sort (see sfc::sortByKey). Handles remain valid, the layout version is incremented and
+   *   the displacement bound becomes infinite, since structures built on the old slots have to be rebuilt anyway. Notes on exception 
+   *   safety: the function throws an AllocError exception if the required resource allocation were not possible. The objects are left 
+   *   untouched if the keys could not be sorted, but the fields may be inconsistent if the permutation of one of them fails.
+   *
+   *   \param curve   The space-filling curve along which the objects are ordered.
+   */
+   void reorder( sfc::Curve curve = sfc::Curve::Hilbert ) {
+      
+      clearGhosts();
+      steps_since_reorder_ = 0;
+      if( size_ < 2 )
+         return;
+      
+      const large_t size = size_;
+      
+      ProcTimer timer;
+      
+      RAIIWrapper< ID_t >    keys = createRAIIWrapper< ID_t >( size );
+      RAIIWrapper< large_t > perm = createRAIIWrapper< large_t >( size );
+      large_t * order = perm.raw_ptr();
+      
+      const SoASpan3<const FP_TYPE_T> pos = getPositionSpan();
+      sfc::computeKeys( pos, sfc::computeBounds( pos ), curve, keys.raw_ptr() );
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC )
+      for( large_t k = 0; k < size; ++k )
+         order[k] = k;
+      SN_OPENMP_SYNC()
+      
+      sfc::sortByKey( keys.raw_ptr(), order, size );
+      
+      permuteObjects( order );
+      indices_.permute( order );
+      
+      // The inverse of the handle order.
+      large_t * slots = slots_.raw_ptr();
+      const large_t * indices = indices_.raw_ptr();
+      
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t k = 0; k < size; ++k )
+         slots[ indices[k] ] = k;
+      SN_OPENMP_SYNC()
+      
+      ++layout_version_;
+      displacement_bound_ = std::numeric_limits< FP_TYPE_T >::max();
+      
+      SN_LOG_REPORT_L2_EVENT( "Kinematics", "WorldKinematicsBB::reorder permuted " << size << " objects along the " 
+                                            << ( curve == sfc::Curve::Hilbert ? "Hilbert" : "Morton" ) << " curve in " 
+                                            << timer.getAge() << " s" );
    }
    
    /** @} */
    
+   /** \name Component access
+   *   @{
+   */
+   /** A function which exposes the position component arrays of the owned objects for unit-stride kernels. Like all component arrays, 
+   *   they are indexed by slot (see getSlot).
+   *
+   *   \return   A read-only view of the x, y and z position arrays, excluding the ghosts.
+   */
+   inline SoASpan3<const FP_TYPE_T> getPositionSpan() const {
+      
+      SoASpan3<const FP_TYPE_T> pos = position_.span();
+      pos.size = size_;
+      return pos;
+   }
+   
+   /** A function which exposes the position component arrays including the ghosts, which occupy the slots [getSize(), getSize() + 
+   *   getGhostCount()).
+   *
+   *   \return   A read-only view of the x, y and z position arrays of the owned objects and the ghosts.
+   */
+   inline SoASpan3<const FP_TYPE_T> getHaloPositionSpan() const     { return position_.span(); }
+   
+   /** A function which exposes the velocity component arrays for unit-stride kernels.
+   *
+   *   \return   A read-only view of the x, y and z velocity arrays.
+   */
+   inline SoASpan3<const FP_TYPE_T> getVelocitySpan() const         { return velocity_.span(); }
+   
+   /** A function (const) which exposes the acceleration component arrays for unit-stride kernels.
+   *
+   *   \return   A read-only view of the x, y and z acceleration arrays.
+   */
+   inline SoASpan3<const FP_TYPE_T> getAccelerationSpan() const     { return acceleration_.span(); }
+   
+   /** A function (non-const) which exposes the acceleration component arrays so that response systems can write into them directly.
+   *
+   *   \return   A view of the x, y and z acceleration arrays.
+   */
+   inline SoASpan3<FP_TYPE_T> getAccelerationSpan()                 { return acceleration_.span(); }
+   
+   /** @} */
+   
    /** \name Primary functionality
    *   @{
    */
@@ -159,14 +446,584 @@ public:
    *   \return   A handle to the newly created object
    */
    virtual Object_ID_t createObject() = 0;
+   
+   /** A function which creates n objects in one step and initializes their positions and velocities. The fields grow at most once, and 
+   *   the initializer is invoked for every new object in a parallel, vectorizable loop, i.e., concurrently and in no particular order. It 
+   *   must therefore only write to the vectors which it is handed. The accelerations of the new objects are zero. The objects always receive
+   *   fresh indices, so that their handles are contiguous. Notes on exception safety: basic safety guaranteed. The function throws an 
+   *   AllocError exception if the required resource allocation were not possible.
+   *
+   *   \tparam INITIALIZER   A callable with the signature void( Object_ID_t handle, Vector3<FP_TYPE_T> & pos, Vector3<FP_TYPE_T> & vel ).
+   *   \param n              The number of objects to be created.
+   *   \param init           The initializer, which is handed zero vectors.
+   *   \return               The range of handles to the newly created objects.
+   */
+   template< class INITIALIZER >
+   HandleRange createObjects( large_t n, INITIALIZER && init ) {
+      
+      // Fresh indices are of the first generation, so the next one is also the next handle.
+      if( n == 0 )
+         return HandleRange{ Object_ID_t( slots_.getSize() ), Object_ID_t( slots_.getSize() ) };
+      
+      // The new objects occupy the slots after the existing ones, whereas their indices follow all indices handed out so far, which 
+      // differ as soon as an object has been deleted.
+      const large_t first_slot = size_;
+      const Object_ID_t first_index = appendObjects( n );
+      
+      SoASpan3<FP_TYPE_T> pos = position_.span();
+      SoASpan3<FP_TYPE_T> vel = velocity_.span();
+      const large_t chunk = getKernelChunk();
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) )
+      for( large_t k = 0; k < n; ++k ) {
+         
+         Vector3<FP_TYPE_T> p( FP_TYPE_T( 0 ) );
+         Vector3<FP_TYPE_T> v( FP_TYPE_T( 0 ) );
+         init( Object_ID_t( first_index + k ), p, v );
+         
+         const large_t i = first_slot + k;
+         pos.x[i] = p[0];   pos.y[i] = p[1];   pos.z[i] = p[2];
+         vel.x[i] = v[0];   vel.y[i] = v[1];   vel.z[i] = v[2];
+      }
+      SN_OPENMP_SYNC()
+      
+      return HandleRange{ first_index, Object_ID_t( first_index + n ) };
+   }
+   
+   /** A function which creates n zero-valued objects in one step, e.g., the objects which arrive from another process. Unlike the 
+   *   initializing createObjects, it reuses the indices of deleted objects first, so that the handles are not contiguous in general. The 
+   *   fields grow at most twice, and the new objects occupy the last n slots in the order of their handles. Notes on exception safety: 
+   *   basic safety guaranteed. The function throws an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param n         The number of objects to be created.
+   *   \param handles   The handles of the new objects (output of n entries).
+   */
+   void createObjects( large_t n, Object_ID_t * handles ) {
+      
+      clearGhosts();
+      
+      const large_t reused = std::min( n, free_.getSize() );
+      if( reused > 0 ) {
+         
+         try {
+            growObjects( reused );
+            for( large_t k = 1; k <= reused; ++k )
+               indices_.pushBack( free_[ free_.getSize() - k ] );
+         }
+         catch( const AllocError & ) {
+            SN_THROW_ALLOC_ERROR();
+         }
+         
+         for( large_t k = 0; k < reused; ++k ) {
+            
+            const large_t index = free_.popBack();
+            slots_[index] = size_++;
+            handles[k] = Object_ID_t( index ) | ( Object_ID_t( generations_[index] ) << HANDLE_INDEX_BITS );
+         }
+      }
+      
+      if( n > reused ) {
+         
+         const Object_ID_t first = appendObjects( n - reused );
+         for( large_t k = reused; k < n; ++k )
+            handles[k] = Object_ID_t( first + ( k - reused ) );
+      }
+   }
 
-   /** A pure virtual function which requires all base classes to implement a method of kinematic integration. */   
+   /** A function which deletes an object in constant time. The last object is moved into the slot of the deleted one, and the index of the
+   *   deleted object is reused by a later createObject under a new generation, so that the handle of the deleted object becomes invalid. All 
+   *   other handles remain valid, and the objects stay densely packed in the slots [0, getSize()). Notes on exception safety: strong safety 
+   *   guaranteed. The function throws an OORError exception if the provided handle is invalid and an AllocError exception if the required 
+   *   resource allocation were not possible.
+   *
+   *   \param handle   The handle to the object.
+   */
+   void deleteObject( Object_ID_t handle ) {
+      
+      const large_t slot = slotOf( handle );
+      
+      clearGhosts();
+      reserveFreeIndices( 1 );
+      removeSlot( slot );
+   }
+   
+   /** A function which deletes the objects in the given slots in one step, e.g. the objects which leave the process at a migration. The 
+   *   objects are deleted as by deleteObject in descending slot order, so that no object which is still to be deleted is moved, and the 
+   *   bookkeeping of the reusable indices grows at most once. Notes on exception safety: strong safety guaranteed. The function throws an 
+   *   AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param slots   The slots of the objects in strictly ascending order.
+   *   \param n       The number of objects to be deleted.
+   */
+   void deleteObjects( const large_t * slots, large_t n ) {
+      
+      if( n == 0 )
+         return;
+      
+      SN_ASSERT( slots != nullptr );
+      SN_ASSERT_INDEX_WITHIN_SIZE( slots[ n - 1 ], size_ );
+      
+      #ifdef NDEBUG
+      if( slots == nullptr || slots[ n - 1 ] >= size_ ) {
+         SN_THROW_OOR_ERROR();
+      }
+      #endif
+      
+      clearGhosts();
+      reserveFreeIndices( n );
+      
+      for( large_t k = n; k-- > 0; ) {
+         
+         SN_ASSERT( k == 0 || slots[ k - 1 ] < slots[k] );
+         removeSlot( slots[k] );
+      }
+   }
+   
+   /** A function which ensures that the kinematics can hold at least the given number of objects without further reallocation, so that 
+   *   creating objects up to this number allocates nothing. Notes on exception safety: basic safety guaranteed. The function throws an 
+   *   AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param n   The number of objects which the kinematics is to accommodate.
+   */
+   void reserve( large_t n ) {
+      
+      if( n <= size_ )
+         return;
+      
+      // Fresh indices are only handed out once the reusable ones are exhausted.
+      const large_t further = n - size_;
+      const large_t fresh = ( further > free_.getSize() ) ? further - free_.getSize() : large_cast( 0 );
+      
+      try {
+         reserveObjects( n );
+         indices_.reserve( n );
+         slots_.reserve( slots_.getSize() + fresh );
+         generations_.reserve( generations_.getSize() + fresh );
+      }
+      catch( const AllocError & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+   }
+   
+   /** A function which calls a kernel for every existing object, distributed among the threads. The objects are visited in slot order, 
+   *   i.e., along the component arrays.
+   *
+   *   \tparam KERNEL   A callable with the signature void( large_t slot, Object_ID_t handle ).
+   *   \param kernel    The kernel.
+   */
+   template< class KERNEL >
+   void forEachObject( KERNEL && kernel ) const {
+      
+      const large_t size = size_;
+      const large_t chunk = getKernelChunk();
+      
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC_CS( chunk ) )
+      for( large_t k = 0; k < size; ++k )
+         kernel( k, getHandle( k ) );
+      SN_OPENMP_SYNC()
+   }
+   
+   /** A pure virtual function which requires all base classes to implement a method of kinematic integration. Implementations call 
+   *   completeStep at the end, also if there are no objects, so that the current time advances alike for all integrators. */   
    virtual void integrate() = 0;
    
    /** @} */
 
+   /** \name Ghosts
+   *   @{
+   */
+   /** A function to obtain the number of ghosts, i.e., copies of the positions of objects owned by neighbouring processes.
+   *
+   *   \return   The number of ghost slots after the owned objects.
+   */
+   inline large_t getGhostCount() const   { return ghost_count_; }
+   
+   /** A function which replaces the ghosts by n new ghost slots after the owned objects. Only the positions of the ghosts are stored. They 
+   *   are neither integrated nor transferred, and they are discarded by integrate, by the creation or deletion of an object and by reorder.
+   *   Notes on exception safety: basic safety guaranteed. The function throws an AllocError exception if the required resource allocation
+   *   were not possible.
+   *
+   *   \param n   The number of ghosts.
+   *   \return    A view of the positions of the ghosts, which the caller is to fill in.
+   */
+   SoASpan3<FP_TYPE_T> allocateGhosts( large_t n ) {
+      
+      clearGhosts();
+      
+      try {
+         position_.pushBackN( n );
+      }
+      catch( const AllocError & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+      
+      ghost_count_ = n;
+      
+      SoASpan3<FP_TYPE_T> pos = position_.span();
+      return SoASpan3<FP_TYPE_T>{ pos.x + size_, pos.y + size_, pos.z + size_, n };
+   }
+   
+   /** A function which discards all ghosts. */
+   void clearGhosts() {
+      
+      for( ; ghost_count_ > 0; --ghost_count_ )
+         position_.popBack();
+   }
+   
+   /** @} */
+   
+   /** \name Object transfer
+   *   @{
+   */
+   /** A function to obtain the length of the record in which the state of an object is transferred to another process. Black boxes which
+   *   maintain further per-object fields whose content outlives a time step override it together with packObject and unpackObject.
+   *
+   *   \return   The number of floating point values per record.
+   */
+   virtual small_t getRecordSize() const   { return 9; }
+   
+   /** A function which writes the state of an object into a record, i.e., its position, velocity and acceleration.
+   *
+   *   \param slot     The slot of the object.
+   *   \param record   The record of getRecordSize() values (output).
+   */
+   virtual void packObject( large_t slot, FP_TYPE_T * record ) const {
+      
+      SN_ASSERT_INDEX_WITHIN_SIZE( slot, size_ );
+      
+      for( small_t d = 0; d < 3; ++d ) {
+         
+         record[d] = position_.component( d )[slot];
+         record[ 3 + d ] = velocity_.component( d )[slot];
+         record[ 6 + d ] = acceleration_.component( d )[slot];
+      }
+   }
+   
+   /** A function which overwrites the state of an object with a record written by packObject.
+   *
+   *   \param slot     The slot of the object.
+   *   \param record   The record of getRecordSize() values.
+   */
+   virtual void unpackObject( large_t slot, const FP_TYPE_T * record ) {
+      
+      SN_ASSERT_INDEX_WITHIN_SIZE( slot, size_ );
+      
+      for( small_t d = 0; d < 3; ++d ) {
+         
+         position_.component( d )[slot] = record[d];
+         velocity_.component( d )[slot] = record[ 3 + d ];
+         acceleration_.component( d )[slot] = record[ 6 + d ];
+      }
+   }
+   
+   /** @} */
+
 protected:
    
+   /** A function which looks up the slot of an object. Notes on exception safety: strong safety guaranteed. The function throws an 
+   *   OORError exception if the provided handle is invalid.
+   *
+   *   \param handle   The handle which identifies the physical object.
+   *   \return         The slot of the object.
+   */
+   large_t slotOf( Object_ID_t handle ) const;
+   
+   /** A function which appends a zero-valued object to every per-object field. It reuses the index of a deleted object, if there is one. 
+   *   Notes on exception safety: basic safety guaranteed. The function throws an AllocError exception if the required resource allocation 
+   *   were not possible.
+   *
+   *   \return   The handle of the new object.
+   */
+   Object_ID_t appendObject() {
+      
+      clearGhosts();
+      
+      if( free_.getSize() == 0 )
+         return appendObjects( 1 );
+      
+      try {
+         growObjects( 1 );
+         indices_.pushBack( free_[ free_.getSize() - 1 ] );
+      }
+      catch( const AllocError & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+      
+      const large_t index = free_.popBack();
+      slots_[index] = size_++;
+      
+      return Object_ID_t( index ) | ( Object_ID_t( generations_[index] ) << HANDLE_INDEX_BITS );
+   }
+   
+   /** A function which appends n zero-valued objects to every per-object field and registers them under fresh, contiguous indices of the 
+   *   first generation, so that their handles equal their indices. Notes on exception safety: basic safety guaranteed. The function throws
+   *   an AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param n   The number of objects to be appended.
+   *   \return    The handle of the first new object.
+   */
+   Object_ID_t appendObjects( large_t n ) {
+      
+      const large_t first_slot = size_;
+      const large_t first_index = slots_.getSize();
+      
+      SN_ASSERT( first_index + n <= HANDLE_INDEX_MASK );
+      
+      clearGhosts();
+      
+      try {
+         growObjects( n );
+         slots_.pushBackN( n );
+         generations_.pushBackN( n, large_t( 0 ) );
+         indices_.pushBackN( n );
+      }
+      catch( const AllocError & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+      
+      large_t * slots = slots_.raw_ptr();
+      large_t * indices = indices_.raw_ptr();
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC )
+      for( large_t k = 0; k < n; ++k ) {
+         
+         slots[ first_index + k ] = first_slot + k;
+         indices[ first_slot + k ] = first_index + k;
+      }
+      SN_OPENMP_SYNC()
+      
+      size_ += n;
+      return Object_ID_t( first_index );
+   }
+   
+   /** A function which concludes a time step. It advances the current time by the time step, counts the calls of integrate and reorders 
+   *   the objects whenever the reorder interval has elapsed.
+   */
+   void completeStep() {
+      
+      currentTime_ += timeStep_;
+      ++steps_;
+      if( reorder_interval_ == 0 )
+         return;
+      
+      if( ++steps_since_reorder_ >= reorder_interval_ )
+         reorder( reorder_curve_ );
+   }
+   
+   /** A function which computes the chunk of objects in which the kernels over the state fields are statically scheduled. A chunk covers 
+   *   a cache-sized block of the position, velocity and acceleration arrays, and its length is a multiple of the SIMD width, so that every 
+   *   chunk begins on an aligned boundary. Since the resulting schedule only depends on the number of threads, each thread revisits the 
+   *   same pages in every time step.
+   *
+   *   \return   The chunk size in number of objects.
+   */
+   static large_t getKernelChunk() {
+      
+      const large_t lanes = std::max( large_cast( globalConstants::SIMD_ALIGNMENT / sizeof( FP_TYPE_T ) ), large_cast( 1 ) );
+      const large_t chunk = globalConstants::CACHE_BLOCK_SIZE / ( 9 * sizeof( FP_TYPE_T ) );
+      
+      return std::max( chunk / lanes * lanes, lanes );
+   }
+   
+   /** A function which reports the memory bandwidth achieved by a kernel over the state fields as a level 2 event. Only the kernels of 
+   *   every BANDWIDTH_REPORT_INTERVAL-th step are reported, so that the log does not grow by an entry per kernel and step.
+   *
+   *   \param kernel    The name of the kernel.
+   *   \param bytes     The number of bytes which the kernel loaded and stored.
+   *   \param seconds   The duration of the kernel.
+   */
+   void reportBandwidth( const char * kernel, large_t bytes, real_t seconds ) const {
+      
+      (void)kernel; (void)bytes;   // Unused if L2 events are not logged.
+      
+      if( steps_ % globalConstants::BANDWIDTH_REPORT_INTERVAL == 0 && seconds > real_cast( 0 ) ) {
+         SN_LOG_REPORT_L2_EVENT( "Kinematics", kernel << " streamed " << bytes << " bytes at " 
+                                               << real_cast( bytes ) / seconds * real_cast( 1e-9 ) << " GB/s" );
+      }
+   }
+   
+   /** A fused kernel which kicks the velocities by the accelerations and then drifts the positions by the updated velocities, i.e., 
+   *   v += a * kick, x += v * drift, in a single pass over the state. It is scheduled in the same way as all other kernels over the state 
+   *   fields (see getKernelChunk), tracks the largest displacement (see getDisplacementBound) and reports its bandwidth.
+   *
+   *   \param kick     The time interval of the kick.
+   *   \param drift    The time interval of the drift.
+   *   \param kernel   The name under which the bandwidth is reported.
+   */
+   void kickDrift( FP_TYPE_T kick, FP_TYPE_T drift, const char * kernel ) {
+      
+      if( size_ == 0 )
+         return;
+      
+      const large_t size = size_;
+      const large_t chunk = getKernelChunk();
+      
+      FP_TYPE_T * px = position_.component( 0 );
+      FP_TYPE_T * py = position_.component( 1 );
+      FP_TYPE_T * pz = position_.component( 2 );
+      FP_TYPE_T * vx = velocity_.component( 0 );
+      FP_TYPE_T * vy = velocity_.component( 1 );
+      FP_TYPE_T * vz = velocity_.component( 2 );
+      const FP_TYPE_T * ax = acceleration_.component( 0 );
+      const FP_TYPE_T * ay = acceleration_.component( 1 );
+      const FP_TYPE_T * az = acceleration_.component( 2 );
+      
+      FP_TYPE_T step2 = FP_TYPE_T( 0 );
+      
+      ProcTimer timer;
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) OMP_REDUCTION( max : step2 )
+                               OMP_ALIGNED( px, py, pz, vx, vy, vz, ax, ay, az : globalConstants::SIMD_ALIGNMENT ) )
+      for( large_t i = 0; i < size; ++i ) {
+         
+         const FP_TYPE_T wx = vx[i] + ax[i] * kick;
+         const FP_TYPE_T wy = vy[i] + ay[i] * kick;
+         const FP_TYPE_T wz = vz[i] + az[i] * kick;
+         
+         vx[i] = wx;
+         vy[i] = wy;
+         vz[i] = wz;
+         
+         const FP_TYPE_T dx = wx * drift;
+         const FP_TYPE_T dy = wy * drift;
+         const FP_TYPE_T dz = wz * drift;
+         step2 = std::max( step2, dx * dx + dy * dy + dz * dz );
+         
+         px[i] += dx;
+         py[i] += dy;
+         pz[i] += dz;
+      }
+      SN_OPENMP_SYNC()
+      
+      trackDisplacement( step2 );
+      
+      // Loads of position, velocity and acceleration, stores of position and velocity.
+      reportBandwidth( kernel, 15 * size * sizeof( FP_TYPE_T ), timer.getAge() );
+   }
+   
+   /** A kernel which kicks the velocities by the accelerations, i.e., v += a * kick, scheduled in the same way as kickDrift.
+   *
+   *   \param kick     The time interval of the kick.
+   *   \param kernel   The name under which the bandwidth is reported.
+   */
+   void kick( FP_TYPE_T kick, const char * kernel ) {
+      
+      if( size_ == 0 )
+         return;
+      
+      const large_t size = size_;
+      const large_t chunk = getKernelChunk();
+      
+      FP_TYPE_T * vx = velocity_.component( 0 );
+      FP_TYPE_T * vy = velocity_.component( 1 );
+      FP_TYPE_T * vz = velocity_.component( 2 );
+      const FP_TYPE_T * ax = acceleration_.component( 0 );
+      const FP_TYPE_T * ay = acceleration_.component( 1 );
+      const FP_TYPE_T * az = acceleration_.component( 2 );
+      
+      ProcTimer timer;
+      
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC_CS( chunk ) OMP_ALIGNED( vx, vy, vz, ax, ay, az : globalConstants::SIMD_ALIGNMENT ) )
+      for( large_t i = 0; i < size; ++i ) {
+         
+         vx[i] += ax[i] * kick;
+         vy[i] += ay[i] * kick;
+         vz[i] += az[i] * kick;
+      }
+      SN_OPENMP_SYNC()
+      
+      // Loads of velocity and acceleration, stores of velocity.
+      reportBandwidth( kernel, 9 * size * sizeof( FP_TYPE_T ), timer.getAge() );
+   }
+   
+   /** A function which adds the largest displacement of a step to the displacement bound.
+   *
+   *   \param step2   The square of the largest displacement of any object in the step.
+   */
+   inline void trackDisplacement( FP_TYPE_T step2 ) {
+      
+      if( displacement_bound_ < std::numeric_limits< FP_TYPE_T >::max() )
+         displacement_bound_ += std::sqrt( step2 );
+   }
+   
+   /** A function which appends n zero-valued objects to every per-object field. The new objects are written with the schedule of the 
+   *   kernels (see getKernelChunk), so that their pages are first touched by the threads which process them in every step. Black boxes 
+   *   which maintain further per-object fields override it, call the base implementation and grow their own fields in the same way. The 
+   *   size is not updated here. Notes on exception safety: basic safety guaranteed. The function throws an AllocError exception if the 
+   *   required resource allocation were not possible.
+   *
+   *   \param n   The number of objects to be appended.
+   */
+   virtual void growObjects( large_t n ) {
+      
+      const large_t chunk = getKernelChunk();
+      const Vector3<FP_TYPE_T> zero( FP_TYPE_T( 0 ) );
+      
+      position_.pushBackN( n, zero, chunk );
+      velocity_.pushBackN( n, zero, chunk );
+      acceleration_.pushBackN( n, zero, chunk );
+   }
+   
+   /** A function which reserves every per-object field for n objects. Black boxes which maintain further per-object fields override it, 
+   *   call the base implementation and reserve their own fields. Notes on exception safety: basic safety guaranteed. The function throws an 
+   *   AllocError exception if the required resource allocation were not possible.
+   *
+   *   \param n   The number of objects which the fields are to accommodate.
+   */
+   virtual void reserveObjects( large_t n ) {
+      
+      position_.reserve( n );
+      velocity_.reserve( n );
+      acceleration_.reserve( n );
+   }
+   
+   /** A function which permutes every per-object field, such that the object in slot k is the one which was previously in slot perm[k]. 
+   *   Black boxes which maintain further per-object fields whose content outlives a time step override it, call the base implementation 
+   *   and permute their own fields. Notes on exception safety: the function throws an AllocError exception if the required resource 
+   *   allocation were not possible.
+   *
+   *   \param perm   The permutation of the slots.
+   */
+   virtual void permuteObjects( const large_t * perm ) {
+      
+      position_.permute( perm );
+      velocity_.permute( perm );
+      acceleration_.permute( perm );
+   }
+   
+   /** A function which copies an object from one slot into another in every per-object field, as required by the deletion of an object. 
+   *   Black boxes which maintain further per-object fields whose content outlives a time step override it and call the base implementation.
+   *
+   *   \param from   The slot of the object to be copied.
+   *   \param to     The slot to be overwritten.
+   */
+   virtual void moveObject( large_t from, large_t to ) {
+      
+      position_.set( to, position_.get( from ) );
+      velocity_.set( to, velocity_.get( from ) );
+      acceleration_.set( to, acceleration_.get( from ) );
+   }
+   
+   /** A function which removes the last n objects from every per-object field. Black boxes which maintain further per-object fields 
+   *   override it, call the base implementation and shrink their own fields. The size is not updated here.
+   *
+   *   \param n   The number of objects to be removed.
+   */
+   virtual void shrinkObjects( large_t n ) {
+      
+      for( large_t k = 0; k < n; ++k ) {
+         
+         position_.popBack();
+         velocity_.popBack();
+         acceleration_.popBack();
+      }
+   }
+   
    /** A variable which records the starting time */
    FP_TYPE_T startTime_ = {};
    
@@ -176,19 +1033,111 @@ protected:
    /** A variable which records the current time-step */
    FP_TYPE_T timeStep_ = {};
    
-   /** A field of position vectors of physical objects existing in the world. */
-   Field< Vector3< FP_TYPE_T > > position_ = {};
+   /** A field of position vectors of physical objects existing in the world, stored component-wise. Large state fields are backed by huge
+   *   pages, and every component array is aligned to at least the SIMD width.
+   */
+   SoAField3< FP_TYPE_T, 10000, HugePageAlloc > position_ = {};
    
-   /** A field of velocity vectors of physical objects existing in the world. */
-   Field< Vector3< FP_TYPE_T > > velocity_ = {};
+   /** A field of velocity vectors of physical objects existing in the world, stored component-wise. */
+   SoAField3< FP_TYPE_T, 10000, HugePageAlloc > velocity_ = {};
    
-   /** A field of acceleration variables of physical objects existing in the world. */
-   Field< Vector3< FP_TYPE_T > > acceleration_ = {};
+   /** A field of acceleration vectors of physical objects existing in the world, stored component-wise. */
+   SoAField3< FP_TYPE_T, 10000, HugePageAlloc > acceleration_ = {};
    
    /** The size of physical objects in the world. */
-   large_t size_;
+   large_t size_ = 0;
+   
+   /** The number of ghosts after the owned objects. */
+   large_t ghost_count_ = 0;
+   
+   /** An upper bound of the displacement of any object since the last reset. It is infinite until the first reset. */
+   FP_TYPE_T displacement_bound_ = std::numeric_limits< FP_TYPE_T >::max();
+   
+private:
+   
+   /* Growth of the reusable indices such that n further indices fit, which is geometric, so that single deletions rarely allocate. */
+   void reserveFreeIndices( large_t n ) {
+      
+      const large_t required = free_.getSize() + n;
+      if( required <= free_.getCapacity() )
+         return;
+      
+      try {
+         free_.reserve( std::max( required, 2 * free_.getCapacity() ) );
+      }
+      catch( const AllocError & ) {
+         SN_THROW_ALLOC_ERROR();
+      }
+   }
+   
+   /* Deletion of the object in a slot, for which the reusable indices must have been reserved. The last object fills the slot. */
+   void removeSlot( large_t slot ) {
+      
+      const large_t index = indices_[slot];
+      const large_t last = size_ - 1;
+      
+      if( slot != last ) {
+         
+         moveObject( last, slot );
+         
+         const large_t moved = indices_[last];
+         indices_[slot] = moved;
+         slots_[moved] = slot;
+      }
+      
+      shrinkObjects( 1 );
+      indices_.popBack();
+      --size_;
+      
+      slots_[index] = NO_SLOT;
+      if( ++generations_[index] < HANDLE_MAX_GENERATION )
+         free_.pushBack( large_t( index ) );
+      
+      ++layout_version_;
+   }
+   
+   /* The sentinel slot of a deleted index. */
+   static constexpr large_t NO_SLOT = std::numeric_limits< large_t >::max();
+   
+   Field< large_t > slots_;         ///< The slot of every index, NO_SLOT if deleted.
+   Field< large_t > generations_;   ///< The current generation of every index.
+   Field< large_t > indices_;       ///< The index of every object, indexed by slot.
+   Field< large_t > free_;          ///< The indices of deleted objects which may be reused.
+   
+   large_t layout_version_ = 0;                          ///< The number of reorders so far.
+   large_t steps_ = 0;                                   ///< The number of completed steps.
+   large_t reorder_interval_ = 0;                        ///< The number of steps between automatic reorders, zero if disabled.
+   large_t steps_since_reorder_ = 0;                     ///< The number of steps since the last reorder.
+   sfc::Curve reorder_curve_ = sfc::Curve::Hilbert;      ///< The curve of the automatic reorders.
 };
 
+
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/* The pure virtual destructor still requires a body. */
+template< typename FP_TYPE_T >
+WorldKinematicsBB< FP_TYPE_T >::~WorldKinematicsBB() {}
+
+template< typename FP_TYPE_T >
+large_t WorldKinematicsBB< FP_TYPE_T >::slotOf( Object_ID_t handle ) const {
+   
+   SN_ASSERT( isValidHandle( handle ) );
+   
+   #ifdef NDEBUG
+   if( ! isValidHandle( handle ) ) {
+      SN_THROW_OOR_ERROR();
+   }
+   #endif
+   
+   return slots_[ getHandleIndex( handle ) ];
+}
+
+template< typename FP_TYPE_T > constexpr small_t     WorldKinematicsBB< FP_TYPE_T >::HANDLE_INDEX_BITS;
+template< typename FP_TYPE_T > constexpr Object_ID_t WorldKinematicsBB< FP_TYPE_T >::HANDLE_INDEX_MASK;
+template< typename FP_TYPE_T > constexpr large_t     WorldKinematicsBB< FP_TYPE_T >::HANDLE_MAX_GENERATION;
+template< typename FP_TYPE_T > constexpr large_t     WorldKinematicsBB< FP_TYPE_T >::NO_SLOT;
+#endif   // DOXYSKIP
+
 }   // namespace simpleNewton
 
 #endif
@@ -0,0 +1,275 @@
+#include "SpaceFillingCurve.hpp"
+
+#include <utility>
+
+#include <containers/RAIIWrapper.hpp>
+
+#include <core/Exceptions.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the implementation of the space-filling curve utilities.
+///   \file
+///   \addtogroup geometry Geometry
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+namespace sfc {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Keys
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ID_t hilbertKey( small_t ix, small_t iy, small_t iz ) {
+
+   small_t X[3] = { ix & KEY_MAX_COORD, iy & KEY_MAX_COORD, iz & KEY_MAX_COORD };
+   const small_t M = 1u << ( KEY_BITS - 1 );
+
+   // Inverse undo of the excess work.
+   for( small_t Q = M; Q > 1; Q >>= 1 ) {
+
+      const small_t P = Q - 1;
+      for( small_t i = 0; i < 3; ++i ) {
+
+         if( X[i] & Q ) {
+            X[0] ^= P;
+         }
+         else {
+            const small_t t = ( X[0] ^ X[i] ) & P;
+            X[0] ^= t;
+            X[i] ^= t;
+         }
+      }
+   }
+
+   // Gray encoding.
+   X[1] ^= X[0];
+   X[2] ^= X[1];
+
+   small_t t = 0;
+   for( small_t Q = M; Q > 1; Q >>= 1 ) {
+      if( X[2] & Q )
+         t ^= Q - 1;
+   }
+   for( small_t i = 0; i < 3; ++i )
+      X[i] ^= t;
+
+   // The transposed coordinates are read out in the same interleaved order as a Morton key.
+   return mortonKey( X[0], X[1], X[2] );
+}
+
+template< typename FP_TYPE_T >
+Bounds<FP_TYPE_T> computeBounds( SoASpan3<const FP_TYPE_T> pos ) {
+
+   Bounds<FP_TYPE_T> bounds = { { FP_TYPE_T( 0 ), FP_TYPE_T( 0 ), FP_TYPE_T( 0 ) }, FP_TYPE_T( 0 ) };
+   if( pos.size == 0 )
+      return bounds;
+
+   const FP_TYPE_T * x = pos.x;
+   const FP_TYPE_T * y = pos.y;
+   const FP_TYPE_T * z = pos.z;
+   const large_t size = pos.size;
+
+   FP_TYPE_T lo_x = x[0], lo_y = y[0], lo_z = z[0];
+   FP_TYPE_T hi_x = x[0], hi_y = y[0], hi_z = z[0];
+
+   SN_OPENMP_FORK()
+   SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC OMP_REDUCTION( min : lo_x, lo_y, lo_z ) OMP_REDUCTION( max : hi_x, hi_y, hi_z ) )
+   for( large_t i = 0; i < size; ++i ) {
+
+      lo_x = std::min( lo_x, x[i] );   hi_x = std::max( hi_x, x[i] );
+      lo_y = std::min( lo_y, y[i] );   hi_y = std::max( hi_y, y[i] );
+      lo_z = std::min( lo_z, z[i] );   hi_z = std::max( hi_z, z[i] );
+   }
+   SN_OPENMP_SYNC()
+
+   bounds.lo[0] = lo_x;
+   bounds.lo[1] = lo_y;
+   bounds.lo[2] = lo_z;
+   bounds.extent = std::max( hi_x - lo_x, std::max( hi_y - lo_y, hi_z - lo_z ) );
+
+   return bounds;
+}
+
+template< typename FP_TYPE_T >
+void computeKeys( SoASpan3<const FP_TYPE_T> pos, const Bounds<FP_TYPE_T> & bounds, Curve curve, ID_t * keys ) {
+
+   SN_ASSERT( pos.size == 0 || keys != nullptr );
+
+   const FP_TYPE_T * x = pos.x;
+   const FP_TYPE_T * y = pos.y;
+   const FP_TYPE_T * z = pos.z;
+   const large_t size = pos.size;
+
+   const FP_TYPE_T lo_x = bounds.lo[0];
+   const FP_TYPE_T lo_y = bounds.lo[1];
+   const FP_TYPE_T lo_z = bounds.lo[2];
+   const FP_TYPE_T top = FP_TYPE_T( KEY_MAX_COORD );
+   const FP_TYPE_T scale = ( bounds.extent > FP_TYPE_T( 0 ) ) ? FP_TYPE_T( KEY_MAX_COORD + 1 ) / bounds.extent : FP_TYPE_T( 0 );
+
+   if( curve == Curve::Morton ) {
+
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC )
+      for( large_t i = 0; i < size; ++i ) {
+
+         const small_t ix = small_t( std::min( ( x[i] - lo_x ) * scale, top ) );
+         const small_t iy = small_t( std::min( ( y[i] - lo_y ) * scale, top ) );
+         const small_t iz = small_t( std::min( ( z[i] - lo_z ) * scale, top ) );
+         keys[i] = mortonKey( ix, iy, iz );
+      }
+      SN_OPENMP_SYNC()
+   }
+   else {
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t i = 0; i < size; ++i ) {
+
+         const small_t ix = small_t( std::min( ( x[i] - lo_x ) * scale, top ) );
+         const small_t iy = small_t( std::min( ( y[i] - lo_y ) * scale, top ) );
+         const small_t iz = small_t( std::min( ( z[i] - lo_z ) * scale, top ) );
+         keys[i] = hilbertKey( ix, iy, iz );
+      }
+      SN_OPENMP_SYNC()
+   }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Sorting
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace {
+
+constexpr small_t RADIX_BITS  = 8;
+constexpr large_t RADIX       = large_t( 1 ) << RADIX_BITS;
+constexpr large_t MIN_BLOCK   = 16384;   // Keys per block below which further parallelism does not pay off.
+constexpr large_t MAX_BLOCKS  = 256;
+
+}
+#endif   // DOXYSKIP
+
+void sortByKey( ID_t * keys, large_t * values, large_t n, small_t key_bits ) {
+
+   if( n < 2 )
+      return;
+
+   SN_ASSERT( keys != nullptr && values != nullptr );
+
+   #ifdef NDEBUG
+   if( keys == nullptr || values == nullptr )
+      SN_THROW_INVALID_ARGUMENT( "IA_SortByKey_Array_Error" );
+   #endif
+
+   const large_t blocks = std::min( ( n + MIN_BLOCK - 1 ) / MIN_BLOCK, MAX_BLOCKS );
+   const large_t block_size = ( n + blocks - 1 ) / blocks;
+
+   // All scratch is allocated before the first parallel region, and its allocation fails with an AllocError.
+   RAIIWrapper< ID_t >    key_scratch   = createRAIIWrapper< ID_t >( n );
+   RAIIWrapper< large_t > value_scratch = createRAIIWrapper< large_t >( n );
+   RAIIWrapper< large_t > histogram     = createRAIIWrapper< large_t >( blocks * RADIX );
+
+   ID_t * src_keys = keys;
+   ID_t * dst_keys = key_scratch.raw_ptr();
+   large_t * src_values = values;
+   large_t * dst_values = value_scratch.raw_ptr();
+
+   for( small_t shift = 0; shift < key_bits; shift += RADIX_BITS ) {
+
+      large_t * hist = histogram.raw_ptr();
+      std::fill( hist, hist + blocks * RADIX, large_t( 0 ) );
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t b = 0; b < blocks; ++b ) {
+
+         large_t * local = hist + b * RADIX;
+         const large_t end = std::min( ( b + 1 ) * block_size, n );
+         for( large_t i = b * block_size; i < end; ++i )
+            ++local[ ( src_keys[i] >> shift ) & ( RADIX - 1 ) ];
+      }
+      SN_OPENMP_SYNC()
+
+      // Exclusive prefix sum, digit-major and block-minor, so that equal digits keep their order across blocks.
+      large_t offset = 0;
+      flag_t trivial = false;
+      for( large_t d = 0; d < RADIX; ++d ) {
+
+         large_t total = 0;
+         for( large_t b = 0; b < blocks; ++b ) {
+
+            const large_t count = hist[ b * RADIX + d ];
+            hist[ b * RADIX + d ] = offset + total;
+            total += count;
+         }
+         if( total == n )
+            trivial = true;
+         offset += total;
+      }
+      if( trivial )
+         continue;
+
+      SN_OPENMP_FORK()
+      OMP_FOR_LOOP( OMP_STATIC )
+      for( large_t b = 0; b < blocks; ++b ) {
+
+         large_t * local = hist + b * RADIX;
+         const large_t end = std::min( ( b + 1 ) * block_size, n );
+         for( large_t i = b * block_size; i < end; ++i ) {
+
+            const large_t dst = local[ ( src_keys[i] >> shift ) & ( RADIX - 1 ) ]++;
+            dst_keys[dst] = src_keys[i];
+            dst_values[dst] = src_values[i];
+         }
+      }
+      SN_OPENMP_SYNC()
+
+      std::swap( src_keys, dst_keys );
+      std::swap( src_values, dst_values );
+   }
+
+   if( src_keys != keys ) {
+
+      SN_OPENMP_FORK()
+      SN_OPENMP_FOR_SIMD_LOOP( OMP_STATIC )
+      for( large_t i = 0; i < n; ++i ) {
+
+         keys[i] = src_keys[i];
+         values[i] = src_values[i];
+      }
+      SN_OPENMP_SYNC()
+   }
+}
+
+
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template Bounds< real_t >   computeBounds< real_t >( SoASpan3< const real_t > );
+template Bounds< single_t > computeBounds< single_t >( SoASpan3< const single_t > );
+template void computeKeys< real_t >( SoASpan3< const real_t >, const Bounds< real_t > &, Curve, ID_t * );
+template void computeKeys< single_t >( SoASpan3< const single_t >, const Bounds< single_t > &, Curve, ID_t * );
+#endif   // DOXYSKIP
+
+}   // namespace sfc
+
+}   // namespace simpleNewton
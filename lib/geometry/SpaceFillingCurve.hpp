@@ -0,0 +1,173 @@
+#ifndef SN_SPACEFILLINGCURVE_HPP
+#define SN_SPACEFILLINGCURVE_HPP
+
+#include <algorithm>
+#include <limits>
+
+#include <Types.hpp>
+
+#include <asserts/Asserts.hpp>
+#include <asserts/TypeConstraints.hpp>
+
+#include <containers/SoAField3.hpp>
+
+#include <concurrency/OpenMP.hpp>
+
+//==========================================================================================================================================
+//
+//  This file is part of simpleNewton. simpleNewton is free software: you can 
+//  redistribute it and/or modify it under the terms of the GNU General Public
+//  License as published by the Free Software Foundation, either version 3 of 
+//  the License, or (at your option) any later version.
+//  
+//  simpleNewton is distributed in the hope that it will be useful, but WITHOUT 
+//  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+//  FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License 
+//  for more details.
+//  
+//  You should have received a copy of the GNU General Public License along
+//  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
+//
+///   Contains the space-filling curve utilities: Morton and Hilbert keys of positions, and a parallel radix sort of keys.
+///   \file
+///   \addtogroup geometry Geometry
+///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
+//
+//==========================================================================================================================================
+
+/** The space in which all global entities of the framework are accessible */
+namespace simpleNewton {
+
+/** The space in which the space-filling curve utilities are accessible. */
+namespace sfc {
+
+/** The number of bits per dimension of a key. Three times this number of bits, i.e., the full key, fits into an ID_t. */
+constexpr small_t KEY_BITS = 21;
+
+/** The largest quantized coordinate. */
+constexpr small_t KEY_MAX_COORD = ( 1u << KEY_BITS ) - 1;
+
+/** An enum which is used to select the space-filling curve: the Morton (Z-order) curve, which is cheaper to evaluate and maps directly
+*   to the cells of an octree, or the Hilbert curve, whose consecutive keys are always face neighbours and which therefore yields a better
+*   locality.
+*/
+enum class Curve { Morton, Hilbert };
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Keys
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** A function which inserts two zero bits in front of each of the lower KEY_BITS bits of a coordinate.
+*
+*   \param v   The quantized coordinate.
+*   \return    The spread coordinate.
+*/
+inline ID_t spreadBits( ID_t v ) {
+
+   v &= 0x1fffff;
+   v = ( v | v << 32 ) & 0x1f00000000ffffUL;
+   v = ( v | v << 16 ) & 0x1f0000ff0000ffUL;
+   v = ( v | v << 8 )  & 0x100f00f00f00f00fUL;
+   v = ( v | v << 4 )  & 0x10c30c30c30c30c3UL;
+   v = ( v | v << 2 )  & 0x1249249249249249UL;
+   return v;
+}
+
+/** A function which computes the Morton key of a cell by interleaving the bits of its quantized coordinates, x being the most significant.
+*   The leading three bits of the key identify the octant of the cell at the first level of refinement, the following three the octant at the
+*   second level and so forth.
+*
+*   \param ix   The quantized x-coordinate.
+*   \param iy   The quantized y-coordinate.
+*   \param iz   The quantized z-coordinate.
+*   \return     The Morton key.
+*/
+inline ID_t mortonKey( small_t ix, small_t iy, small_t iz ) {
+   return ( spreadBits( ix ) << 2 ) | ( spreadBits( iy ) << 1 ) | spreadBits( iz );
+}
+
+/** A function which computes the Hilbert key of a cell by transposing its quantized coordinates according to Skilling's algorithm and
+*   interleaving the result.
+*
+*   \param ix   The quantized x-coordinate.
+*   \param iy   The quantized y-coordinate.
+*   \param iz   The quantized z-coordinate.
+*   \return     The Hilbert key.
+*/
+ID_t hilbertKey( small_t ix, small_t iy, small_t iz );
+
+/** A function which extracts the octant (0 to 7) of a key at a level of refinement.
+*
+*   \param key     The Morton key.
+*   \param level   The level of refinement, 1 being the first refinement of the root.
+*   \return        The octant.
+*/
+inline small_t octant( ID_t key, small_t level ) {
+
+   SN_ASSERT( level >= 1 && level <= KEY_BITS );
+
+   return small_t( ( key >> ( 3 * ( KEY_BITS - level ) ) ) & 7 );
+}
+
+
+
+//===CLASS==================================================================================================================================
+
+/** This struct describes the axis-aligned cube into which positions are quantized.
+*
+*   \tparam FP_TYPE_T   The floating point type of the positions.
+*/
+//==========================================================================================================================================
+
+template< typename FP_TYPE_T >
+struct Bounds {
+
+   FP_TYPE_T lo[3];     ///< The lower corner of the cube.
+   FP_TYPE_T extent;    ///< The edge length of the cube.
+};
+
+/** A function which computes the smallest cube containing a set of positions in a parallel reduction.
+*
+*   \param pos   A view of the positions.
+*   \return      The bounding cube. For an empty set, the cube is the origin with no extent.
+*/
+template< typename FP_TYPE_T >
+Bounds<FP_TYPE_T> computeBounds( SoASpan3<const FP_TYPE_T> pos );
+
+/** A function which quantizes positions on a grid of 2^KEY_BITS cells per dimension spanning a cube and computes their keys in a
+*   parallel, vectorizable loop.
+*
+*   \param pos      A view of the positions.
+*   \param bounds   The cube which is to be quantized.
+*   \param curve    The space-filling curve.
+*   \param keys     The array of pos.size keys which is to be written.
+*/
+template< typename FP_TYPE_T >
+void computeKeys( SoASpan3<const FP_TYPE_T> pos, const Bounds<FP_TYPE_T> & bounds, Curve curve, ID_t * keys );
+
+
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Sorting
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** A function which sorts keys along with a payload by a parallel least significant digit radix sort. The keys are processed eight bits at
+*   a time: every pass counts the digits of contiguous blocks of keys in parallel, computes the destination of each block from the global
+*   prefix sums, and scatters the blocks in parallel. The sort is stable and its result does not depend on the number of threads. Passes in
+*   which all keys share the same digit are skipped. Notes on exception safety: basic safety guaranteed. The function throws an 
+*   InvalidArgument exception if keys or values is nullptr and an AllocError exception if the scratch arrays could not be allocated.
+*
+*   \param keys       The array of keys.
+*   \param values     The array of payloads, e.g., the indices of the keys before sorting.
+*   \param n          The number of keys.
+*   \param key_bits   The number of significant (low) bits of the keys.
+*/
+void sortByKey( ID_t * keys, large_t * values, large_t n, small_t key_bits = 3 * KEY_BITS );
+
+}   // namespace sfc
+
+}   // namespace simpleNewton
+
+#endif
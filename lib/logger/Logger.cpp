@@ -312,6 +312,45 @@ void report_L1_event( LogEventType event, const std::string & file, int line, co
       case LogEventType::MPIWaitAll: event_tag = "MPI COMMUNICATION (WAITALL)"; 
                                      descr = "A set of immediate MPI operations has been completed."; break;
          
+      case LogEventType::MPISendInit: event_tag = "MPI COMMUNICATION (SEND INIT)"; 
+                                      descr = "Package, source, target (in that order): "; break;
+         
+      case LogEventType::MPIRecvInit: event_tag = "MPI COMMUNICATION (RECV INIT)"; 
+                                      descr = "Package, source, target (in that order): "; break;
+         
+      case LogEventType::MPIStartAll: event_tag = "MPI COMMUNICATION (STARTALL)"; 
+                                      descr = "Number of persistent MPI operations started: "; break;
+         
+      case LogEventType::MPIReduce: event_tag = "MPI COMMUNICATION (REDUCE)"; descr = "Package, root (in that order): "; break;
+         
+      case LogEventType::MPIIreduce: event_tag = "MPI COMMUNICATION (IREDUCE)"; descr = "Package, root (in that order): "; break;
+         
+      case LogEventType::MPIAllreduce: event_tag = "MPI COMMUNICATION (ALLREDUCE)"; descr = "Package: "; break;
+         
+      case LogEventType::MPIIallreduce: event_tag = "MPI COMMUNICATION (IALLREDUCE)"; descr = "Package: "; break;
+         
+      case LogEventType::MPIGather: event_tag = "MPI COMMUNICATION (GATHER)"; descr = "Package, root (in that order): "; break;
+         
+      case LogEventType::MPIIgather: event_tag = "MPI COMMUNICATION (IGATHER)"; descr = "Package, root (in that order): "; break;
+         
+      case LogEventType::MPIAllgather: event_tag = "MPI COMMUNICATION (ALLGATHER)"; descr = "Package: "; break;
+         
+      case LogEventType::MPIIallgather: event_tag = "MPI COMMUNICATION (IALLGATHER)"; descr = "Package: "; break;
+         
+      case LogEventType::MPIScatter: event_tag = "MPI COMMUNICATION (SCATTER)"; descr = "Package, root (in that order): "; break;
+         
+      case LogEventType::MPIIscatter: event_tag = "MPI COMMUNICATION (ISCATTER)"; descr = "Package, root (in that order): "; break;
+         
+      case LogEventType::MPIAlltoall: event_tag = "MPI COMMUNICATION (ALLTOALL)"; descr = "Package: "; break;
+         
+      case LogEventType::MPIIalltoall: event_tag = "MPI COMMUNICATION (IALLTOALL)"; descr = "Package: "; break;
+         
+      case LogEventType::MPINeighbourAlltoall: event_tag = "MPI COMMUNICATION (NEIGHBOUR ALLTOALL)"; 
+                                               descr = "Package, number of neighbours (in that order): "; break;
+         
+      case LogEventType::MPIIneighbourAlltoall: event_tag = "MPI COMMUNICATION (INEIGHBOUR ALLTOALL)"; 
+                                                descr = "Package, number of neighbours (in that order): "; break;
+         
       case LogEventType::Other: event_tag = "SPECIAL EVENT"; descr = "A special event has occurred.";
          
       default: event_tag = "UNKNOWN EVENT"; descr = "An unspecified event has ocurred"; break;
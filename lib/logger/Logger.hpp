@@ -40,7 +40,9 @@ namespace simpleNewton {
 
 /** An enumerator which helps specify the event type for level 1 (basic) event watching. */
 enum class LogEventType  { ResAlloc = 0, ResDealloc, OMPFork, OMPJoin, ThreadFork, ThreadJoin, MPISend, MPISsend, MPIIsend, MPIRecv, 
-                           MPIIrecv, MPIBcast, MPIIbcast, MPIWait, MPIWaitAll, Other };
+                           MPIIrecv, MPIBcast, MPIIbcast, MPIWait, MPIWaitAll, MPISendInit, MPIRecvInit, MPIStartAll, 
+                           MPIReduce, MPIIreduce, MPIAllreduce, MPIIallreduce, MPIGather, MPIIgather, MPIAllgather, MPIIallgather,
+                           MPIScatter, MPIIscatter, MPIAlltoall, MPIIalltoall, MPINeighbourAlltoall, MPIIneighbourAlltoall, Other };
 
 //===CLASS==================================================================================================================================
 
@@ -342,7 +344,9 @@ do { \
       *   \param INFO   A brief, textual description of the event. This message needs to be aware of certain templates. ResAlloc and 
       *                 ResDealloc have the template, "Pointer, Type, Size (in that order): ". All MPI send and receive events follow 
       *                 the template, "Package, source, target (in that order): " and the MPI broadcast event follows, "Package, source (in 
-      *                 that order): ". This argument can be streamed.
+      *                 that order): ". The MPI collective events follow "Package, root (in that order): " or, if every process 
+      *                 receives the result, "Package: ". The MPI neighbourhood collective events follow "Package, number of neighbours 
+      *                 (in that order): ". This argument can be streamed.
       */
       #define SN_LOG_REPORT_L1_EVENT( EV, INFO ) \
       do { \
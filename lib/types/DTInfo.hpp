@@ -21,7 +21,7 @@
 //  with simpleNewton (see LICENSE.txt). If not, see <http://www.gnu.org/licenses/>.
 //
 ///   Contains the struct template DTInfo, which gets rid of some boilerplate coding and serves as an implementation-independent typeid 
-///   operator of sorts for basic data types only.
+///   operator of sorts for basic data types, as well as the means to describe other types to MPI by derived datatypes.
 ///   \file
 ///   \addtogroup types Types
 ///   \author Nitin Malapally (anxiousprogrammer) <nitin.malapally@gmail.com>
@@ -210,6 +210,121 @@ template<> struct DTInfo< double > {
 
 #endif   // DOXYSKIP
 
+
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+
+/* The primary template names its type "N/A". */
+constexpr bool isDescribed( const char * name ) {
+   return ! ( name[0] == 'N' && name[1] == '/' && name[2] == 'A' && name[3] == '\0' );
+}
+
+}   // namespace internal
+#endif   // DOXYSKIP
+
+/** A type trait which is true if DTInfo describes the type, i.e., if the type is basic or has been given a specialization of DTInfo 
+*   with a derived MPI datatype.
+*
+*   \tparam TYPE   The type in question.
+*/
+template< typename TYPE > struct is_described {
+   static constexpr bool value = internal::isDescribed( DTInfo< TYPE >::name );   ///< Whether DTInfo describes the type.
+};
+
+
+
+#ifdef __SN_USE_MPI__
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//   Derived MPI datatypes
+///////////////////////////
+
+/** Types other than the basic ones are described to MPI by derived datatypes, which are committed at run-time. A DTInfo specialization 
+*   for such a type provides the static function getMPIType instead of the constant mpi_type, which commits the datatype upon its first 
+*   call and returns it thereafter (see the specializations for Vector3 and Matrix3). A user struct is described in the same way by 
+*   means of commitStructType:
+*
+*   \code
+*   template<> struct DTInfo< Particle > {
+*      static MPI_Datatype getMPIType() {
+*         static const int lengths[2] = { 3, 1 };
+*         static const MPI_Aint displs[2] = { offsetof( Particle, x ), offsetof( Particle, m ) };
+*         static const MPI_Datatype types[2] = { MPI_DOUBLE, MPI_DOUBLE };
+*         static const MPI_Datatype type = commitStructType( 2, lengths, displs, types, sizeof( Particle ) );
+*         return type;
+*      }
+*      static constexpr char mpi_name[] = "PARTICLE";
+*      static constexpr char name[] = "Particle";
+*   };
+*   \endcode
+*
+*   Derived datatypes may only be committed after MPI has been initialized. They are released by MPI_Finalize.
+*/
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+
+template< typename TYPE >
+inline auto getMPIType( int ) -> decltype( DTInfo< TYPE >::getMPIType() ) { return DTInfo< TYPE >::getMPIType(); }
+
+template< typename TYPE >
+inline MPI_Datatype getMPIType( long ) { return DTInfo< TYPE >::mpi_type; }
+
+}   // namespace internal
+#endif   // DOXYSKIP
+
+/** A function to obtain the MPI_Datatype of a type, be it the constant datatype of a basic type or the committed derived datatype of 
+*   any other type described by DTInfo.
+*
+*   \tparam TYPE   The type whose MPI_Datatype is required.
+*   \return        The MPI_Datatype.
+*/
+template< typename TYPE >
+inline MPI_Datatype getMPIType() { return internal::getMPIType< TYPE >( 0 ); }
+
+/** A function which commits a derived datatype made up of a number of consecutive elements of another datatype, e.g., the components 
+*   of a small vector.
+*
+*   \param count   The number of elements.
+*   \param base    The datatype of the elements.
+*   \return        The committed datatype, or MPI_DATATYPE_NULL if it could not be created.
+*/
+inline MPI_Datatype commitContiguousType( int count, MPI_Datatype base ) {
+   
+   MPI_Datatype type = MPI_DATATYPE_NULL;
+   if( MPI_Type_contiguous( count, base, &type ) != MPI_SUCCESS || MPI_Type_commit( &type ) != MPI_SUCCESS )
+      return MPI_DATATYPE_NULL;
+   return type;
+}
+
+/** A function which commits a derived datatype for a struct. The extent of the datatype is set to the size of the struct, so that 
+*   arrays of the struct, including its padding, can be communicated.
+*
+*   \param count     The number of blocks of members.
+*   \param lengths   The number of elements in every block.
+*   \param displs    The byte displacements of the blocks in the struct (see offsetof).
+*   \param types     The datatypes of the elements of every block.
+*   \param extent    The size of the struct.
+*   \return          The committed datatype, or MPI_DATATYPE_NULL if it could not be created.
+*/
+inline MPI_Datatype commitStructType( int count, const int * lengths, const MPI_Aint * displs, const MPI_Datatype * types, 
+                                      MPI_Aint extent ) {
+   
+   MPI_Datatype packed = MPI_DATATYPE_NULL, type = MPI_DATATYPE_NULL;
+   if( MPI_Type_create_struct( count, lengths, displs, types, &packed ) != MPI_SUCCESS )
+      return MPI_DATATYPE_NULL;
+   
+   const int info = MPI_Type_create_resized( packed, 0, extent, &type );
+   MPI_Type_free( &packed );
+   
+   if( info != MPI_SUCCESS || MPI_Type_commit( &type ) != MPI_SUCCESS )
+      return MPI_DATATYPE_NULL;
+   return type;
+}
+
+#endif   // MPI Guard
+
 }   // namespace simpleNewton
 
 #endif
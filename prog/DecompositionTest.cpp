@@ -0,0 +1,398 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <core/ProcSingleton.hpp>
+#include <logger/Logger.hpp>
+
+#include <containers/Vector3.hpp>
+#include <containers/mpi/FastBuffer.hpp>
+#include <concurrency/BaseComm.hpp>
+
+#include <core/Simulator.hpp>
+#include <core/HaloExchange.hpp>
+#include <core/ObjectMigration.hpp>
+#include <core/kinematics/AllWKBBs.hpp>
+#include <core/forces/VerletList.hpp>
+
+using namespace simpleNewton;
+
+using Kinematics = LeapfrogWKBB< real_t >;
+using Sim = Simulator< real_t, Kinematics >;
+
+/* The extent of the domain along each dimension, and the interaction cutoff. */
+const real_t L = 4.0;
+const real_t CUTOFF = 0.45;
+
+/* The mass which is given to an object at a position, so that the mass betrays whether it has travelled along with its object. */
+real_t massAt( const Vector3< real_t > & pos ) {
+   return pos[0] + real_cast( 10 ) * pos[1] + real_cast( 100 ) * pos[2];
+}
+
+/* Every process scatters objects over the whole domain and migrates them until every object has reached its owner. The masses are kept
+*  outside of the kinematics and are transferred as user data. */
+void MigrationTest() {
+
+   SN_LOG_MESSAGE( "Migration test begun!" );
+
+   const small_t perProc = 200;
+
+   Kinematics kin;
+   std::vector< real_t > masses;
+
+   const HandleRange range = kin.createObjects( perProc, []( Object_ID_t h, Vector3< real_t > & p, Vector3< real_t > & ) {
+      const small_t k = small_cast( h ) * 7 + small_cast( SN_MPI_RANK() ) * 13;
+      p[0] = real_cast( k % 40 ) / real_cast( 10 );
+      p[1] = real_cast( ( k / 40 ) % 40 ) / real_cast( 10 );
+      p[2] = real_cast( ( k / 1600 ) % 40 ) / real_cast( 10 );
+   } );
+
+   masses.resize( kin.getIndexCount() );
+   for( Object_ID_t h = range.first; h < range.last; ++h )
+      masses[ Kinematics::getHandleIndex( h ) ] = massAt( kin.getPosition( h ) );
+
+   ObjectMigration< real_t > migration;
+   migration.setUserData( 1, [&]( Object_ID_t h, real_t * values ) { values[0] = masses[ Kinematics::getHandleIndex( h ) ]; },
+                             [&]( Object_ID_t h, const real_t * values ) {
+                                if( kin.getIndexCount() > masses.size() )
+                                   masses.resize( kin.getIndexCount() );
+                                masses[ Kinematics::getHandleIndex( h ) ] = values[0];
+                             } );
+
+   const auto & world = Sim::getWorld();
+
+   // An object crosses at most one block per migration.
+   for( small_t step = 0; step < 4; ++step )
+      migration.migrate( world, kin );
+
+   // Every object lies in the block of its owner and has kept its mass, and none has been lost.
+   auto check = [&]( const char * what ) {
+      int failed = 0;
+      for( large_t slot = 0; slot < kin.getSize(); ++slot ) {
+         const Object_ID_t h = kin.getHandle( slot );
+         const Vector3< real_t > p = kin.getPosition( h );
+         if( world.getOwnerRank( p[0], p[1], p[2] ) != SN_MPI_RANK() || masses[ Kinematics::getHandleIndex( h ) ] != massAt( p ) )
+            ++failed;
+      }
+
+      FastBuffer< int > count( 1, int( kin.getSize() ) ), total( 1 ), misplaced( 1, failed ), total_misplaced( 1 );
+      BaseComm< int >::allreduce( count, total, MPIReduceOp::Sum );
+      BaseComm< int >::allreduce( misplaced, total_misplaced, MPIReduceOp::Sum );
+
+      SN_MPI_ROOTPROC_REGION() {
+         const flag_t passed = ( total[0] == int( perProc ) * SN_MPI_SIZE() && total_misplaced[0] == 0 );
+         std::cout << what << ": " << ( passed ? "passed" : "FAILED" ) << std::endl;
+      }
+   };
+
+   check( "Migration with user data" );
+
+   // All objects lie in the lowest layer along z, which the rebalancing spreads over all processes.
+   Sim::balanceLoad( kin, LoadMeasure::ObjectCount, real_cast( 0 ), real_cast( 0 ), &migration );
+   check( "Rebalancing with user data" );
+}
+
+/* The position of an object of the halo test, which all processes can compute from its global number. */
+Vector3< real_t > haloPosition( large_t n ) {
+   return Vector3< real_t >( real_cast( n * 7919 % 4001 ) * L / real_cast( 4001 ), real_cast( n * 104729 % 4003 ) * L / real_cast( 4003 ),
+                             real_cast( n * 1299709 % 4007 ) * L / real_cast( 4007 ) );
+}
+
+/* The objects are distributed over the processes and their halos are exchanged. A Verlet list which is built from the owned objects and
+*  the ghosts must then find every pair within the cutoff, the pairs across block boundaries once on either process. */
+void HaloTest() {
+
+   SN_LOG_MESSAGE( "Halo test begun!" );
+
+   const small_t total = 600;
+
+   Kinematics kin;
+   for( small_t n = small_cast( SN_MPI_RANK() ); n < total; n += small_cast( SN_MPI_SIZE() ) )
+      kin.setPosition( haloPosition( n ), kin.createObject() );
+
+   const auto & world = Sim::getWorld();
+
+   ObjectMigration< real_t > migration;
+   for( small_t step = 0; step < 4; ++step )
+      migration.migrate( world, kin );
+
+   HaloExchange< real_t > halo( CUTOFF );
+   halo.begin( world, kin );
+   halo.finish( kin );
+
+   VerletList< real_t > list( world, CUTOFF, real_cast( 0 ) );
+   list.build( kin, kin.getHaloPositionSpan() );
+
+   // Every row belongs to an owned object, so that a pair within the block is counted twice and a pair across blocks once per process.
+   std::vector< small_t > rows( kin.getSize(), 0 );
+   list.forEachNeighbour( kin.getHaloPositionSpan(), [&]( large_t i, large_t, real_t, real_t, real_t, real_t ) { ++rows[i]; } );
+
+   small_t found = 0;
+   for( large_t i = 0; i < kin.getSize(); ++i )
+      found += rows[i];
+
+   FastBuffer< int > local( 1, int( found ) ), sum( 1 );
+   BaseComm< int >::allreduce( local, sum, MPIReduceOp::Sum );
+
+   SN_MPI_ROOTPROC_REGION() {
+
+      small_t expected = 0;
+      for( small_t a = 0; a < total; ++a )
+         for( small_t b = a + 1; b < total; ++b ) {
+            const Vector3< real_t > pa = haloPosition( a ), pb = haloPosition( b );
+            const real_t dx = pb[0] - pa[0], dy = pb[1] - pa[1], dz = pb[2] - pa[2];
+            if( dx * dx + dy * dy + dz * dz < CUTOFF * CUTOFF )
+               expected += 2;
+         }
+
+      std::cout << "Verlet list with ghosts: " << ( sum[0] == int( expected ) && expected > 0 ? "passed" : "FAILED" ) << std::endl;
+   }
+}
+
+/* Every process sends values which name the sending process and the direction to its neighbours, over the Cartesian topology and over
+*  the neighbourhood topology. A neighbour in the opposite direction must then have sent the value for that direction. The exchange of
+*  parts of differing sizes runs non-blocking, with the size of a part depending on its direction. */
+void NeighbourTest() {
+
+   if( SN_MPI_SIZE() == 1 )
+      return;
+
+   SN_LOG_MESSAGE( "Neighbour collective test begun!" );
+
+   const auto & world = Sim::getWorld();
+   const int rank = SN_MPI_RANK();
+   int failed = 0;
+
+   // The faces in the order -x, +x, -y, +y, -z, +z, so that the opposite of face j is j^1. A missing neighbour leaves its part untouched.
+   FastBuffer< int > faceOut( 6 ), faceIn( 6, -1 );
+   for( int j = 0; j < 6; ++j )
+      faceOut.raw_ptr()[j] = rank * 6 + j;
+
+   BaseComm< int >::neighbourAlltoall< MPINeighbourMode::Standard, MPITopology::Cartesian >( faceOut, faceIn, 1 );
+
+   for( int j = 0; j < 6; ++j ) {
+      const int off = ( j % 2 == 0 ) ? -1 : 1;
+      const int nb = world.getNeighbourRank( j / 2 == 0 ? off : 0, j / 2 == 1 ? off : 0, j / 2 == 2 ? off : 0 );
+      if( faceIn[ large_t( j ) ] != ( nb < 0 ? -1 : nb * 6 + ( j ^ 1 ) ) )
+         ++failed;
+   }
+
+   // The existing neighbours of the neighbourhood topology in direction order, where the opposite of direction n is 26-n.
+   std::vector< int > dirs, ranks;
+   for( int n = 0; n < 27; ++n ) {
+      const int nb = world.getNeighbourRank( n / 9 - 1, ( n / 3 ) % 3 - 1, n % 3 - 1 );
+      if( n != 13 && nb >= 0 ) {
+         dirs.push_back( n );
+         ranks.push_back( nb );
+      }
+   }
+
+   const small_t degree = small_cast( dirs.size() );
+   FastBuffer< int > out( degree ), in( 1 );
+   for( small_t k = 0; k < degree; ++k )
+      out.raw_ptr()[k] = rank * 27 + dirs[k];
+
+   BaseComm< int >::neighbourAlltoall( out, in, 1 );
+
+   for( small_t k = 0; k < degree; ++k ) {
+      if( in[k] != ranks[k] * 27 + 26 - dirs[k] )
+         ++failed;
+   }
+
+   // A part for direction n holds 1 + n%3 copies of its value.
+   FastBuffer< int > sendCounts( degree ), sendDispls( degree ), recvCounts( degree ), recvDispls( degree );
+   int sendExtent = 0, recvExtent = 0;
+   for( small_t k = 0; k < degree; ++k ) {
+      sendCounts.raw_ptr()[k] = 1 + dirs[k] % 3;
+      recvCounts.raw_ptr()[k] = 1 + ( 26 - dirs[k] ) % 3;
+      sendDispls.raw_ptr()[k] = sendExtent;
+      recvDispls.raw_ptr()[k] = recvExtent;
+      sendExtent += sendCounts[k];
+      recvExtent += recvCounts[k];
+   }
+
+   FastBuffer< int > parts( small_cast( sendExtent ) ), gathered( 1 );
+   for( small_t k = 0; k < degree; ++k )
+      std::fill( parts.raw_ptr() + sendDispls[k], parts.raw_ptr() + sendDispls[k] + sendCounts[k], rank * 27 + dirs[k] );
+
+   MPIRequest< int > request;
+   BaseComm< int >::neighbourAlltoallv< MPINeighbourMode::Immediate >( parts, sendCounts, sendDispls, gathered, recvCounts, recvDispls,
+                                                                        request );
+   BaseComm< int >::wait< MPIWaitOp::Collective >( request );
+
+   failed += ( gathered.getSize() == large_t( recvExtent ) ) ? 0 : 1;
+   for( small_t k = 0; k < degree && failed == 0; ++k ) {
+      for( int i = 0; i < recvCounts[k]; ++i ) {
+         if( gathered[ large_t( recvDispls[k] + i ) ] != ranks[k] * 27 + 26 - dirs[k] )
+            ++failed;
+      }
+   }
+
+   FastBuffer< int > local( 1, failed ), sum( 1 );
+   BaseComm< int >::allreduce( local, sum, MPIReduceOp::Sum );
+
+   SN_MPI_ROOTPROC_REGION() {
+      std::cout << "Neighbour collectives: " << ( sum[0] == 0 ? "passed" : "FAILED" ) << std::endl;
+   }
+}
+
+/* The force kernel of a harmonic trap about the centre of the domain, which depends on the positions of the targets only. */
+void trapForces( WorldKinematicsBB< real_t > & kin, const std::vector< large_t > & targets, SoASpan3< const real_t > ) {
+
+   const SoASpan3< const real_t > pos = kin.getPositionSpan();
+   SoASpan3< real_t > acc = kin.getAccelerationSpan();
+   for( large_t i : targets ) {
+      acc.x[i] = L / real_cast( 2 ) - pos.x[i];   acc.y[i] = L / real_cast( 2 ) - pos.y[i];   acc.z[i] = L / real_cast( 2 ) - pos.z[i];
+   }
+}
+
+/* Every process integrates all objects in the trap with velocity Verlet on its own, and the same objects distributed over the processes
+*  with Simulator::performTimeStep, in which they cross the block boundaries. Both must arrive at the same state at the same time. */
+void TimeStepTest() {
+
+   SN_LOG_MESSAGE( "Time step test begun!" );
+
+   const small_t total = 300;
+   const small_t steps = 20;
+   const real_t dt = real_cast( 0.05 );
+
+   VelocityVerletWKBB< real_t > reference;
+   reference.setTimeStep( dt );
+   reference.setForcing( []( real_t, SoASpan3< const real_t > pos, SoASpan3< const real_t >, SoASpan3< real_t > acc ) {
+      for( large_t i = 0; i < pos.size; ++i ) {
+         acc.x[i] = L / real_cast( 2 ) - pos.x[i];   acc.y[i] = L / real_cast( 2 ) - pos.y[i];   acc.z[i] = L / real_cast( 2 ) - pos.z[i];
+      }
+   } );
+
+   std::vector< Object_ID_t > reference_handles( total );
+   for( small_t n = 0; n < total; ++n ) {
+      reference_handles[n] = reference.createObject();
+      reference.setPosition( haloPosition( n ), reference_handles[n] );
+   }
+
+   VelocityVerletWKBB< real_t > kin;
+   kin.setTimeStep( dt );
+   std::vector< real_t > ids;
+   for( small_t n = small_cast( SN_MPI_RANK() ); n < total; n += small_cast( SN_MPI_SIZE() ) ) {
+      const Object_ID_t h = kin.createObject();
+      kin.setPosition( haloPosition( n ), h );
+      ids.resize( kin.getIndexCount() );
+      ids[ Kinematics::getHandleIndex( h ) ] = real_cast( n );
+   }
+
+   ObjectMigration< real_t > migration;
+   migration.setUserData( 1, [&]( Object_ID_t h, real_t * values ) { values[0] = ids[ Kinematics::getHandleIndex( h ) ]; },
+                             [&]( Object_ID_t h, const real_t * values ) {
+                                if( kin.getIndexCount() > ids.size() )
+                                   ids.resize( kin.getIndexCount() );
+                                ids[ Kinematics::getHandleIndex( h ) ] = values[0];
+                             } );
+
+   const auto & world = Sim::getWorld();
+   for( small_t step = 0; step < 4; ++step )
+      migration.migrate( world, kin );
+
+   // Velocity Verlet needs the accelerations of the initial positions.
+   std::vector< large_t > all( total );
+   for( small_t n = 0; n < total; ++n )
+      all[n] = n;
+   trapForces( reference, all, reference.getPositionSpan() );
+   all.resize( kin.getSize() );
+   trapForces( kin, all, kin.getPositionSpan() );
+
+   HaloExchange< real_t > halo( CUTOFF );
+   for( small_t s = 0; s < steps; ++s ) {
+      reference.integrate();
+      Sim::performTimeStep( kin, halo, migration, trapForces );
+   }
+
+   real_t deviation = std::fabs( kin.getCurrentTime() - reference.getCurrentTime() );
+   for( large_t slot = 0; slot < kin.getSize(); ++slot ) {
+      const Object_ID_t h = kin.getHandle( slot );
+      const Object_ID_t r = reference_handles[ small_cast( ids[ Kinematics::getHandleIndex( h ) ] ) ];
+      for( small_t d = 0; d < 3; ++d ) {
+         deviation = std::max( deviation, std::fabs( kin.getPosition( h )[d] - reference.getPosition( r )[d] ) );
+         deviation = std::max( deviation, std::fabs( kin.getVelocity( h )[d] - reference.getVelocity( r )[d] ) );
+      }
+   }
+
+   FastBuffer< int > count( 1, int( kin.getSize() ) ), sum( 1 );
+   FastBuffer< real_t > local( 1, deviation ), largest( 1 );
+   BaseComm< int >::allreduce( count, sum, MPIReduceOp::Sum );
+   BaseComm< real_t >::allreduce( local, largest, MPIReduceOp::Max );
+
+   SN_MPI_ROOTPROC_REGION() {
+      const flag_t passed = ( sum[0] == int( total ) && largest[0] < real_cast( 1e-12 ) );
+      std::cout << "Velocity Verlet through performTimeStep: " << ( passed ? "passed" : "FAILED" ) << std::endl;
+   }
+}
+
+/* A simulation advances the kinematics by the simulated time, in steps of the given time step. The objects carry their global numbers as
+*  user data through the migrations of the simulation, so that the count, the sum and the sum of squares of the numbers are preserved. */
+void SimulateTest() {
+
+   SN_LOG_MESSAGE( "Simulate test begun!" );
+
+   const small_t total = 300;
+
+   Kinematics kin;
+   std::vector< real_t > ids;
+   for( small_t n = small_cast( SN_MPI_RANK() ); n < total; n += small_cast( SN_MPI_SIZE() ) ) {
+      const Object_ID_t h = kin.createObject();
+      kin.setPosition( haloPosition( n ), h );
+      ids.resize( kin.getIndexCount() );
+      ids[ Kinematics::getHandleIndex( h ) ] = real_cast( n );
+   }
+
+   ObjectMigration< real_t > migration;
+   migration.setUserData( 1, [&]( Object_ID_t h, real_t * values ) { values[0] = ids[ Kinematics::getHandleIndex( h ) ]; },
+                             [&]( Object_ID_t h, const real_t * values ) {
+                                if( kin.getIndexCount() > ids.size() )
+                                   ids.resize( kin.getIndexCount() );
+                                ids[ Kinematics::getHandleIndex( h ) ] = values[0];
+                             } );
+
+   HaloExchange< real_t > halo( CUTOFF );
+   Sim::simulate( kin, halo, migration, trapForces, real_cast( 1 ), real_cast( 0.1 ) );
+
+   real_t id_sum = real_cast( 0 ), id_squares = real_cast( 0 );
+   for( large_t slot = 0; slot < kin.getSize(); ++slot ) {
+      const real_t id = ids[ Kinematics::getHandleIndex( kin.getHandle( slot ) ) ];
+      id_sum += id;
+      id_squares += id * id;
+   }
+
+   FastBuffer< int > count( 1, int( kin.getSize() ) ), total_count( 1 );
+   FastBuffer< real_t > local_sum( 1, id_sum ), global_sum( 1 ), local_squares( 1, id_squares ), global_squares( 1 );
+   BaseComm< int >::allreduce( count, total_count, MPIReduceOp::Sum );
+   BaseComm< real_t >::allreduce( local_sum, global_sum, MPIReduceOp::Sum );
+   BaseComm< real_t >::allreduce( local_squares, global_squares, MPIReduceOp::Sum );
+
+   SN_MPI_ROOTPROC_REGION() {
+      const real_t n = real_cast( total );
+      const flag_t passed = ( kin.getTimeStep() == real_cast( 0.1 ) && std::fabs( kin.getCurrentTime() - real_cast( 1 ) ) < 1e-12 &&
+                              total_count[0] == int( total ) && global_sum[0] == n * ( n - 1 ) / 2 &&
+                              global_squares[0] == ( n - 1 ) * n * ( 2 * n - 1 ) / 6 );
+      std::cout << "Simulation with user data: " << ( passed ? "passed" : "FAILED" ) << std::endl;
+   }
+}
+
+
+
+int main( int argc, char ** argv ) {
+
+   ProcSingleton::init( argc, argv );
+   SN_LOG_SWITCH_ON_CONSOLE_OUTPUT();
+
+   Sim::setupDomains( Vector3< real_t >( L ), CUTOFF );
+
+   // The halo test runs first, since the rebalancing of the migration test may leave blocks thinner than the cutoff.
+   HaloTest();
+   NeighbourTest();
+   TimeStepTest();
+   SimulateTest();
+   MigrationTest();
+
+   return 0;
+}
@@ -75,5 +75,26 @@ int main( int argc, char ** argv ) {
    }
    std::cout << std::endl;
    
+   Field< real_t, 10, HugePageAlloc > f2;
+   f2.reserve( 20 );
+   f2.pushBackN( 5, 1.0 );
+   f2.emplaceBack( 2.0 );
+   f2.pushBackN( 1000000, f2[5] );
+   
+   std::cout << f2.getSize() << " " << f2.getCapacity() << " " << f2[4] << " " << f2[f2.getSize() - 1] << std::endl;
+   
+   // Batches which are written in parallel must fill the new elements and leave the existing ones alone.
+   Field< real_t, 10 > f3;
+   for( small_t b = 0; b < 50; ++b )
+      f3.pushBackN( 1000 + b, real_cast( b ), 64 );
+   
+   flag_t chunked = ( f3.getSize() == 50 * 1000 + 49 * 25 );
+   large_t k = 0;
+   for( small_t b = 0; b < 50; ++b )
+      for( small_t i = 0; i < 1000 + b; ++i )
+         chunked = chunked && f3[k++] == real_cast( b );
+   
+   std::cout << "Chunked pushBackN: " << ( chunked ? "passed" : "FAILED" ) << std::endl;
+   
    return 0;
 }
@@ -0,0 +1,183 @@
+#include <cmath>
+#include <iostream>
+
+#include <core/ProcSingleton.hpp>
+#include <logger/Logger.hpp>
+
+#include <containers/Vector3.hpp>
+
+#include <core/kinematics/AllWKBBs.hpp>
+
+using namespace simpleNewton;
+
+/* Creates objects one by one and in a batch after a deletion, and checks that every handle still finds its own object. */
+void HandleTest() {
+
+   SN_LOG_MESSAGE( "Handle test begun!" );
+
+   LeapfrogWKBB< real_t > kin;
+
+   // Objects whose x-coordinate identifies them.
+   Object_ID_t handles[4];
+   for( small_t i=0; i<4; ++i ) {
+      handles[i] = kin.createObject();
+      kin.setPosition( Vector3< real_t >( real_cast( 100 + i ), 0.0, 0.0 ), handles[i] );
+   }
+
+   kin.deleteObject( handles[1] );
+
+   const HandleRange empty = kin.createObjects( 0, []( Object_ID_t, Vector3< real_t > &, Vector3< real_t > & ) {} );
+   const HandleRange range = kin.createObjects( 4, []( Object_ID_t h, Vector3< real_t > & p, Vector3< real_t > & ) {
+      p[0] = real_cast( 200 + LeapfrogWKBB< real_t >::getHandleIndex( h ) );
+   } );
+
+   flag_t passed = ( empty.getSize() == 0 && empty.first == range.first && range.getSize() == 4 && kin.getSize() == 7 );
+
+   passed = passed && ! kin.isValidHandle( handles[1] );
+   for( small_t i=0; i<4; ++i )
+      if( i != 1 )
+         passed = passed && kin.getPosition( handles[i] )[0] == real_cast( 100 + i );
+
+   for( Object_ID_t h = range.first; h < range.last; ++h )
+      passed = passed && kin.isValidHandle( h ) && kin.getPosition( h )[0] == real_cast( 200 + h );
+
+   // The slots stay densely packed and map back onto their handles.
+   for( large_t slot = 0; slot < kin.getSize(); ++slot )
+      passed = passed && kin.getSlot( kin.getHandle( slot ) ) == slot;
+
+   std::cout << "Delete, then createObjects: " << ( passed ? "passed" : "FAILED" ) << std::endl;
+
+   // Without an initializer, the indices of the deleted objects are reused before fresh ones are handed out.
+   const large_t size = kin.getSize();
+   kin.deleteObject( handles[0] );
+   kin.deleteObject( handles[2] );
+
+   Object_ID_t created[4];
+   kin.createObjects( 4, created );
+
+   passed = kin.getSize() == size + 2;
+   passed = passed && LeapfrogWKBB< real_t >::getHandleIndex( created[0] ) == LeapfrogWKBB< real_t >::getHandleIndex( handles[2] );
+   passed = passed && LeapfrogWKBB< real_t >::getHandleIndex( created[1] ) == LeapfrogWKBB< real_t >::getHandleIndex( handles[0] );
+   passed = passed && LeapfrogWKBB< real_t >::getHandleIndex( created[2] ) == LeapfrogWKBB< real_t >::getHandleIndex( handles[1] );
+   passed = passed && created[3] == range.last && kin.getPosition( handles[3] )[0] == real_cast( 103 );
+   for( small_t k=0; k<4; ++k )
+      passed = passed && kin.getSlot( created[k] ) == size - 2 + k && kin.getPosition( created[k] )[0] == real_t( 0 );
+
+   std::cout << "Delete, then createObjects with reuse: " << ( passed ? "passed" : "FAILED" ) << std::endl;
+}
+
+/* The harmonic oscillator a = -x, whose solution from x = 1 and v = 0 is x = cos t and v = -sin t. */
+void oscillatorForcing( real_t, SoASpan3< const real_t > pos, SoASpan3< const real_t >, SoASpan3< real_t > acc ) {
+   for( large_t i = 0; i < pos.size; ++i ) {
+      acc.x[i] = -pos.x[i];   acc.y[i] = -pos.y[i];   acc.z[i] = -pos.z[i];
+   }
+}
+
+/* The deviation of a position and a velocity from the exact solution of the harmonic oscillator at time t. */
+real_t oscillatorError( const Vector3< real_t > & x, const Vector3< real_t > & v, real_t t ) {
+   return std::max( std::fabs( x[0] - std::cos( t ) ), std::fabs( v[0] + std::sin( t ) ) );
+}
+
+/* Velocity Verlet computes the accelerations of the new positions with the forcing, starting from those of the initial positions. */
+real_t verletError( real_t dt, small_t steps ) {
+
+   VelocityVerletWKBB< real_t > kin;
+   kin.setTimeStep( dt );
+   kin.setForcing( oscillatorForcing );
+
+   const Object_ID_t h = kin.createObject();
+   kin.setPosition( Vector3< real_t >( 1.0, 0.0, 0.0 ), h );
+   kin.setAcceleration( Vector3< real_t >( -1.0, 0.0, 0.0 ), h );
+
+   for( small_t s = 0; s < steps; ++s )
+      kin.integrate();
+
+   return oscillatorError( kin.getPosition( h ), kin.getVelocity( h ), kin.getTimeStep() * real_cast( steps ) );
+}
+
+/* The leapfrog method leaves the computation of the accelerations to the caller. */
+real_t leapfrogError( real_t dt, small_t steps ) {
+
+   LeapfrogWKBB< real_t > kin;
+   kin.setTimeStep( dt );
+
+   const Object_ID_t h = kin.createObject();
+   kin.setPosition( Vector3< real_t >( 1.0, 0.0, 0.0 ), h );
+
+   for( small_t s = 0; s <= steps; ++s ) {
+      oscillatorForcing( real_cast( 0 ), kin.getPositionSpan(), kin.getVelocitySpan(), kin.getAccelerationSpan() );
+      if( s < steps )
+         kin.integrate();
+   }
+
+   return oscillatorError( kin.getPosition( h ), kin.getSynchronizedVelocity( h ), kin.getTimeStep() * real_cast( steps ) );
+}
+
+real_t rungeKuttaError( real_t dt, small_t steps ) {
+
+   RungeKutta4WKBB< real_t > kin;
+   kin.setTimeStep( dt );
+   kin.setForcing( oscillatorForcing );
+
+   const Object_ID_t h = kin.createObject();
+   kin.setPosition( Vector3< real_t >( 1.0, 0.0, 0.0 ), h );
+
+   for( small_t s = 0; s < steps; ++s )
+      kin.integrate();
+
+   return oscillatorError( kin.getPosition( h ), kin.getVelocity( h ), kin.getTimeStep() * real_cast( steps ) );
+}
+
+/* Integrates the harmonic oscillator with the second order integrators and the Runge-Kutta method, and compares the positions and the
+*  synchronized velocities with the exact solution. */
+void IntegratorTest() {
+
+   SN_LOG_MESSAGE( "Integrator test begun!" );
+
+   const flag_t passed = verletError( 0.01, 1000 ) < 1e-4 && leapfrogError( 0.01, 1000 ) < 1e-4 && rungeKuttaError( 0.01, 1000 ) < 1e-8;
+
+   std::cout << "Integrators on a harmonic oscillator: " << ( passed ? "passed" : "FAILED" ) << std::endl;
+}
+
+/* Integrates a few steps of an exactly representable time step, with or without an object, and returns the current time thereafter. */
+template< class KINEMATICS >
+real_t clockAfter( small_t steps, flag_t with_object ) {
+
+   KINEMATICS kin;
+   kin.setTimeStep( real_cast( 0.25 ) );
+
+   if( with_object )
+      kin.createObject();
+
+   for( small_t s = 0; s < steps; ++s )
+      kin.integrate();
+
+   return kin.getCurrentTime();
+}
+
+/* Every integrator advances the current time by the time step, also if there are no objects. */
+void ClockTest() {
+
+   flag_t passed = true;
+   for( flag_t with_object : { false, true } ) {
+      passed = passed && clockAfter< EulerExplicitWKBB< real_t > >( 10, with_object ) == real_cast( 2.5 );
+      passed = passed && clockAfter< LeapfrogWKBB< real_t > >( 10, with_object ) == real_cast( 2.5 );
+      passed = passed && clockAfter< VelocityVerletWKBB< real_t > >( 10, with_object ) == real_cast( 2.5 );
+      passed = passed && clockAfter< RungeKutta4WKBB< real_t > >( 10, with_object ) == real_cast( 2.5 );
+   }
+
+   std::cout << "Current time of all integrators: " << ( passed ? "passed" : "FAILED" ) << std::endl;
+}
+
+
+int main( int argc, char ** argv ) {
+
+   ProcSingleton::init( argc, argv );
+   SN_LOG_SWITCH_ON_CONSOLE_OUTPUT();
+
+   HandleTest();
+   IntegratorTest();
+   ClockTest();
+
+   return 0;
+}
@@ -1,11 +1,153 @@
 #include <iostream>
+#include <vector>
 
 #include <core/ProcSingleton.hpp>
 #include <concurrency/BaseComm.hpp>
+#include <concurrency/CommAggregator.hpp>
+#include <containers/Vector3.hpp>
 #include <logger/Logger.hpp>
 
 using namespace simpleNewton;
 
+/* Sums up the failures of all processes, and the root reports the outcome of a test. */
+void report( const char * test, int failed ) {
+   
+   FastBuffer< int > local( 1, failed ), total( 1 );
+   BaseComm< int >::allreduce( local, total, MPIReduceOp::Sum );
+   
+   SN_MPI_ROOTPROC_REGION() {
+      std::cout << test << ": " << ( total[0] == 0 ? "passed" : "FAILED" ) << std::endl;
+   }
+}
+
+/* Every process sends to the next one in a ring by persistent requests, which are started three times with new contents. The send is 
+*  bound to the first two elements of its buffer, and the receive enlarges its buffer to these two elements. */
+void PersistentTest() {
+   
+   // A ring needs at least two processes.
+   if( SN_MPI_SIZE() == 1 )
+      return;
+   
+   SN_LOG_MESSAGE( "Persistent request test begun!" );
+   
+   const int rank = SN_MPI_RANK();
+   const int next = ( rank + 1 ) % SN_MPI_SIZE();
+   const int prev = ( rank + SN_MPI_SIZE() - 1 ) % SN_MPI_SIZE();
+   
+   FastBuffer< int > out( 4, -1 ), in( 1 );
+   MPIRequest< int > send_request, recv_request;
+   BaseComm< int >::sendInit( out, next, send_request, 2 );
+   BaseComm< int >::receiveInit( in, 2, prev, recv_request );
+   
+   int failed = ( in.getSize() == 2 ) ? 0 : 1;
+   for( int round = 0; round < 3; ++round ) {
+      
+      out.raw_ptr()[0] = 100 * round + rank;
+      out.raw_ptr()[1] = -rank;
+      
+      BaseComm< int >::startAll( 1, recv_request );
+      BaseComm< int >::startAll( 1, send_request );
+      BaseComm< int >::wait< MPIWaitOp::Receive >( recv_request );
+      BaseComm< int >::wait< MPIWaitOp::Send >( send_request );
+      
+      if( in[0] != 100 * round + prev || in[1] != -prev )
+         ++failed;
+   }
+   
+   report( "Persistent requests", failed );
+}
+
+/* Process p contributes p+1 copies of p, so that the parts differ in size. The parts are gathered on every process by allgatherv and 
+*  scattered back from the root by scatterv, in the mode given by the template parameters. Returns the number of wrong entries. */
+template< MPIGatherMode GMODE, MPIScatterMode SCMODE >
+int gathervScatterv() {
+   
+   const int rank = SN_MPI_RANK();
+   const int size = SN_MPI_SIZE();
+   
+   FastBuffer< int > counts( static_cast< small_t >( size ) ), displs( static_cast< small_t >( size ) );
+   for( int p = 0; p < size; ++p ) {
+      counts.raw_ptr()[p] = p + 1;
+      displs.raw_ptr()[p] = p * ( p + 1 ) / 2;
+   }
+   
+   FastBuffer< int > own( static_cast< small_t >( rank + 1 ), rank ), all( 1 ), part( 1 );
+   MPIRequest< int > request;
+   
+   BaseComm< int >::allgatherv< GMODE >( own, all, counts, displs, request );
+   if( GMODE == MPIGatherMode::Immediate )
+      BaseComm< int >::wait< MPIWaitOp::Collective >( request );
+   
+   int failed = ( all.getSize() == static_cast< large_t >( size * ( size + 1 ) / 2 ) ) ? 0 : 1;
+   for( int p = 0; p < size && failed == 0; ++p ) {
+      for( int i = 0; i < p + 1; ++i ) {
+         if( all[ static_cast< large_t >( displs[ static_cast< large_t >( p ) ] + i ) ] != p )
+            ++failed;
+      }
+   }
+   
+   BaseComm< int >::scatterv< SCMODE >( all, part, counts, displs, SN_ROOTPROC, request );
+   if( SCMODE == MPIScatterMode::Immediate )
+      BaseComm< int >::wait< MPIWaitOp::Collective >( request );
+   
+   failed += ( part.getSize() == static_cast< large_t >( rank + 1 ) ) ? 0 : 1;
+   for( large_t i = 0; i < part.getSize(); ++i ) {
+      if( part[i] != rank )
+         ++failed;
+   }
+   
+   return failed;
+}
+
+/* Gathers and scatters parts of differing sizes, blocking and non-blocking. */
+void GathervScattervTest() {
+   
+   SN_LOG_MESSAGE( "Allgatherv and scatterv test begun!" );
+   
+   int failed = gathervScatterv< MPIGatherMode::Standard, MPIScatterMode::Standard >();
+   failed += gathervScatterv< MPIGatherMode::Immediate, MPIScatterMode::Immediate >();
+   
+   report( "Allgatherv and scatterv", failed );
+}
+
+/* With MPI_THREAD_MULTIPLE, all threads send to the same thread of the next process in a ring at the same time. The messages of all 
+*  threads carry the same tag, so that only the communicators of the threads keep them apart. */
+void ThreadCommTest() {
+   
+   #if defined( __SN_USE_MPI__ ) && defined( __SN_USE_OPENMP__ )
+   if( ! ProcSingleton::isThreadMultiple() || SN_MPI_SIZE() == 1 )
+      return;
+   
+   SN_LOG_MESSAGE( "Thread communicator test begun!" );
+   
+   const int rank = SN_MPI_RANK();
+   const int next = ( rank + 1 ) % SN_MPI_SIZE();
+   const int prev = ( rank + SN_MPI_SIZE() - 1 ) % SN_MPI_SIZE();
+   
+   std::vector< int > wrong( static_cast< size_t >( omp_get_max_threads() ), 0 );
+   
+   SN_OPENMP_FORK()
+      
+      const int thread = omp_get_thread_num();
+      FastBuffer< int > out( 1, 1000 * rank + thread ), in( 1, -1 );
+      MPIRequest< int > request;
+      
+      BaseComm< int >::send< MPISendMode::Immediate >( out, next, request );
+      BaseComm< int >::receive( in, 1, prev );
+      BaseComm< int >::wait< MPIWaitOp::Send >( request );
+      
+      wrong[ static_cast< size_t >( thread ) ] = ( in[0] == 1000 * prev + thread ) ? 0 : 1;
+   
+   SN_OPENMP_SYNC()
+   
+   int failed = 0;
+   for( const int w : wrong )
+      failed += w;
+   
+   report( "Thread communicators", failed );
+   #endif
+}
+
 int main( int argc, char ** argv ) {
    
    ProcSingleton::init( argc, argv );
@@ -44,5 +186,39 @@ int main( int argc, char ** argv ) {
    
    SN_LOG_WATCH_VARIABLES( "The value received from the autoBCast is: ", make_std_string( rec_j ) );
    
+   FastBuffer< int > rank( 1, SN_MPI_RANK() ), rank_sum( 1 ), ranks( 1 );
+   MPIRequest< int > r3;
+   
+   BaseComm< int >::allreduce( rank, rank_sum, MPIReduceOp::Sum );
+   BaseComm< int >::gather< MPIGatherMode::Immediate >( rank, ranks, SN_ROOTPROC, r3 );
+   BaseComm< int >::wait< MPIWaitOp::Collective >( r3 );
+   
+   SN_LOG_WATCH_VARIABLES( "The sum of the ranks from the allreduce is: ", rank_sum[0] );
+   
+   SN_MPI_ROOTPROC_REGION() {
+      SN_LOG_WATCH_VARIABLES( "The last rank from the gather is: ", ranks[ ranks.getSize() - 1 ] );
+   }
+   
+   DArray< Vector3<real_t> > grid( 9, Vector3<real_t>( static_cast< real_t >( SN_MPI_RANK() ) ) );
+   
+   SN_MPI_PROC_REGION( 1 ) {
+      BaseComm< Vector3<real_t> >::sendRegion( grid, SN_ROOTPROC, 0, 3, 3 );
+   }
+   SN_MPI_PROC_REGION( SN_ROOTPROC ) {
+      BaseComm< Vector3<real_t> >::receiveRegion( grid, 1, 6, 3 );
+      SN_LOG_WATCH_VARIABLES( "The last vector of the region received from process 1 is: ", grid[8] );
+   }
+   
+   CommAggregator< int > aggregator;
+   
+   for( int k = 0; k < 100; ++k )
+      aggregator.enqueue( ( SN_MPI_RANK() + 1 ) % SN_MPI_SIZE(), k );
+   
+   SN_LOG_WATCH_VARIABLES( "The number of records received from the aggregator is: ", aggregator.flush() );
+   
+   PersistentTest();
+   ThreadCommTest();
+   GathervScattervTest();
+   
    return 0;
 }